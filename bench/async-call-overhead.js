@@ -0,0 +1,105 @@
+/**
+ * Measures the per-call overhead of the AsyncSRT transports.
+ *
+ * Every call is awaited before the next one is made, so the figure is the
+ * full round trip of one call (JS -> SRT -> JS) and not the throughput.
+ *
+ * Usage: node bench/async-call-overhead.js [calls] [payloadSize] [--markdown]
+ *
+ * With `--markdown` the report is printed as a table (with the host it ran on)
+ * to paste along with a change, instead of JSON.
+ */
+
+const { performance } = require('perf_hooks');
+
+const { SRT, AsyncSRT, AsyncSRTTransport } = require('../index');
+const { describeHost } = require('./common');
+
+const HOST = '127.0.0.1';
+const PORT = 1290;
+
+const MARKDOWN = process.argv.includes('--markdown');
+const positional = process.argv.slice(2).filter((arg) => !arg.startsWith('--'));
+const CALLS = Number(positional[0]) || 20000;
+const PAYLOAD_SIZE = Number(positional[1]) || 1316;
+
+async function measure(name, calls, fn) {
+  // warm-up
+  for (let i = 0; i < Math.min(1000, calls); i++) {
+    await fn();
+  }
+  const start = performance.now();
+  for (let i = 0; i < calls; i++) {
+    await fn();
+  }
+  const elapsedMs = performance.now() - start;
+  return {
+    name,
+    calls,
+    totalMs: Number(elapsedMs.toFixed(3)),
+    usPerCall: Number((elapsedMs * 1000 / calls).toFixed(3))
+  };
+}
+
+async function runTransport(transport, port) {
+  const asyncSrt = new AsyncSRT({ transport });
+
+  const server = await asyncSrt.createSocket(false);
+  await asyncSrt.bind(server, HOST, port);
+  await asyncSrt.listen(server, 1);
+
+  const client = await asyncSrt.createSocket(true);
+  await asyncSrt.setSockOpt(client, SRT.SRTO_SNDSYN, false);
+  const connecting = asyncSrt.connect(client, HOST, port);
+  const conn = await asyncSrt.accept(server);
+  await connecting;
+
+  const payload = Buffer.alloc(PAYLOAD_SIZE);
+  const results = [
+    await measure('getSockState', CALLS, () => asyncSrt.getSockState(client)),
+    await measure('write', CALLS, () => {
+      // the worker transport detaches what it posts, so each call gets a copy there
+      const chunk = transport === AsyncSRTTransport.WORKER ? Buffer.from(payload) : payload;
+      return asyncSrt.write(client, chunk);
+    })
+  ];
+
+  await asyncSrt.close(conn);
+  await asyncSrt.close(client);
+  await asyncSrt.dispose();
+
+  return results.map((result) => Object.assign({ transport }, result));
+}
+
+function toMarkdown(report) {
+  const { host } = report;
+  const lines = [
+    `${host.cpuModel} (${host.cpuCount} cpus), ${host.platform}/${host.arch}, Node.js ${host.node},`
+      + ` ${report.calls} calls, ${report.payloadSize} byte payload`,
+    '',
+    '| transport | call | us/call |',
+    '| --- | --- | ---: |'
+  ];
+  report.results.forEach(({ transport, name, usPerCall }) => {
+    lines.push(`| ${transport} | ${name} | ${usPerCall} |`);
+  });
+  return lines.join('\n');
+}
+
+(async function main() {
+  const results = [];
+  const transports = [AsyncSRTTransport.WORKER, AsyncSRTTransport.SHARED_RING, AsyncSRTTransport.NATIVE];
+  for (let i = 0; i < transports.length; i++) {
+    results.push(...await runTransport(transports[i], PORT + i));
+  }
+  const report = {
+    host: describeHost(),
+    calls: CALLS,
+    payloadSize: PAYLOAD_SIZE,
+    results
+  };
+  console.log(MARKDOWN ? toMarkdown(report) : JSON.stringify(report, null, 2));
+})().catch((err) => {
+  console.error(err);
+  process.exit(1);
+});
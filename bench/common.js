@@ -0,0 +1,313 @@
+/**
+ * Shared helpers of the loopback benchmarks (see bench/run.js).
+ *
+ * Every message sent carries its send time (`process.hrtime`, in ns) in its
+ * first 8 bytes, so the receiver, running in the same process, can measure
+ * the one-way latency. With TSBPD on, that latency includes `SRTO_LATENCY`.
+ */
+
+const os = require('os');
+
+const { SRT } = require('../index');
+
+const HOST = '127.0.0.1';
+const STAMP_BYTES = 8;
+const READ_BATCH_MAX_MESSAGES = 256;
+
+const DEFAULT_OPTIONS = {
+  durationMs: 3000,
+  payloadSize: 1316,
+  latencyMs: 20,
+  clients: 4,
+  basePort: 1300
+};
+
+// how long to wait for the last messages once sending stopped (on top of the latency)
+const SETTLE_IDLE_MS = 250;
+
+function delay(ms) {
+  return new Promise((resolve) => setTimeout(resolve, ms));
+}
+
+function yieldToEventLoop() {
+  return new Promise(setImmediate);
+}
+
+/**
+ * @param {number} payloadSize
+ * @returns {Buffer} a message stamped with the current time
+ */
+function stampedMessage(payloadSize) {
+  const message = Buffer.alloc(payloadSize);
+  message.writeBigUInt64LE(process.hrtime.bigint(), 0);
+  return message;
+}
+
+/**
+ * Stamps every message of `buffer` (consecutive messages of `payloadSize` bytes).
+ *
+ * @param {Buffer} buffer
+ * @param {number} payloadSize
+ */
+function stampMessages(buffer, payloadSize) {
+  const now = process.hrtime.bigint();
+  for (let offset = 0; offset + STAMP_BYTES <= buffer.length; offset += payloadSize) {
+    buffer.writeBigUInt64LE(now, offset);
+  }
+}
+
+/**
+ * @param {number[]} sorted
+ * @param {number} p 0..1
+ */
+function percentile(sorted, p) {
+  if (sorted.length === 0) return null;
+  return sorted[Math.min(sorted.length - 1, Math.floor(p * sorted.length))];
+}
+
+/**
+ * Counts what one scenario sends and receives, and turns it into a result.
+ */
+class Recorder {
+  /**
+   * @param {string} name
+   * @param {object} extra merged into the result (e.g the number of clients)
+   */
+  constructor(name, extra = {}) {
+    this.name = name;
+    this.extra = extra;
+    this.messagesSent = 0;
+    this.messagesReceived = 0;
+    this.bytesReceived = 0;
+    this._latenciesNs = [];
+    this._startNs = null;
+    this._lastReceiveNs = null;
+    this._cpuStart = null;
+  }
+
+  start() {
+    this._cpuStart = process.cpuUsage();
+    this._startNs = process.hrtime.bigint();
+  }
+
+  countSent(messages) {
+    this.messagesSent += messages;
+  }
+
+  /**
+   * @param {Uint8Array} message
+   */
+  onMessage(message) {
+    const now = process.hrtime.bigint();
+    this._record(now, Buffer.from(message.buffer, message.byteOffset, message.byteLength), 0, message.byteLength);
+  }
+
+  /**
+   * @param {Uint8Array} buffer consecutive messages of `payloadSize` bytes
+   * @param {number} payloadSize
+   */
+  onMessages(buffer, payloadSize) {
+    const now = process.hrtime.bigint();
+    const view = Buffer.from(buffer.buffer, buffer.byteOffset, buffer.byteLength);
+    for (let offset = 0; offset < view.length; offset += payloadSize) {
+      this._record(now, view, offset, Math.min(payloadSize, view.length - offset));
+    }
+  }
+
+  /**
+   * @param {{buffer: Uint8Array, offsets: Uint32Array | number[]}} batch result of `readBatch`
+   */
+  onBatch(batch) {
+    const now = process.hrtime.bigint();
+    const { buffer, offsets } = batch;
+    const view = Buffer.from(buffer.buffer, buffer.byteOffset, buffer.byteLength);
+    for (let i = 0; i < offsets.length - 1; i++) {
+      this._record(now, view, offsets[i], offsets[i + 1] - offsets[i]);
+    }
+  }
+
+  _record(now, view, offset, length) {
+    this.messagesReceived++;
+    this.bytesReceived += length;
+    this._lastReceiveNs = now;
+    if (length >= STAMP_BYTES) {
+      this._latenciesNs.push(Number(now - view.readBigUInt64LE(offset)));
+    }
+  }
+
+  /**
+   * Waits until all messages sent were received, or none arrived for a while
+   * (live mode drops what comes too late).
+   *
+   * @param {{latencyMs: number}} opts
+   */
+  async settle(opts) {
+    let received = -1;
+    while (this.messagesReceived < this.messagesSent && received !== this.messagesReceived) {
+      received = this.messagesReceived;
+      await delay(opts.latencyMs + SETTLE_IDLE_MS);
+    }
+  }
+
+  /**
+   * @returns {object}
+   */
+  result() {
+    const cpu = process.cpuUsage(this._cpuStart);
+    const endNs = this._lastReceiveNs || process.hrtime.bigint();
+    const seconds = Number(endNs - this._startNs) / 1e9;
+    const gigabits = this.bytesReceived * 8 / 1e9;
+    const cpuSeconds = (cpu.user + cpu.system) / 1e6;
+    const latencies = this._latenciesNs.sort((a, b) => a - b);
+    const p50 = percentile(latencies, 0.5);
+    const p99 = percentile(latencies, 0.99);
+    return Object.assign({ name: this.name }, this.extra, {
+      messagesSent: this.messagesSent,
+      messagesReceived: this.messagesReceived,
+      bytesReceived: this.bytesReceived,
+      lossRate: this.messagesSent > 0 ? round(1 - this.messagesReceived / this.messagesSent, 6) : 0,
+      durationMs: round(seconds * 1000, 3),
+      messagesPerSec: round(this.messagesReceived / seconds, 1),
+      mbps: round(gigabits * 1000 / seconds, 3),
+      latencyUs: {
+        p50: p50 === null ? null : round(p50 / 1000, 1),
+        p99: p99 === null ? null : round(p99 / 1000, 1)
+      },
+      cpuMs: round(cpuSeconds * 1000, 3),
+      // CPU seconds per Gbit received, i.e the cores kept busy at 1 Gbps
+      cpuSecPerGbit: gigabits > 0 ? round(cpuSeconds / gigabits, 4) : null
+    });
+  }
+}
+
+function round(value, digits) {
+  const factor = Math.pow(10, digits);
+  return Math.round(value * factor) / factor;
+}
+
+/**
+ * Sets the options every benchmark socket gets.
+ *
+ * @param {SRT} srt
+ * @param {number} socket
+ * @param {{latencyMs: number}} opts
+ */
+function configureSocket(srt, socket, opts) {
+  srt.setSockOpt(socket, SRT.SRTO_LATENCY, opts.latencyMs);
+}
+
+/**
+ * Connects a caller to a listener over the loopback with the sync binding
+ * (the handshake completes without the listener calling accept).
+ *
+ * @param {number} port
+ * @param {object} opts
+ * @returns {{srt: SRT, listener: number, client: number, server: number}}
+ */
+function connectPair(port, opts) {
+  const srt = new SRT();
+  const listener = srt.createSocket();
+  configureSocket(srt, listener, opts);
+  srt.bind(listener, HOST, port);
+  srt.listen(listener, 1);
+
+  const client = srt.createSocket(true);
+  configureSocket(srt, client, opts);
+  srt.connect(client, HOST, port);
+  const server = srt.accept(listener);
+  return { srt, listener, client, server };
+}
+
+/**
+ * @param {{srt: SRT, listener: number, client: number, server: number}} pair
+ */
+function closePair(pair) {
+  [pair.client, pair.server, pair.listener].forEach((socket) => pair.srt.close(socket));
+}
+
+/**
+ * Calls `onReadable` (which may return a Promise) whenever `socket` has data,
+ * from the native epoll pump.
+ *
+ * @param {SRT} srt
+ * @param {number} socket
+ * @param {Function} onReadable
+ * @returns {number} epid, pass it to `srt.epollRelease` when done
+ */
+function watchReadable(srt, socket, onReadable) {
+  const epid = srt.epollCreate();
+  srt.epollAddUsock(epid, socket, SRT.EPOLL_IN | SRT.EPOLL_ERR);
+  srt.epollWatch(epid, (events, err) => {
+    if (err) {
+      console.error('Epoll wait failed:', err);
+      return;
+    }
+    return onReadable();
+  });
+  return epid;
+}
+
+/**
+ * Drains `socket` (non-blocking) with the sync `readBatch` into `recorder`.
+ *
+ * @param {SRT} srt
+ * @param {number} socket
+ * @param {Recorder} recorder
+ * @param {number} payloadSize
+ */
+function drainSync(srt, socket, recorder, payloadSize) {
+  while (true) {
+    const batch = srt.readBatch(socket, READ_BATCH_MAX_MESSAGES, READ_BATCH_MAX_MESSAGES * payloadSize);
+    if (batch === null || batch === SRT.ERROR || batch.offsets.length <= 1) {
+      return;
+    }
+    recorder.onBatch(batch);
+  }
+}
+
+/**
+ * Calls `tick` (which may return a Promise) in a loop for `durationMs`,
+ * yielding to the event loop in between so receivers get to run.
+ *
+ * @param {number} durationMs
+ * @param {Function} tick
+ */
+async function sendFor(durationMs, tick) {
+  const end = Date.now() + durationMs;
+  while (Date.now() < end) {
+    await tick();
+    await yieldToEventLoop();
+  }
+}
+
+/**
+ * @returns {object} what the results of a run depend on, besides the code
+ */
+function describeHost() {
+  const cpus = os.cpus();
+  return {
+    node: process.version,
+    platform: process.platform,
+    arch: process.arch,
+    cpuModel: cpus.length > 0 ? cpus[0].model : null,
+    cpuCount: cpus.length
+  };
+}
+
+module.exports = {
+  HOST,
+  READ_BATCH_MAX_MESSAGES,
+  DEFAULT_OPTIONS,
+  Recorder,
+  stampedMessage,
+  stampMessages,
+  configureSocket,
+  connectPair,
+  closePair,
+  watchReadable,
+  drainSync,
+  sendFor,
+  delay,
+  yieldToEventLoop,
+  describeHost
+};
@@ -0,0 +1,394 @@
+/**
+ * Micro-benchmarks of the N-API marshalling done by the binding (src/node-srt.cc),
+ * each cost isolated from the others and from JS scheduling:
+ * argument unwrapping, receive buffers, epoll event conversion and stats objects.
+ *
+ * Receives and epoll/stats calls run against an SRT loopback pair (TSBPD off,
+ * so messages are readable as soon as they arrive). Only the measured part of
+ * each operation is timed: e.g messages are sent and waited for outside of it.
+ *
+ * Built as its own addon, see the `build_microbench` variable in binding.gyp,
+ * and driven by bench/native/run.js.
+ */
+
+#include <napi.h>
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "../../src/buffer-pool.h"
+#include "../../src/srt-address.h"
+#include "../../src/srt-io.h"
+#include "../../src/srt-values.h"
+
+using namespace std;
+
+namespace {
+
+typedef chrono::steady_clock Clock;
+
+const int PAYLOAD_SIZE = 1316;
+// messages sent and waited for before timing their receive
+const int RECV_BATCH = 256;
+const int RECV_WAIT_MAX_MS = 1000;
+const int EPOLL_EVENTS_MAX = 16;
+
+struct LoopbackPair {
+  SRTSOCKET listener = SRT_INVALID_SOCK;
+  SRTSOCKET sender = SRT_INVALID_SOCK;
+  SRTSOCKET receiver = SRT_INVALID_SOCK;
+  int epid = -1;
+};
+
+LoopbackPair pair;
+
+// keeps the compiler from dropping the work of a loop
+volatile int64_t sink;
+
+double ElapsedNs(Clock::time_point start) {
+  return (double)chrono::duration_cast<chrono::nanoseconds>(Clock::now() - start).count();
+}
+
+bool SendAndWait(int messages) {
+  static char payload[PAYLOAD_SIZE];
+  for (int i = 0; i < messages; i++) {
+    if (srt_sendmsg2(pair.sender, payload, PAYLOAD_SIZE, nullptr) == SRT_ERROR) {
+      return false;
+    }
+  }
+  Clock::time_point start = Clock::now();
+  while (chrono::duration_cast<chrono::milliseconds>(Clock::now() - start).count() < RECV_WAIT_MAX_MS) {
+    int pending = 0;
+    int size = sizeof(pending);
+    if (srt_getsockflag(pair.receiver, SRTO_RCVDATA, &pending, &size) == SRT_ERROR) {
+      return false;
+    }
+    if (pending >= messages) {
+      return true;
+    }
+    this_thread::sleep_for(chrono::microseconds(50));
+  }
+  return false;
+}
+
+/**
+ * Times `readOne` (one receive each) for `iterations` messages,
+ * sent in batches beforehand. Returns -1 if the messages didn't arrive.
+ */
+template <typename ReadOne>
+double TimeReceives(Napi::Env env, int iterations, ReadOne readOne) {
+  double ns = 0;
+  int done = 0;
+  while (done < iterations) {
+    int batch = min(RECV_BATCH, iterations - done);
+    if (!SendAndWait(batch)) {
+      return -1;
+    }
+    Clock::time_point start = Clock::now();
+    for (int i = 0; i < batch; i++) {
+      Napi::HandleScope scope(env);
+      readOne();
+    }
+    ns += ElapsedNs(start);
+    done += batch;
+  }
+  return ns;
+}
+
+/**
+ * Times `op` for `iterations` calls, each within its own handle scope.
+ */
+template <typename Op>
+double TimeOps(Napi::Env env, int iterations, Op op) {
+  Clock::time_point start = Clock::now();
+  for (int i = 0; i < iterations; i++) {
+    Napi::HandleScope scope(env);
+    op();
+  }
+  return ElapsedNs(start);
+}
+
+// Argument unwrapping, as done by every method (args: socket, buffer, msgctrl)
+
+double ArgsNumber(const Napi::CallbackInfo& info, int iterations) {
+  return TimeOps(info.Env(), iterations, [&info]() {
+    sink = info[3].As<Napi::Number>().Int32Value();
+  });
+}
+
+double ArgsBuffer(const Napi::CallbackInfo& info, int iterations) {
+  return TimeOps(info.Env(), iterations, [&info]() {
+    Napi::Buffer<uint8_t> buffer = info[4].As<Napi::Buffer<uint8_t>>();
+    sink = (int64_t)buffer.Length() + buffer.Data()[0];
+  });
+}
+
+double ArgsMsgCtrl(const Napi::CallbackInfo& info, int iterations) {
+  return TimeOps(info.Env(), iterations, [&info]() {
+    Napi::Float64Array array;
+    SRT_MSGCTRL mctrl;
+    if (GetMsgCtrlArg(info, 5, array) && !array.IsEmpty()) {
+      MsgCtrlFromArray(array.Data(), mctrl);
+      sink = mctrl.msgttl;
+    }
+  });
+}
+
+// Receiving one message into a Buffer
+
+double ReadRecvOnly(const Napi::CallbackInfo& info, int iterations) {
+  static char scratch[PAYLOAD_SIZE];
+  return TimeReceives(info.Env(), iterations, []() {
+    sink = srt_recvmsg2(pair.receiver, scratch, PAYLOAD_SIZE, nullptr);
+  });
+}
+
+double ReadMallocCopy(const Napi::CallbackInfo& info, int iterations) {
+  Napi::Env env = info.Env();
+  return TimeReceives(env, iterations, [env]() {
+    char* buffer = (char *)malloc(PAYLOAD_SIZE);
+    int nb = srt_recvmsg2(pair.receiver, buffer, PAYLOAD_SIZE, nullptr);
+    Napi::Buffer<char> copy = Napi::Buffer<char>::Copy(env, buffer, max(nb, 0));
+    free(buffer);
+    sink = (int64_t)copy.Length();
+  });
+}
+
+double ReadPool(const Napi::CallbackInfo& info, int iterations) {
+  Napi::Env env = info.Env();
+  BufferPool& pool = BufferPool::Shared();
+  return TimeReceives(env, iterations, [env, &pool]() {
+    // as NodeSRT::Read, falling back to a copy when the pool is exhausted
+    char* block = pool.Acquire(PAYLOAD_SIZE);
+    char* buffer = block != nullptr ? block : (char *)malloc(PAYLOAD_SIZE);
+    int nb = max(srt_recvmsg2(pair.receiver, buffer, PAYLOAD_SIZE, nullptr), 0);
+    if (block != nullptr) {
+      sink = (int64_t)pool.ToBuffer(env, block, nb).Length();
+      return;
+    }
+    sink = (int64_t)Napi::Buffer<uint8_t>::Copy(env, (uint8_t *)buffer, nb).Length();
+    free(buffer);
+  });
+}
+
+double ReadInto(const Napi::CallbackInfo& info, int iterations) {
+  Napi::Buffer<uint8_t> target = info[4].As<Napi::Buffer<uint8_t>>();
+  char* data = (char *)target.Data();
+  int length = (int)min(target.Length(), (size_t)PAYLOAD_SIZE);
+  return TimeReceives(info.Env(), iterations, [data, length]() {
+    sink = srt_recvmsg2(pair.receiver, data, length, nullptr);
+  });
+}
+
+// Handing the result of srt_epoll_uwait to JS (both sockets of the pair are writable)
+
+double EpollUWaitOnly(const Napi::CallbackInfo& info, int iterations) {
+  return TimeOps(info.Env(), iterations, []() {
+    SRT_EPOLL_EVENT events[EPOLL_EVENTS_MAX];
+    sink = srt_epoll_uwait(pair.epid, events, EPOLL_EVENTS_MAX, 0);
+  });
+}
+
+double EpollUWaitObjects(const Napi::CallbackInfo& info, int iterations) {
+  Napi::Env env = info.Env();
+  return TimeOps(env, iterations, [env]() {
+    SRT_EPOLL_EVENT fdsSet[EPOLL_EVENTS_MAX];
+    int n = max(srt_epoll_uwait(pair.epid, fdsSet, EPOLL_EVENTS_MAX, 0), 0);
+    Napi::Array events = Napi::Array::New(env, n);
+    for (int i = 0; i < n; i++) {
+      Napi::Object event = Napi::Object::New(env);
+      event.Set(Napi::String::New(env, "socket"), Napi::Number::New(env, fdsSet[i].fd));
+      event.Set(Napi::String::New(env, "events"), Napi::Number::New(env, fdsSet[i].events));
+      events[i] = event;
+    }
+    sink = events.Length();
+  });
+}
+
+double EpollUWaitInto(const Napi::CallbackInfo& info, int iterations) {
+  Napi::Int32Array events;
+  if (!GetEpollEventsArg(info, 6, events)) {
+    return -1;
+  }
+  SRT_EPOLL_EVENT* fdsSet = (SRT_EPOLL_EVENT *)events.Data();
+  int fdsSetSize = (int)(events.ElementLength() / 2);
+  return TimeOps(info.Env(), iterations, [fdsSet, fdsSetSize]() {
+    sink = srt_epoll_uwait(pair.epid, fdsSet, fdsSetSize, 0);
+  });
+}
+
+// Stats of one socket
+
+double StatsBstatsOnly(const Napi::CallbackInfo& info, int iterations) {
+  return TimeOps(info.Env(), iterations, []() {
+    SRT_TRACEBSTATS stats;
+    sink = srt_bstats(pair.sender, &stats, false);
+  });
+}
+
+double StatsObject(const Napi::CallbackInfo& info, int iterations) {
+  Napi::Env env = info.Env();
+  return TimeOps(env, iterations, [env]() {
+    SRT_TRACEBSTATS stats;
+    srt_bstats(pair.sender, &stats, false);
+    Napi::Object object = StatsToObject(env, stats);
+    sink = object.IsEmpty() ? 0 : 1;
+  });
+}
+
+double StatsRow(const Napi::CallbackInfo& info, int iterations) {
+  vector<SRTSOCKET> sockets(1, pair.sender);
+  vector<double> row(STATS_FIELD_COUNT);
+  return TimeOps(info.Env(), iterations, [&sockets, &row]() {
+    sink = SampleStats(sockets, row.data(), false);
+  });
+}
+
+struct Benchmark {
+  const char* name;
+  const char* variant;
+  double (*run)(const Napi::CallbackInfo& info, int iterations);
+};
+
+const Benchmark BENCHMARKS[] = {
+  { "args", "number", ArgsNumber },
+  { "args", "buffer", ArgsBuffer },
+  { "args", "msgctrl", ArgsMsgCtrl },
+  { "read", "recv-only", ReadRecvOnly },
+  { "read", "malloc-copy", ReadMallocCopy },
+  { "read", "pool", ReadPool },
+  { "read", "into", ReadInto },
+  { "epoll", "uwait-only", EpollUWaitOnly },
+  { "epoll", "objects", EpollUWaitObjects },
+  { "epoll", "into", EpollUWaitInto },
+  { "stats", "bstats-only", StatsBstatsOnly },
+  { "stats", "object", StatsObject },
+  { "stats", "row", StatsRow }
+};
+
+bool SetFlag(SRTSOCKET socket, SRT_SOCKOPT option, bool value) {
+  return srt_setsockflag(socket, option, &value, sizeof(value)) != SRT_ERROR;
+}
+
+void Teardown() {
+  if (pair.epid != -1) srt_epoll_release(pair.epid);
+  if (pair.sender != SRT_INVALID_SOCK) srt_close(pair.sender);
+  if (pair.receiver != SRT_INVALID_SOCK) srt_close(pair.receiver);
+  if (pair.listener != SRT_INVALID_SOCK) srt_close(pair.listener);
+  pair = LoopbackPair();
+}
+
+/**
+ * Connects the loopback pair on `port`.
+ */
+Napi::Value Setup(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  int port = info[0].As<Napi::Number>().Int32Value();
+
+  srt_startup();
+  Teardown();
+
+  sockaddr_storage addr;
+  int addrLen;
+  if (!ToSockAddr("127.0.0.1", port, addr, addrLen)) {
+    Napi::Error::New(env, "Invalid port").ThrowAsJavaScriptException();
+    return Napi::Number::New(env, SRT_ERROR);
+  }
+  pair.listener = srt_create_socket();
+  pair.sender = srt_create_socket();
+  bool ok = SetFlag(pair.listener, SRTO_TSBPDMODE, false)
+    && SetFlag(pair.sender, SRTO_TSBPDMODE, false)
+    && SetFlag(pair.sender, SRTO_SENDER, true)
+    && srt_bind(pair.listener, (const sockaddr *)&addr, addrLen) != SRT_ERROR
+    && srt_listen(pair.listener, 1) != SRT_ERROR
+    && srt_connect(pair.sender, (const sockaddr *)&addr, addrLen) != SRT_ERROR;
+  if (ok) {
+    pair.receiver = srt_accept(pair.listener, nullptr, nullptr);
+    ok = pair.receiver != SRT_INVALID_SOCK;
+  }
+  if (ok) {
+    int events = SRT_EPOLL_OUT;
+    pair.epid = srt_epoll_create();
+    ok = pair.epid != SRT_ERROR
+      && srt_epoll_add_usock(pair.epid, pair.sender, &events) != SRT_ERROR
+      && srt_epoll_add_usock(pair.epid, pair.receiver, &events) != SRT_ERROR;
+  }
+  if (!ok) {
+    string err(srt_getlasterror_str());
+    Teardown();
+    Napi::Error::New(env, err).ThrowAsJavaScriptException();
+    return Napi::Number::New(env, SRT_ERROR);
+  }
+  return Napi::Number::New(env, 0);
+}
+
+Napi::Value Close(const Napi::CallbackInfo& info) {
+  Teardown();
+  return Napi::Number::New(info.Env(), 0);
+}
+
+/**
+ * @returns {Array<{name, variant}>}
+ */
+Napi::Value List(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  size_t count = sizeof(BENCHMARKS) / sizeof(BENCHMARKS[0]);
+  Napi::Array list = Napi::Array::New(env, count);
+  for (size_t i = 0; i < count; i++) {
+    Napi::Object entry = Napi::Object::New(env);
+    entry.Set("name", BENCHMARKS[i].name);
+    entry.Set("variant", BENCHMARKS[i].variant);
+    list[i] = entry;
+  }
+  return list;
+}
+
+/**
+ * run(name, variant, iterations, socket, buffer, msgctrl, events):
+ * returns the nanoseconds spent in the measured part of `iterations` operations.
+ */
+Napi::Value Run(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  string name = info[0].As<Napi::String>();
+  string variant = info[1].As<Napi::String>();
+  int iterations = info[2].As<Napi::Number>().Int32Value();
+
+  if (pair.sender == SRT_INVALID_SOCK) {
+    Napi::Error::New(env, "Call setup() first").ThrowAsJavaScriptException();
+    return Napi::Number::New(env, SRT_ERROR);
+  }
+  for (const Benchmark& benchmark : BENCHMARKS) {
+    if (name != benchmark.name || variant != benchmark.variant) {
+      continue;
+    }
+    double ns = benchmark.run(info, iterations);
+    if (env.IsExceptionPending()) {
+      return Napi::Number::New(env, SRT_ERROR);
+    }
+    if (ns < 0) {
+      Napi::Error::New(env, "Benchmark " + name + "/" + variant + " failed: "
+        + srt_getlasterror_str()).ThrowAsJavaScriptException();
+      return Napi::Number::New(env, SRT_ERROR);
+    }
+    return Napi::Number::New(env, ns);
+  }
+  Napi::Error::New(env, "Unknown benchmark: " + name + "/" + variant).ThrowAsJavaScriptException();
+  return Napi::Number::New(env, SRT_ERROR);
+}
+
+}
+
+Napi::Object InitAll(Napi::Env env, Napi::Object exports) {
+  exports.Set("setup", Napi::Function::New(env, Setup));
+  exports.Set("close", Napi::Function::New(env, Close));
+  exports.Set("list", Napi::Function::New(env, List));
+  exports.Set("run", Napi::Function::New(env, Run));
+  return exports;
+}
+
+NODE_API_MODULE(NODE_GYP_MODULE_NAME, InitAll)
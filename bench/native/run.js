@@ -0,0 +1,79 @@
+/**
+ * Runs the native micro-benchmarks of the N-API marshalling (bench/native/microbench.cc)
+ * and prints one JSON report with ns/op and the JS heap and external (Buffer backing store)
+ * bytes allocated per op of every variant.
+ *
+ * Build the addon first (it is not part of the default build):
+ *   npm run rebuild-microbench
+ *
+ * Usage: npm run bench-native -- [iterations] [port]
+ * (runs node with --expose-gc and a large young generation, so the allocation
+ * probes of a few thousand ops don't trigger a GC while they are measured)
+ */
+
+const v8 = require('v8');
+
+const microbench = require('../../build/Release/node_srt_microbench.node');
+const { SRT, createMsgCtrl } = require('../../index');
+const { describeHost } = require('../common');
+
+const ITERATIONS = Number(process.argv[2]) || 100000;
+const PORT = Number(process.argv[3]) || 1295;
+
+const WARMUP_ITERATIONS = 1000;
+const ALLOCATION_PROBE_ITERATIONS = 1000;
+const PAYLOAD_SIZE = 1316;
+const EPOLL_EVENTS_MAX = 16;
+
+/**
+ * @returns {{heapBytesPerOp: number, externalBytesPerOp: number} | null} null without --expose-gc
+ */
+function probeAllocations(name, variant, args) {
+  if (!global.gc) {
+    return null;
+  }
+  global.gc();
+  const before = v8.getHeapStatistics();
+  microbench.run(name, variant, ALLOCATION_PROBE_ITERATIONS, ...args);
+  const after = v8.getHeapStatistics();
+  const perOp = (field) =>
+    Math.max(0, Math.round((after[field] - before[field]) / ALLOCATION_PROBE_ITERATIONS));
+  return {
+    heapBytesPerOp: perOp('used_heap_size'),
+    externalBytesPerOp: perOp('external_memory')
+  };
+}
+
+function main() {
+  // arguments unwrapped by the `args` benchmarks, the read target of `read/into`
+  // and the events array of `epoll/into`
+  const args = [
+    1,
+    Buffer.alloc(PAYLOAD_SIZE),
+    createMsgCtrl(),
+    new Int32Array(EPOLL_EVENTS_MAX * 2)
+  ];
+
+  microbench.setup(PORT);
+  const results = microbench.list().map(({ name, variant }) => {
+    microbench.run(name, variant, WARMUP_ITERATIONS, ...args);
+    const allocations = probeAllocations(name, variant, args);
+    const ns = microbench.run(name, variant, ITERATIONS, ...args);
+    return Object.assign({
+      name,
+      variant,
+      iterations: ITERATIONS,
+      nsPerOp: Math.round(ns / ITERATIONS * 10) / 10
+    }, allocations || { heapBytesPerOp: null, externalBytesPerOp: null });
+  });
+  microbench.close();
+
+  console.log(JSON.stringify({
+    host: describeHost(),
+    payloadSize: PAYLOAD_SIZE,
+    statsFields: SRT.STATS_FIELD_COUNT,
+    results
+  }, null, 2));
+}
+
+main();
@@ -0,0 +1,85 @@
+/**
+ * Loopback benchmark suite: sends stamped messages over 127.0.0.1 through each API
+ * for a fixed time and prints one JSON report, to compare releases.
+ *
+ * For every scenario it reports messages/s and Mbps received, the p50/p99 one-way
+ * latency (including SRTO_LATENCY, as TSBPD holds messages back until then),
+ * the loss rate and the CPU time of the whole process per Gbit received.
+ *
+ * Usage: node bench/run.js [--duration ms] [--payload bytes] [--latency ms]
+ *   [--clients n] [--port n] [--only scenario,...] [--out file.json]
+ */
+
+const fs = require('fs');
+
+const { DEFAULT_OPTIONS, describeHost, delay } = require('./common');
+const { version } = require('../package.json');
+
+const SCENARIOS = [
+  require('./scenarios/sync-binding'),
+  require('./scenarios/async-srt'),
+  require('./scenarios/write-modes'),
+  require('./scenarios/streams'),
+  require('./scenarios/srt-server')
+];
+
+// ports reserved for each scenario
+const PORTS_PER_SCENARIO = 10;
+
+// lets SRT close the sockets of the previous scenario
+const PAUSE_BETWEEN_SCENARIOS_MS = 500;
+
+function parseArgs(argv) {
+  const opts = Object.assign({}, DEFAULT_OPTIONS, { only: null, out: null });
+  for (let i = 0; i < argv.length; i += 2) {
+    const value = argv[i + 1];
+    switch (argv[i]) {
+    case '--duration': opts.durationMs = Number(value); break;
+    case '--payload': opts.payloadSize = Number(value); break;
+    case '--latency': opts.latencyMs = Number(value); break;
+    case '--clients': opts.clients = Number(value); break;
+    case '--port': opts.basePort = Number(value); break;
+    case '--only': opts.only = value.split(','); break;
+    case '--out': opts.out = value; break;
+    default:
+      throw new Error(`Unknown option: ${argv[i]}`);
+    }
+  }
+  return opts;
+}
+
+(async function main() {
+  const opts = parseArgs(process.argv.slice(2));
+  const results = [];
+  for (let i = 0; i < SCENARIOS.length; i++) {
+    const scenario = SCENARIOS[i];
+    if (opts.only && !opts.only.includes(scenario.name)) {
+      continue;
+    }
+    console.error(`Running ${scenario.name} ...`);
+    results.push(...await scenario.run(opts, opts.basePort + i * PORTS_PER_SCENARIO));
+    await delay(PAUSE_BETWEEN_SCENARIOS_MS);
+  }
+
+  const report = JSON.stringify({
+    version,
+    date: new Date().toISOString(),
+    host: describeHost(),
+    options: {
+      durationMs: opts.durationMs,
+      payloadSize: opts.payloadSize,
+      latencyMs: opts.latencyMs,
+      clients: opts.clients
+    },
+    results
+  }, null, 2);
+
+  if (opts.out) {
+    fs.writeFileSync(opts.out, report);
+  }
+  console.log(report);
+  process.exit(0);
+})().catch((err) => {
+  console.error(err);
+  process.exit(1);
+});
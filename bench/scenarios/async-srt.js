@@ -0,0 +1,62 @@
+/**
+ * `AsyncSRT` with each transport: pipelined `write` calls of one message
+ * on the sender, `readBatch` on the (non-blocking) receiver whenever
+ * the epoll pump reports it readable.
+ */
+
+const { SRT, AsyncSRT, AsyncSRTTransport } = require('../../index');
+const { Recorder, READ_BATCH_MAX_MESSAGES, stampedMessage, connectPair, closePair,
+  watchReadable, sendFor } = require('../common');
+
+// write calls in flight at once
+const WRITES_IN_FLIGHT = 64;
+
+async function runTransport(transport, opts, port) {
+  const pair = connectPair(port, opts);
+  const { srt, client, server } = pair;
+  srt.setSockOpt(server, SRT.SRTO_RCVSYN, false);
+
+  const asyncSrt = new AsyncSRT({ transport });
+  const recorder = new Recorder(`async-srt/${transport}`, { transport });
+  const epid = watchReadable(srt, server, async () => {
+    while (true) {
+      const batch = await asyncSrt.readBatch(server, READ_BATCH_MAX_MESSAGES,
+        READ_BATCH_MAX_MESSAGES * opts.payloadSize);
+      if (batch === null || batch === SRT.ERROR || batch.offsets.length <= 1) {
+        return;
+      }
+      recorder.onBatch(batch);
+    }
+  });
+
+  recorder.start();
+  await sendFor(opts.durationMs, async () => {
+    const writes = [];
+    for (let i = 0; i < WRITES_IN_FLIGHT; i++) {
+      // a fresh buffer for every call, as the worker transport detaches it
+      writes.push(asyncSrt.write(client, stampedMessage(opts.payloadSize)));
+    }
+    recorder.countSent(WRITES_IN_FLIGHT);
+    await Promise.all(writes);
+  });
+  await recorder.settle(opts);
+
+  srt.epollRelease(epid);
+  closePair(pair);
+  await asyncSrt.dispose();
+  return recorder.result();
+}
+
+async function run(opts, port) {
+  const transports = [AsyncSRTTransport.NATIVE, AsyncSRTTransport.WORKER, AsyncSRTTransport.SHARED_RING];
+  const results = [];
+  for (let i = 0; i < transports.length; i++) {
+    results.push(await runTransport(transports[i], opts, port + i));
+  }
+  return results;
+}
+
+module.exports = {
+  name: 'async-srt',
+  run
+};
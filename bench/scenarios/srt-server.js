@@ -0,0 +1,70 @@
+/**
+ * `SRTServer` receiving from `clients` concurrent callers (sync binding,
+ * blocking writes in round-robin bursts). Every connection drains itself
+ * with `SRTConnection#read` when it emits 'data'.
+ */
+
+const { SRT, SRTServer } = require('../../index');
+const { HOST, Recorder, stampedMessage, configureSocket, sendFor } = require('../common');
+
+// messages written per client and event-loop turn
+const WRITE_BURST = 16;
+
+function drainOnData(connection, recorder, payloadSize) {
+  let draining = false;
+  connection.on('data', async () => {
+    // the listener is level-triggered: one drain at a time per connection
+    if (draining) return;
+    draining = true;
+    while (!connection.isClosed()) {
+      const message = await connection.read(payloadSize);
+      if (message === null || message === SRT.ERROR) {
+        break;
+      }
+      recorder.onMessage(message);
+    }
+    draining = false;
+  });
+}
+
+async function run(opts, port) {
+  const recorder = new Recorder(`srt-server/${opts.clients}-clients`, { clients: opts.clients });
+
+  const server = await SRTServer.create(port, HOST, 0, {
+    acceptOptions: { [SRT.SRTO_RCVSYN]: false }
+  });
+  await server.setSocketFlags([SRT.SRTO_LATENCY], [opts.latencyMs]);
+  server.on('connection', (connection) => {
+    drainOnData(connection, recorder, opts.payloadSize);
+  });
+  await server.open();
+
+  const srt = new SRT();
+  const clients = [];
+  for (let i = 0; i < opts.clients; i++) {
+    const client = srt.createSocket(true);
+    configureSocket(srt, client, opts);
+    srt.connect(client, HOST, port);
+    clients.push(client);
+  }
+
+  recorder.start();
+  await sendFor(opts.durationMs, () => {
+    clients.forEach((client) => {
+      for (let i = 0; i < WRITE_BURST; i++) {
+        srt.write(client, stampedMessage(opts.payloadSize));
+      }
+    });
+    recorder.countSent(WRITE_BURST * clients.length);
+  });
+  await recorder.settle(opts);
+
+  clients.forEach((client) => srt.close(client));
+  await server.dispose();
+  return [recorder.result()];
+}
+
+module.exports = {
+  name: 'srt-server',
+  run
+};
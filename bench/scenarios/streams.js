@@ -0,0 +1,45 @@
+/**
+ * `SRTWriteStream` writing payload-sized chunks (waiting for 'drain' when
+ * `write` returns false) into an `SRTReadStream` listening on the loopback.
+ */
+
+const { SRT, SRTReadStream, SRTWriteStream } = require('../../index');
+const { HOST, Recorder, stampedMessage, sendFor } = require('../common');
+
+function once(emitter, event) {
+  return new Promise((resolve) => emitter.once(event, resolve));
+}
+
+async function run(opts, port) {
+  const recorder = new Recorder('streams/pipe');
+
+  const reader = new SRTReadStream(HOST, port);
+  reader.srt.setSockOpt(reader.socket, SRT.SRTO_LATENCY, opts.latencyMs);
+  reader.listen((readStream) => {
+    readStream.on('data', (chunk) => recorder.onMessages(chunk, opts.payloadSize));
+  });
+
+  const writer = new SRTWriteStream(HOST, port, { payloadSize: opts.payloadSize });
+  writer.srt.setSockOpt(writer.socket, SRT.SRTO_LATENCY, opts.latencyMs);
+  await new Promise((resolve) => writer.connect(resolve));
+
+  recorder.start();
+  await sendFor(opts.durationMs, async () => {
+    let ready = true;
+    while (ready) {
+      ready = writer.write(stampedMessage(opts.payloadSize));
+      recorder.countSent(1);
+    }
+    await once(writer, 'drain');
+  });
+  await recorder.settle(opts);
+
+  writer.close();
+  reader.close();
+  return [recorder.result()];
+}
+
+module.exports = {
+  name: 'streams',
+  run
+};
@@ -0,0 +1,45 @@
+/**
+ * The sync `SRT` binding: blocking `write` of one message per call on the
+ * sender, `read` of one message per call on the (non-blocking) receiver.
+ */
+
+const { SRT } = require('../../index');
+const { Recorder, stampedMessage, connectPair, closePair, watchReadable, sendFor } = require('../common');
+
+// messages written per event-loop turn
+const WRITE_BURST = 64;
+
+async function run(opts, port) {
+  const pair = connectPair(port, opts);
+  const { srt, client, server } = pair;
+  srt.setSockOpt(server, SRT.SRTO_RCVSYN, false);
+
+  const recorder = new Recorder('sync-binding/read-write');
+  const epid = watchReadable(srt, server, () => {
+    while (true) {
+      const message = srt.read(server, opts.payloadSize);
+      if (message === null || message === SRT.ERROR) {
+        return;
+      }
+      recorder.onMessage(message);
+    }
+  });
+
+  recorder.start();
+  await sendFor(opts.durationMs, () => {
+    for (let i = 0; i < WRITE_BURST; i++) {
+      srt.write(client, stampedMessage(opts.payloadSize));
+    }
+    recorder.countSent(WRITE_BURST);
+  });
+  await recorder.settle(opts);
+
+  srt.epollRelease(epid);
+  closePair(pair);
+  return [recorder.result()];
+}
+
+module.exports = {
+  name: 'sync-binding',
+  run
+};
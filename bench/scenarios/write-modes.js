@@ -0,0 +1,81 @@
+/**
+ * The write modes of `AsyncReaderWriter` (src/async-write-modes.js) over the
+ * native `AsyncSRT` transport, sending rounds of messages stamped when the
+ * round starts, so the latency includes the time a message waits in its round.
+ * The receiver is the same for all modes: sync `readBatch` from the epoll pump.
+ */
+
+const { SRT, AsyncSRT, AsyncSRTTransport } = require('../../index');
+const {
+  writeChunksWithYieldingLoop,
+  writeChunksWithExplicitScheduling,
+  writeBufferWithScatterSend
+} = require('../../src/async-write-modes');
+const { Recorder, stampedMessage, stampMessages, connectPair, closePair,
+  watchReadable, drainSync, sendFor } = require('../common');
+
+const MESSAGES_PER_ROUND = 256;
+const WRITES_PER_TICK = 64;
+
+function stampedChunks(payloadSize) {
+  const chunks = [];
+  for (let i = 0; i < MESSAGES_PER_ROUND; i++) {
+    chunks.push(stampedMessage(payloadSize));
+  }
+  return chunks;
+}
+
+const MODES = {
+  'yielding-loop': (asyncSrt, fd, payloadSize) =>
+    writeChunksWithYieldingLoop(asyncSrt, fd, stampedChunks(payloadSize), null, WRITES_PER_TICK),
+
+  'explicit-scheduling': (asyncSrt, fd, payloadSize) => new Promise((resolve) => {
+    writeChunksWithExplicitScheduling(asyncSrt, fd, stampedChunks(payloadSize),
+      (result, index) => {
+        if (index === MESSAGES_PER_ROUND - 1) resolve();
+      }, WRITES_PER_TICK, 0);
+  }),
+
+  'scatter-send': (asyncSrt, fd, payloadSize) => {
+    const buffer = Buffer.alloc(MESSAGES_PER_ROUND * payloadSize);
+    stampMessages(buffer, payloadSize);
+    return writeBufferWithScatterSend(asyncSrt, fd, buffer, payloadSize);
+  }
+};
+
+async function runMode(mode, opts, port) {
+  const pair = connectPair(port, opts);
+  const { srt, client, server } = pair;
+  srt.setSockOpt(server, SRT.SRTO_RCVSYN, false);
+
+  const asyncSrt = new AsyncSRT({ transport: AsyncSRTTransport.NATIVE });
+  const recorder = new Recorder(`write-modes/${mode}`, { mode });
+  const epid = watchReadable(srt, server,
+    () => drainSync(srt, server, recorder, opts.payloadSize));
+
+  recorder.start();
+  await sendFor(opts.durationMs, async () => {
+    await MODES[mode](asyncSrt, client, opts.payloadSize);
+    recorder.countSent(MESSAGES_PER_ROUND);
+  });
+  await recorder.settle(opts);
+
+  srt.epollRelease(epid);
+  closePair(pair);
+  await asyncSrt.dispose();
+  return recorder.result();
+}
+
+async function run(opts, port) {
+  const modes = Object.keys(MODES);
+  const results = [];
+  for (let i = 0; i < modes.length; i++) {
+    results.push(await runMode(modes[i], opts, port + i));
+  }
+  return results;
+}
+
+module.exports = {
+  name: 'write-modes',
+  run
+};
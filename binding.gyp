@@ -1,12 +1,11 @@
 {
-  "targets": [{
-    "target_name": "node_srt",
+  "variables": {
+    # `node-gyp rebuild --build_microbench=true` also builds bench/native (see bench/native/run.js)
+    "build_microbench%": "false"
+  },
+  "target_defaults": {
     "cflags!": [ "-fno-exceptions" ],
     "cflags_cc!": [ "-fno-exceptions" ],
-    "sources": [
-      "src/binding.cc",
-      "src/node-srt.cc"
-    ],
     "include_dirs": [
       "<!@(node -p \"require('node-addon-api').include\")"
     ],
@@ -39,5 +38,47 @@
       "<!(node -p \"require('node-addon-api').gyp\")"
     ],
     "defines": [ "NAPI_DISABLE_CPP_EXCEPTIONS" ]
-  }]
+  },
+  "targets": [{
+    "target_name": "node_srt",
+    "sources": [
+      "src/binding.cc",
+      "src/buffer-pool.cc",
+      "src/epoll-pump.cc",
+      "src/fan-out.cc",
+      "src/node-srt.cc",
+      "src/node-srt-async.cc",
+      "src/node-srt-fan-out.cc",
+      "src/node-srt-relay.cc",
+      "src/node-srt-send-scheduler.cc",
+      "src/node-srt-stats-sampler.cc",
+      "src/relay.cc",
+      "src/send-scheduler.cc",
+      "src/srt-address.cc",
+      "src/srt-executor.cc",
+      "src/srt-group.cc",
+      "src/srt-io.cc",
+      "src/srt-values.cc",
+      "src/stats-sampler.cc",
+      "src/stream-id-filter.cc",
+      "src/ts-packetizer.cc"
+    ]
+  }],
+  "conditions": [
+    [ 'build_microbench=="true"', {
+      "targets": [{
+        "target_name": "node_srt_microbench",
+        "sources": [
+          "bench/native/microbench.cc",
+          "src/buffer-pool.cc",
+          "src/srt-address.cc",
+          "src/srt-io.cc",
+          "src/srt-values.cc"
+        ],
+        "include_dirs+": [
+          "src"
+        ]
+      }]
+    }]
+  ]
 }
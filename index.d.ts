@@ -1,4 +1,5 @@
 import { SRTLoggingLevel } from "./src/srt-api-enums";
+import { SRTStats } from "./types/srt-api";
 
 export * from "./types/srt-api";
 export * from "./types/srt-api-async";
@@ -6,3 +7,11 @@ export * from "./types/srt-server";
 export * from "./types/srt-stream";
 
 export function setSRTLoggingLevel(level: SRTLoggingLevel);
+
+export function createMsgCtrl(options?: { ttl?: number, inorder?: boolean, srctime?: number }): Float64Array;
+
+export const STATS_FIELD_INDEX: { readonly [field in keyof SRTStats]: number };
+
+export function createStatsRows(socketCount: number): Float64Array;
+
+export function decodeStatsRow(rows: Float64Array, row: number): SRTStats | null;
@@ -1,15 +1,30 @@
-const { SRT } = require('./build/Release/node_srt.node');
-const { AsyncSRT } = require('./src/async');
+const { SRT, SRTFanOut, SRTRelay, SRTSendScheduler, SRTStatsSampler } = require('./build/Release/node_srt.node');
+const { AsyncSRT, AsyncSRTTransport } = require('./src/async');
 const { SRTReadStream } = require('./src/srt-stream-readable.js');
 const { SRTWriteStream } = require('./src/srt-stream-writable.js');
 const { SRTServer } = require('./src/srt-server');
+const { SRTConnector } = require('./src/srt-connector');
+const { SRTFileTransfer } = require('./src/srt-file-transfer');
 const { setSRTLoggingLevel } = require('./src/logging');
+const { createMsgCtrl } = require('./src/msgctrl');
+const { STATS_FIELD_INDEX, createStatsRows, decodeStatsRow } = require('./src/stats');
 
 module.exports = {
   SRT,
+  SRTFanOut,
+  SRTRelay,
+  SRTSendScheduler,
+  SRTStatsSampler,
   AsyncSRT,
+  AsyncSRTTransport,
   SRTServer,
+  SRTConnector,
+  SRTFileTransfer,
   SRTReadStream,
   SRTWriteStream,
-  setSRTLoggingLevel
+  setSRTLoggingLevel,
+  createMsgCtrl,
+  STATS_FIELD_INDEX,
+  createStatsRows,
+  decodeStatsRow
 };
@@ -108,7 +108,7 @@ function buildWin32() {
   }
 
   console.log("Running cmake generator");
-  const generator = spawnSync('cmake', [ '"'+srtSourcePath+'"', '-DCMAKE_BUILD_TYPE=Release', '-G"Visual Studio 16 2019"', '-A', process.arch, '-DCMAKE_TOOLCHAIN_FILE="%VCPKG_ROOT%\\scripts\\buildsystems\\vcpkg.cmake' ], { cwd: buildDir, shell: true } );
+  const generator = spawnSync('cmake', [ '"'+srtSourcePath+'"', '-DCMAKE_BUILD_TYPE=Release', '-DENABLE_BONDING=ON', '-G"Visual Studio 16 2019"', '-A', process.arch, '-DCMAKE_TOOLCHAIN_FILE="%VCPKG_ROOT%\\scripts\\buildsystems\\vcpkg.cmake' ], { cwd: buildDir, shell: true } );
   if (generator.stdout)
     console.log(generator.stdout.toString());
   if (generator.status) {
@@ -128,7 +128,7 @@ function buildWin32() {
 
 function buildNx() {
   console.log("Running ./configure");
-  const configure = spawnSync('./configure', [ '--prefix', buildDir ], { cwd: srtSourcePath, shell: true, stdio: 'inherit' } );
+  const configure = spawnSync('./configure', [ '--prefix', buildDir, '--enable-bonding' ], { cwd: srtSourcePath, shell: true, stdio: 'inherit' } );
   if (configure.status) {
     process.exit(configure.status);
   }
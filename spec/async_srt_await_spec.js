@@ -1,4 +1,9 @@
-const { SRT, AsyncSRT } = require('../index.js');
+const fs = require('fs');
+const os = require('os');
+const path = require('path');
+
+const { SRT, AsyncSRT, AsyncSRTTransport, SRTServer, SRTFileTransfer } = require('../index.js');
+const { SRTAsync } = require('../build/Release/node_srt.node');
 
 describe("Async SRT API with async/await", () => {
   it("can create an SRT socket", async () => {
@@ -18,4 +23,213 @@ describe("Async SRT API with async/await", () => {
 
     //return await asyncSrt.dispose();
   });
+
+  it("keeps the order of calls on the same socket", async () => {
+    const asyncSrt = new AsyncSRT();
+    const socket = await asyncSrt.createSocket(false);
+
+    const [setResult, value] = await Promise.all([
+      asyncSrt.setSockOpt(socket, SRT.SRTO_MSS, 1052),
+      asyncSrt.getSockOpt(socket, SRT.SRTO_MSS)
+    ]);
+
+    expect(setResult).not.toEqual(SRT.ERROR);
+    expect(value).toEqual(1052);
+
+    await asyncSrt.dispose();
+  });
+
+  it("rejects the calls still queued when disposed", async () => {
+    const srt = new SRT();
+    const server = srt.createSocket();
+    srt.bind(server, '127.0.0.1', 1261);
+    srt.listen(server, 1);
+
+    const binding = new SRTAsync(1);
+    // blocks the only thread of the executor until the listener is closed
+    const accepting = binding.accept(server);
+    const queued = binding.getSockState(server);
+    expect(binding.dispose()).toBeGreaterThanOrEqual(1);
+    await expectAsync(queued).toBeRejectedWithError("SRT executor was shut down");
+
+    srt.close(server);
+    await expectAsync(accepting).toBeRejected();
+  });
+
+  it("can still run calls on the worker transport", async () => {
+    const asyncSrt = new AsyncSRT({ transport: AsyncSRTTransport.WORKER });
+    const socket = await asyncSrt.createSocket(false);
+    const state = await asyncSrt.getSockState(socket);
+
+    expect(state).toEqual(SRT.SRTS_INIT);
+
+    await asyncSrt.dispose();
+  });
+
+  it("passes payloads through shared rings without detaching them", async () => {
+    // small rings, so that a burst of writes has to wait for room
+    const asyncSrt = new AsyncSRT({ transport: AsyncSRTTransport.SHARED_RING, ringBytes: 16 * 1024 });
+    const server = await asyncSrt.createSocket(false);
+    await asyncSrt.bind(server, '127.0.0.1', 1259);
+    await asyncSrt.listen(server, 1);
+    const client = await asyncSrt.createSocket(true);
+    const [connected, connection] = await Promise.all([
+      asyncSrt.connect(client, '127.0.0.1', 1259),
+      asyncSrt.accept(server)
+    ]);
+    expect(connected).not.toEqual(SRT.ERROR);
+
+    const chunk = Buffer.alloc(1316);
+    const writes = [];
+    for (let i = 0; i < 32; i++) {
+      chunk.fill(i);
+      writes.push(asyncSrt.write(client, Buffer.from(chunk)));
+    }
+    expect(await asyncSrt.write(client, chunk)).toEqual(1316);
+    expect(chunk.byteLength).toEqual(1316);
+    expect(await Promise.all(writes)).toEqual(new Array(32).fill(1316));
+
+    for (let i = 0; i < 32; i++) {
+      const message = await asyncSrt.read(connection, 1316);
+      expect(message.byteLength).toEqual(1316);
+      expect(message[0]).toEqual(i);
+    }
+
+    await asyncSrt.close(client);
+    await asyncSrt.close(connection);
+    await asyncSrt.close(server);
+    await asyncSrt.dispose();
+  });
+
+  it("spreads server connections over shards", async () => {
+    const server = await SRTServer.create(1250, '127.0.0.1', 0, { shards: 2 });
+    await server.open();
+    const connected = new Promise((resolve) => {
+      let count = 0;
+      server.on('connection', () => {
+        if (++count === 2) resolve();
+      });
+    });
+
+    const srt = new SRT();
+    const clients = [srt.createSocket(true), srt.createSocket(true)];
+    clients.forEach((client) => srt.connect(client, '127.0.0.1', 1250));
+    await connected;
+
+    const metrics = server.getShardMetrics();
+    expect(server.shards).toEqual(2);
+    expect(metrics.map((shard) => shard.connections)).toEqual([1, 1]);
+    expect(metrics[0].events).toBeGreaterThan(0);
+
+    clients.forEach((client) => srt.close(client));
+    await Promise.all(server.getAllConnections().map((connection) => connection.close()));
+    expect(server.getShardMetrics().map((shard) => shard.connections)).toEqual([0, 0]);
+    await server.dispose();
+  });
+
+  it("cuts an MPEG-TS stream into messages of 7 packets", async () => {
+    const srt = new SRT();
+    const server = srt.createSocket();
+    srt.bind(server, '127.0.0.1', 1251);
+    srt.listen(server, 10);
+    const client = srt.createSocket(true);
+    srt.connect(client, '127.0.0.1', 1251);
+    const fd = srt.accept(server);
+    srt.setSockOpt(fd, SRT.SRTO_RCVSYN, false);
+
+    const packets = Buffer.alloc(10 * 188);
+    for (let i = 0; i < 10; i++) {
+      packets[i * 188] = 0x47;
+    }
+    // out of sync bytes before and between packets
+    const stream = Buffer.concat([Buffer.from([1, 2, 3]), packets.subarray(0, 3 * 188),
+      Buffer.from([4, 5]), packets.subarray(3 * 188)]);
+
+    const asyncSrt = new AsyncSRT();
+    // packets cut across calls are completed by the next one
+    expect(await asyncSrt.writeTs(client, stream.subarray(0, 1000))).toEqual(0);
+    expect(await asyncSrt.writeTs(client, stream.subarray(1000), false, true)).toEqual(10 * 188);
+
+    await new Promise((resolve) => setTimeout(resolve, 500));
+    const { offsets } = srt.readBatch(fd, 16, 16 * 1024);
+    expect(Array.from(offsets)).toEqual([0, 1316, 1880]);
+
+    srt.close(client);
+    srt.close(fd);
+    await asyncSrt.dispose();
+  });
+
+  it("keeps close in order with the paced writes of a socket", async () => {
+    const srt = new SRT();
+    const server = srt.createSocket();
+    srt.bind(server, '127.0.0.1', 1262);
+    srt.listen(server, 10);
+    const client = srt.createSocket(true);
+    srt.connect(client, '127.0.0.1', 1262);
+    const fd = srt.accept(server);
+
+    const packets = Buffer.alloc(10 * 188);
+    for (let i = 0; i < 10; i++) {
+      packets[i * 188] = 0x47;
+    }
+
+    const asyncSrt = new AsyncSRT();
+    const settled = [];
+    // without PCRs nothing is waited for, but the socket moves to its pacing thread
+    const writing = asyncSrt.writeTs(client, packets, true).then((result) => settled.push(["writeTs", result]));
+    const closing = asyncSrt.close(client).then((result) => settled.push(["close", result]));
+    await Promise.all([writing, closing]);
+    expect(settled).toEqual([["writeTs", 7 * 188], ["close", SRT.OK]]);
+
+    // the pacing thread went away with the socket, later calls on it go to the shared lanes
+    expect(await asyncSrt.writeTs(client, packets)).toEqual(SRT.ERROR);
+
+    srt.close(fd);
+    srt.close(server);
+    await asyncSrt.dispose();
+  });
+
+  it("transfers a file in ranges and resumes at an offset", async () => {
+    const srt = new SRT();
+    const server = srt.createSocket();
+    srt.setSockOpt(server, SRT.SRTO_TRANSTYPE, SRT.SRTT_FILE);
+    srt.bind(server, '127.0.0.1', 1252);
+    srt.listen(server, 10);
+    const client = srt.createSocket(true);
+    srt.setSockOpt(client, SRT.SRTO_TRANSTYPE, SRT.SRTT_FILE);
+    srt.connect(client, '127.0.0.1', 1252);
+    const fd = srt.accept(server);
+
+    const dir = fs.mkdtempSync(path.join(os.tmpdir(), 'srt-file-'));
+    const source = path.join(dir, 'source.bin');
+    const target = path.join(dir, 'target.bin');
+    const data = Buffer.alloc(3 * 100000);
+    for (let i = 0; i < data.length; i++) {
+      data[i] = i % 251;
+    }
+    fs.writeFileSync(source, data);
+    // as left by an interrupted transfer
+    fs.writeFileSync(target, data.subarray(0, 100000));
+
+    const asyncSrt = new AsyncSRT();
+    const sender = new SRTFileTransfer(asyncSrt, client, 100000);
+    const receiver = new SRTFileTransfer(asyncSrt, fd, 100000);
+    const progress = [];
+    receiver.on('progress', ({ offset }) => progress.push(offset));
+
+    const [sent, received] = await Promise.all([
+      sender.send(source, 100000),
+      receiver.receive(target, 100000, 200000)
+    ]);
+    expect(sent).toEqual(data.length);
+    expect(received).toEqual(data.length);
+    expect(progress).toEqual([200000, 300000]);
+    expect(fs.readFileSync(target).equals(data)).toBe(true);
+
+    srt.close(client);
+    srt.close(fd);
+    srt.close(server);
+    fs.rmSync(dir, { recursive: true, force: true });
+    await asyncSrt.dispose();
+  });
 });
@@ -1,4 +1,4 @@
-const { SRT, AsyncSRT } = require('../index.js');
+const { SRT, AsyncSRT, AsyncSRTTransport } = require('../index.js');
 
 describe("Async SRT API with promises", () => {
   it("can create an SRT socket", done => {
@@ -18,4 +18,32 @@ describe("Async SRT API with promises", () => {
         done();
       }).catch(done.fail);
   });
+
+  [AsyncSRTTransport.NATIVE, AsyncSRTTransport.WORKER, AsyncSRTTransport.SHARED_RING].forEach((transport) => {
+    it(`collects call metrics with the ${transport} transport`, async () => {
+      const asyncSrt = new AsyncSRT({ transport, metrics: true });
+      const socket = await asyncSrt.createSocket(false);
+      await asyncSrt.getSockState(socket);
+      await asyncSrt.getSockState(socket);
+
+      const metrics = asyncSrt.getMetrics();
+      expect(metrics.inFlight).toEqual(0);
+      expect(metrics.peakInFlight).toBeGreaterThan(0);
+      const { calls, errors, roundTrip, queued, native } = metrics.methods.getSockState;
+      expect(calls).toEqual(2);
+      expect(errors).toEqual(0);
+      expect(roundTrip.count).toEqual(2);
+      expect(queued.count).toEqual(2);
+      expect(native.count).toEqual(2);
+      expect(roundTrip.maxUs).toBeGreaterThanOrEqual(native.maxUs);
+
+      asyncSrt.resetMetrics();
+      expect(asyncSrt.getMetrics().methods).toEqual({});
+      asyncSrt.enableMetrics(false);
+      expect(asyncSrt.getMetrics()).toBeNull();
+
+      await asyncSrt.close(socket);
+      await asyncSrt.dispose();
+    });
+  });
 });
@@ -1,4 +1,8 @@
-const { SRT } = require('../index.js');
+const fs = require('fs');
+const os = require('os');
+const path = require('path');
+const { SRT, SRTConnector, SRTFanOut, SRTRelay, SRTSendScheduler, SRTStatsSampler, createMsgCtrl, createStatsRows, decodeStatsRow, STATS_FIELD_INDEX } = require('../index.js');
+const { connectPairs, closePairs, waitReadable, readMessages, waitFor } = require('./support/loopback.js');
 
 describe("SRT library", () => {
   it("exposes constants", () => {
@@ -74,6 +78,438 @@ describe("SRT library", () => {
     expect(events.length).toEqual(0);
   });
 
+  it("can watch an epoll with the native event pump", done => {
+    const srt = new SRT();
+    const server = srt.createSocket();
+    srt.bind(server, "127.0.0.1", 1236);
+    srt.listen(server, 10);
+    const epid = srt.epollCreate();
+    srt.epollAddUsock(epid, server, SRT.EPOLL_IN | SRT.EPOLL_ERR);
+    srt.epollWatch(epid, (events) => {
+      expect(events.length).toEqual(1);
+      expect(events[0].socket).toEqual(server);
+      srt.epollUnwatch(epid);
+      done();
+    });
+    const client = srt.createSocket();
+    srt.connect(client, "127.0.0.1", 1236);
+  });
+
+  it("can read pending messages in batches", async () => {
+    const srt = new SRT();
+    const pairs = connectPairs(srt, 1237);
+    const [{ client, server }] = pairs;
+
+    [1316, 1000, 188].forEach((size, i) => srt.write(client, Buffer.alloc(size, i)));
+
+    const messages = await readMessages(srt, server, 3);
+    expect(messages.map(({ length }) => length)).toEqual([1316, 1000, 188]);
+    expect(messages[1][0]).toEqual(1);
+
+    const empty = srt.readBatch(server, 16, 16 * 1024);
+    expect(empty.buffer.length).toEqual(0);
+    expect(empty.offsets.length).toEqual(1);
+
+    closePairs(srt, pairs);
+  });
+
+  it("can read a message into a given buffer", async () => {
+    const srt = new SRT();
+    const pairs = connectPairs(srt, 1239);
+    const [{ client, server }] = pairs;
+
+    srt.write(client, Buffer.alloc(188, 0x47));
+
+    await waitReadable(srt, server);
+    const buffer = Buffer.alloc(2048);
+    expect(srt.readInto(server, buffer, 100)).toEqual(188);
+    expect(buffer[99]).toEqual(0);
+    expect(buffer[100]).toEqual(0x47);
+    expect(buffer[287]).toEqual(0x47);
+    expect(srt.readInto(server, buffer, 0)).toEqual(SRT.ERROR);
+
+    closePairs(srt, pairs);
+  });
+
+  it("reads MTU-sized messages into pooled buffers", async () => {
+    const srt = new SRT();
+    const pairs = connectPairs(srt, 1240);
+    const [{ client, server }] = pairs;
+
+    srt.write(client, Buffer.alloc(1316, 1));
+    srt.write(client, Buffer.alloc(1316, 2));
+
+    const before = srt.getBufferPoolStats();
+    await waitReadable(srt, server);
+    const pooled = srt.read(server, 1316);
+    await waitReadable(srt, server);
+    const unpooled = srt.read(server, 64 * 1024);
+    const after = srt.getBufferPoolStats();
+
+    expect(pooled[0]).toEqual(1);
+    expect(unpooled.length).toEqual(1316);
+    expect(unpooled[0]).toEqual(2);
+    expect(after.hits - before.hits).toEqual(1);
+    expect(after.misses - before.misses).toEqual(1);
+
+    closePairs(srt, pairs);
+  });
+
+  it("passes message control data along with messages", async () => {
+    const srt = new SRT();
+    const pairs = connectPairs(srt, 1241);
+    const [{ client, server }] = pairs;
+
+    const sendCtrl = createMsgCtrl({ ttl: 1000 });
+    srt.write(client, Buffer.alloc(188), sendCtrl);
+    const msgNo = sendCtrl[SRT.MSGCTRL_NO];
+    srt.write(client, Buffer.alloc(188), sendCtrl);
+    expect(sendCtrl[SRT.MSGCTRL_NO]).toEqual(msgNo + 1);
+
+    const recvCtrl = createMsgCtrl();
+    await waitReadable(srt, server);
+    srt.read(server, 1316, recvCtrl);
+    expect(recvCtrl[SRT.MSGCTRL_NO]).toEqual(msgNo);
+    expect(recvCtrl[SRT.MSGCTRL_SRCTIME]).toBeGreaterThan(0);
+    const seq = recvCtrl[SRT.MSGCTRL_PKTSEQ];
+    await waitReadable(srt, server);
+    srt.read(server, 1316, recvCtrl);
+    expect(recvCtrl[SRT.MSGCTRL_PKTSEQ]).toEqual(seq + 1);
+
+    expect(() => srt.read(server, 1316, new Float64Array(2))).toThrowError(TypeError);
+
+    closePairs(srt, pairs);
+  });
+
+  it("can write a buffer as many messages in one call", async () => {
+    const srt = new SRT();
+    const pairs = connectPairs(srt, 1238);
+    const [{ client, server }] = pairs;
+
+    const sent = srt.writeMany(client, Buffer.alloc(3 * 1316 + 100, 7), 1316);
+    expect(sent).toEqual(3 * 1316 + 100);
+
+    const messages = await readMessages(srt, server, 4);
+    expect(messages.map(({ length }) => length)).toEqual([1316, 1316, 1316, 100]);
+
+    closePairs(srt, pairs);
+  });
+
+  it("can sample stats of many sockets into one array", () => {
+    const srt = new SRT();
+    const pairs = connectPairs(srt, 1242);
+    const [{ client, server }] = pairs;
+    const closed = srt.createSocket();
+    srt.close(closed);
+
+    const rows = createStatsRows(3);
+    expect(srt.statsInto([client, closed, server], rows)).toEqual(2);
+
+    const stats = decodeStatsRow(rows, 2);
+    const objectStats = srt.stats(server, false);
+    expect(Object.keys(stats)).toEqual(Object.keys(objectStats));
+    expect(stats.byteMSS).toEqual(objectStats.byteMSS);
+    expect(stats.msRTT).toEqual(rows[2 * SRT.STATS_FIELD_COUNT + STATS_FIELD_INDEX.msRTT]);
+    expect(decodeStatsRow(rows, 1)).toBeNull();
+
+    closePairs(srt, pairs);
+  });
+
+  it("can sample stats of a socket in the background", async () => {
+    const srt = new SRT();
+    const pairs = connectPairs(srt, 1243);
+    const [{ client }] = pairs;
+
+    const sampler = new SRTStatsSampler(10, 100);
+    sampler.add(client);
+    expect(sampler.query(client, SRTStatsSampler.METRIC_RTT)).toBeNull();
+
+    await waitFor(() => {
+      const sampled = sampler.query(client, SRTStatsSampler.METRIC_RTT);
+      return sampled !== null && sampled.count > 1;
+    });
+    const rtt = sampler.query(client, SRTStatsSampler.METRIC_RTT);
+    expect(rtt.min).toBeLessThanOrEqual(rtt.p50);
+    expect(rtt.p50).toBeLessThanOrEqual(rtt.p99);
+    expect(rtt.p99).toBeLessThanOrEqual(rtt.max);
+    expect(sampler.query(client, SRTStatsSampler.METRIC_SEND_RATE, 1).count).toEqual(1);
+
+    sampler.remove(client);
+    expect(sampler.query(client, SRTStatsSampler.METRIC_RTT)).toBeNull();
+    sampler.stop();
+    closePairs(srt, pairs);
+  });
+
+  it("can wait on an epoll into an Int32Array", () => {
+    const srt = new SRT();
+    const server = srt.createSocket();
+    srt.bind(server, "127.0.0.1", 1244);
+    srt.listen(server, 10);
+    const epid = srt.epollCreate();
+    srt.epollAddUsock(epid, server, SRT.EPOLL_IN | SRT.EPOLL_ERR);
+
+    const client = srt.createSocket(true);
+    srt.connect(client, "127.0.0.1", 1244);
+
+    const events = new Int32Array(2 * 4);
+    expect(srt.epollUWaitInto(epid, 1000, events)).toEqual(1);
+    expect(events[0]).toEqual(server);
+    expect(events[1] & SRT.EPOLL_IN).toEqual(SRT.EPOLL_IN);
+
+    const fd = srt.accept(server);
+    srt.epollRemoveUsock(epid, server);
+    expect(srt.epollUWaitInto(epid, 10, events)).toEqual(0);
+    expect(() => srt.epollUWaitInto(epid, 10, new Float64Array(2))).toThrow();
+
+    expect(srt.epollSet(epid, SRT.EPOLL_ENABLE_EMPTY)).toEqual(SRT.EPOLL_ENABLE_EMPTY);
+    expect(srt.epollRelease(epid)).toEqual(SRT.OK);
+    srt.close(client);
+    srt.close(fd);
+  });
+
+  it("can relay messages between sockets natively", async () => {
+    const srt = new SRT();
+    const ingest = connectPairs(srt, 1245);
+    const egress = connectPairs(srt, 1246);
+    const [{ client: contributor, server: source }] = ingest;
+    const [{ client: destination, server: viewer }] = egress;
+
+    const relay = new SRTRelay();
+    relay.addRoute(source, [destination]);
+    srt.write(contributor, Buffer.alloc(1316, 1));
+    srt.write(contributor, Buffer.alloc(100, 2));
+
+    const messages = await readMessages(srt, viewer, 2);
+    expect(messages.map(({ length }) => length)).toEqual([1316, 100]);
+
+    const stats = relay.getRouteStats(source);
+    expect(stats.packets).toEqual(2);
+    expect(stats.bytes).toEqual(1416);
+    expect(stats.broken).toBeFalse();
+    expect(stats.destinations).toEqual([{ socket: destination, packets: 2, bytes: 1416, drops: 0 }]);
+
+    relay.removeRoute(source);
+    expect(relay.getRouteStats(source)).toBeNull();
+    relay.stop();
+    closePairs(srt, ingest);
+    closePairs(srt, egress);
+  });
+
+  it("leaves the destinations of a route that can't be made as they were", () => {
+    const srt = new SRT();
+    const source = srt.createSocket();
+    srt.close(source);
+    const destination = srt.createSocket(true);
+
+    const relay = new SRTRelay();
+    expect(() => relay.addRoute(source, [destination])).toThrow();
+    expect(srt.getSockOpt(destination, SRT.SRTO_SNDSYN)).toEqual(true);
+    expect(relay.getRouteStats(source)).toBeNull();
+
+    relay.stop();
+    srt.close(destination);
+  });
+
+  it("can fan out messages to many subscribers", async () => {
+    const srt = new SRT();
+    const ingest = connectPairs(srt, 1247);
+    const egress = connectPairs(srt, 1248, 3);
+    const [{ client: contributor, server: source }] = ingest;
+    const subscribers = egress.map(({ client }) => client);
+
+    const fanOut = new SRTFanOut(source, 64);
+    subscribers.forEach((subscriber) => fanOut.addSubscriber(subscriber));
+    expect(() => fanOut.addSubscriber(subscribers[0], 42)).toThrowError(TypeError);
+    srt.write(contributor, Buffer.alloc(1316, 1));
+    srt.write(contributor, Buffer.alloc(188, 2));
+
+    for (const { server: viewer } of egress) {
+      const messages = await readMessages(srt, viewer, 2);
+      expect(messages.map(({ length }) => length)).toEqual([1316, 188]);
+    }
+
+    const stats = fanOut.getStats();
+    expect(stats.packets).toEqual(2);
+    expect(stats.bytes).toEqual(1504);
+    stats.subscribers.forEach((subscriber) => {
+      expect(subscriber.packets).toEqual(2);
+      expect(subscriber.lag).toEqual(0);
+      expect(subscriber.drops).toEqual(0);
+    });
+
+    fanOut.removeSubscriber(subscribers[0]);
+    expect(fanOut.getStats().subscribers.length).toEqual(2);
+    fanOut.stop();
+    closePairs(srt, ingest);
+    closePairs(srt, egress);
+  });
+
+  it("paces queued messages at the configured bitrate", async () => {
+    const srt = new SRT();
+    const pairs = connectPairs(srt, 1249);
+    const [{ client }] = pairs;
+
+    const scheduler = new SRTSendScheduler();
+    expect(scheduler.enqueue(client, Buffer.alloc(1316))).toEqual(0);
+    // 1316 bytes every 10 ms, the bucket holds one message
+    const messages = 20;
+    const intervalMs = 10;
+    scheduler.configure(client, 1316 * 8 * (1000 / intervalMs), 1316);
+    const start = Date.now();
+    expect(scheduler.enqueue(client, Buffer.alloc(messages * 1316))).toEqual(messages * 1316);
+    expect(scheduler.getMetrics(client).sentMessages).toBeLessThan(messages);
+
+    // reported by the scheduler thread once the last message was sent
+    await scheduler.whenQueueBelow(client, 0);
+    const elapsedMs = Date.now() - start;
+    expect(scheduler.getMetrics(client).queuedMessages).toEqual(0);
+    // the first message goes out with the full bucket, each other one waits for its tokens
+    const pacedMs = (messages - 1) * intervalMs;
+    expect(elapsedMs).toBeGreaterThanOrEqual(pacedMs * 0.9);
+    expect(elapsedMs).toBeLessThan(pacedMs * 3);
+
+    const metrics = scheduler.getMetrics(client);
+    expect(metrics.sentMessages).toEqual(messages);
+    expect(metrics.broken).toBeFalse();
+
+    scheduler.stop();
+    closePairs(srt, pairs);
+  });
+
+  it("can send over a broadcast group of two links", async () => {
+    const srt = new SRT();
+    let group;
+    try {
+      group = srt.createGroup(SRT.SRT_GTYPE_BROADCAST);
+    } catch (err) {
+      if (/not supported/i.test(err.message)) {
+        pending(`libsrt is built without bonding (ENABLE_BONDING): ${err.message}`);
+      }
+      throw err;
+    }
+
+    const server = srt.createSocket();
+    srt.setSockOpt(server, SRT.SRTO_GROUPCONNECT, 1);
+    srt.bind(server, "127.0.0.1", 1253);
+    srt.listen(server, 10);
+
+    const member = srt.connectGroup(group, [
+      { host: "127.0.0.1", port: 1253 },
+      { host: "127.0.0.1", port: 1253 }
+    ]);
+    expect(member).not.toEqual(SRT.ERROR);
+    // the listener side gets a group too
+    const fd = srt.accept(server);
+    srt.setSockOpt(fd, SRT.SRTO_RCVSYN, false);
+
+    const members = srt.groupData(group);
+    expect(members.length).toEqual(2);
+    expect(members.map(({ port }) => port)).toEqual([1253, 1253]);
+    expect(members.map(({ socket }) => socket)).toContain(member);
+
+    srt.write(group, Buffer.alloc(1316, 1));
+
+    // the copies of both links arrive as one message
+    const messages = await readMessages(srt, fd, 1);
+    expect(messages.map(({ length }) => length)).toEqual([1316]);
+    expect(srt.readBatch(fd, 16, 16 * 1024).offsets.length).toEqual(1);
+
+    srt.close(group);
+    srt.close(fd);
+  });
+
+  it("accepts pending connections filtered by stream id, keeping the listener", () => {
+    const srt = new SRT();
+    const server = srt.createSocket();
+    srt.bind(server, "127.0.0.1", 1254);
+    srt.setStreamIdFilter(server, ["live/*"], ["live/blocked"]);
+    srt.listen(server, 10);
+
+    const connectWithStreamId = (streamId) => {
+      const client = srt.createSocket(true);
+      srt.setSockOpt(client, SRT.SRTO_STREAMID, streamId);
+      srt.connect(client, "127.0.0.1", 1254);
+      return client;
+    };
+    const clients = [connectWithStreamId("live/a"), connectWithStreamId("live/b")];
+    expect(() => connectWithStreamId("live/blocked")).toThrow();
+    expect(() => connectWithStreamId("vod/a")).toThrow();
+
+    const accepted = srt.acceptMany(server, 16, { [SRT.SRTO_RCVSYN]: false });
+    expect(accepted.length).toEqual(2);
+    expect(accepted.map(({ host }) => host)).toEqual(["127.0.0.1", "127.0.0.1"]);
+    expect(srt.getSockOpt(accepted[0].socket, SRT.SRTO_RCVSYN)).toEqual(false);
+    expect(srt.getSockState(server)).toEqual(SRT.SRTS_LISTENING);
+    expect(srt.getStreamIdFilterStats(server)).toEqual({ accepted: 2, rejected: 2 });
+
+    clients.forEach((client) => srt.close(client));
+    accepted.forEach(({ socket }) => srt.close(socket));
+    srt.close(server);
+    expect(srt.getStreamIdFilterStats(server)).toBeNull();
+  });
+
+  it("hands pre-connect accept options over from the listener", () => {
+    const srt = new SRT();
+    const server = srt.createSocket();
+    const options = { [SRT.SRTO_LATENCY]: 250, [SRT.SRTO_RCVSYN]: false };
+    expect(srt.acceptMany(server, 0, options)).toEqual([]);
+    expect(srt.getSockOpt(server, SRT.SRTO_LATENCY)).toEqual(250);
+    // only set on the accepted sockets
+    expect(srt.getSockOpt(server, SRT.SRTO_RCVSYN)).toEqual(true);
+    srt.bind(server, "127.0.0.1", 1260);
+    srt.listen(server, 10);
+
+    const client = srt.createSocket();
+    srt.connect(client, "127.0.0.1", 1260);
+    const accepted = srt.acceptMany(server, 16, options);
+    expect(accepted.length).toEqual(1);
+    expect(srt.getSockOpt(accepted[0].socket, SRT.SRTO_LATENCY)).toEqual(250);
+    expect(srt.getSockOpt(accepted[0].socket, SRT.SRTO_RCVSYN)).toEqual(false);
+
+    // a pre-bind option can't be changed on the bound listener
+    expect(() => srt.acceptMany(server, 16, { [SRT.SRTO_MSS]: 1000 })).toThrow();
+
+    srt.close(client);
+    srt.close(accepted[0].socket);
+    srt.close(server);
+  });
+
+  it("connects many sockets concurrently without blocking", async () => {
+    const srt = new SRT();
+    const server = srt.createSocket();
+    srt.bind(server, "127.0.0.1", 1255);
+    srt.listen(server, 10);
+
+    const connector = new SRTConnector();
+    const timeout = { [SRT.SRTO_CONNTIMEO]: 500 };
+    const connects = [1, 2, 3].map(() => connector.connect("127.0.0.1", 1255, timeout));
+    const unreachable = connector.connect("127.0.0.1", 1256, timeout);
+    // started, not yet connected
+    expect(connector.pending).toEqual(4);
+
+    const sockets = await Promise.all(connects);
+    sockets.forEach((socket) => expect(srt.getSockState(socket)).toEqual(SRT.SRTS_CONNECTED));
+    await expectAsync(unreachable).toBeRejected();
+    await expectAsync(connector.connect("not an address", 1255)).toBeRejected();
+    expect(connector.pending).toEqual(0);
+
+    expect(srt.acceptMany(server, 16).length).toEqual(3);
+    sockets.forEach((socket) => srt.close(socket));
+    srt.close(server);
+    connector.dispose();
+  });
+
+  it("reports the file error when a received range can't be seeked to", () => {
+    const srt = new SRT();
+    const socket = srt.createSocket();
+    const file = path.join(os.tmpdir(), `srt-recv-file-${process.pid}`);
+
+    expect(() => srt.recvFile(socket, file, -1, 188)).toThrowError(/^Can't write /);
+
+    srt.close(socket);
+    fs.unlinkSync(file);
+  });
+
   it("exposes socket options", () => {
     expect(SRT.SRTO_UDP_SNDBUF).toEqual(8);
     expect(SRT.SRTO_RCVLATENCY).toEqual(43);
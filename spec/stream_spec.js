@@ -1,9 +1,65 @@
 const fs = require('fs');
 const dest = fs.createWriteStream('/dev/null');
-const { SRTReadStream } = require('../index.js');
+const { SRT, SRTReadStream, SRTWriteStream } = require('../index.js');
 
 describe("SRTReadStream", () => {
   it('can be constructed without throwing an exception', () => {
     new SRTReadStream();
   })
+
+  it('keeps accepting connections in listener mode', (done) => {
+    const reader = new SRTReadStream('127.0.0.1', 1257, { highWaterMark: 64 * 1024 });
+    expect(reader.readableHighWaterMark).toEqual(64 * 1024);
+
+    const srt = new SRT();
+    const clients = [srt.createSocket(), srt.createSocket()];
+    const received = [];
+    const onData = (stream) => {
+      stream.once('data', (chunk) => {
+        received.push(chunk.toString());
+        if (received.length === 2) {
+          expect(received.sort()).toEqual(['first', 'second']);
+          clients.forEach((client) => srt.close(client));
+          reader.close();
+          done();
+        }
+      });
+    };
+    reader.on('connection', onData);
+    reader.listen(onData);
+
+    clients.forEach((client, i) => {
+      srt.connect(client, '127.0.0.1', 1257);
+      srt.write(client, Buffer.from(i === 0 ? 'first' : 'second'));
+    });
+  });
+});
+
+describe("SRTWriteStream", () => {
+  it('repacks written chunks into payload-sized messages', (done) => {
+    const chunks = [Buffer.alloc(3000, 1), Buffer.alloc(100, 2), Buffer.alloc(1316, 3)];
+    const expected = Buffer.concat(chunks);
+    const received = [];
+
+    const reader = new SRTReadStream('127.0.0.1', 1258);
+    reader.listen((readStream) => {
+      readStream.on('data', (chunk) => {
+        received.push(chunk);
+        const data = Buffer.concat(received);
+        if (data.length === expected.length) {
+          expect(data.equals(expected)).toBe(true);
+          writer.close();
+          reader.close();
+          done();
+        }
+      });
+    });
+
+    const writer = new SRTWriteStream('127.0.0.1', 1258, { payloadSize: 1316 });
+    writer.connect((writeStream) => {
+      writeStream.cork();
+      chunks.forEach((chunk) => writeStream.write(chunk));
+      writeStream.uncork();
+    });
+  });
 });
@@ -0,0 +1,130 @@
+const { SRT } = require('../../index.js');
+
+const HOST = "127.0.0.1";
+// a deadline only, the helpers settle as soon as the socket is ready
+const WAIT_TIMEOUT_MS = 2000;
+const POLL_INTERVAL_MS = 5;
+
+/**
+ * Connects `count` callers to one listener on the loopback.
+ * `connect` and `accept` block until the handshake is done, so both ends
+ * of each pair are connected on return. Accepted sockets are non-blocking.
+ *
+ * @param {SRT} srt
+ * @param {number} port
+ * @param {number} count
+ * @returns {{listener: number, client: number, server: number}[]}
+ */
+function connectPairs(srt, port, count = 1) {
+  const listener = srt.createSocket();
+  srt.bind(listener, HOST, port);
+  srt.listen(listener, 10);
+
+  const pairs = [];
+  for (let i = 0; i < count; i++) {
+    const client = srt.createSocket(true);
+    srt.connect(client, HOST, port);
+    const server = srt.accept(listener);
+    srt.setSockOpt(server, SRT.SRTO_RCVSYN, false);
+    pairs.push({ listener, client, server });
+  }
+  return pairs;
+}
+
+/**
+ * @param {SRT} srt
+ * @param {{listener: number, client: number, server: number}[]} pairs
+ */
+function closePairs(srt, pairs) {
+  pairs.forEach(({ client, server }) => {
+    srt.close(client);
+    srt.close(server);
+  });
+  srt.close(pairs[0].listener);
+}
+
+/**
+ * Resolves once `socket` has data to read (or failed), as reported
+ * by the native epoll pump. Rejects if it hasn't after `timeoutMs`.
+ *
+ * @param {SRT} srt
+ * @param {number} socket
+ * @param {number} timeoutMs
+ * @returns {Promise<void>}
+ */
+function waitReadable(srt, socket, timeoutMs = WAIT_TIMEOUT_MS) {
+  return new Promise((resolve, reject) => {
+    const epid = srt.epollCreate();
+    let settled = false;
+    const settle = (err) => {
+      if (settled) {
+        return;
+      }
+      settled = true;
+      clearTimeout(timer);
+      srt.epollRelease(epid);
+      err ? reject(err) : resolve();
+    };
+    const timer = setTimeout(() => {
+      settle(new Error(`Socket ${socket} not readable after ${timeoutMs} ms`));
+    }, timeoutMs);
+
+    srt.epollAddUsock(epid, socket, SRT.EPOLL_IN | SRT.EPOLL_ERR);
+    srt.epollWatch(epid, (events, err) => settle(err ? new Error(err) : null));
+  });
+}
+
+/**
+ * Reads `count` messages from the non-blocking `socket`, in as many batches
+ * as they become readable in.
+ *
+ * @param {SRT} srt
+ * @param {number} socket
+ * @param {number} count
+ * @param {number} timeoutMs
+ * @returns {Promise<Buffer[]>}
+ */
+async function readMessages(srt, socket, count, timeoutMs = WAIT_TIMEOUT_MS) {
+  const deadline = Date.now() + timeoutMs;
+  const messages = [];
+  while (messages.length < count) {
+    await waitReadable(srt, socket, Math.max(deadline - Date.now(), 0));
+    const { buffer, offsets } = srt.readBatch(socket, 16, 16 * 1024);
+    for (let i = 1; i < offsets.length; i++) {
+      messages.push(buffer.subarray(offsets[i - 1], offsets[i]));
+    }
+  }
+  return messages;
+}
+
+/**
+ * Resolves once `check` returns true, polled every few ms.
+ * Rejects if it hasn't after `timeoutMs`.
+ *
+ * @param {Function} check
+ * @param {number} timeoutMs
+ * @returns {Promise<void>}
+ */
+function waitFor(check, timeoutMs = WAIT_TIMEOUT_MS) {
+  const deadline = Date.now() + timeoutMs;
+  return new Promise((resolve, reject) => {
+    const poll = () => {
+      if (check()) {
+        resolve();
+      } else if (Date.now() >= deadline) {
+        reject(new Error(`Condition not met after ${timeoutMs} ms`));
+      } else {
+        setTimeout(poll, POLL_INTERVAL_MS);
+      }
+    };
+    poll();
+  });
+}
+
+module.exports = {
+  connectPairs,
+  closePairs,
+  waitReadable,
+  readMessages,
+  waitFor
+};
@@ -11,3 +11,9 @@ export enum SRTConnectionEvent {
   CLOSED = "closed"
 }
 
+
+export enum AsyncSRTTransport {
+  NATIVE = "native",
+  WORKER = "worker",
+  SHARED_RING = "shared-ring"
+}
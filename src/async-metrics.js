@@ -0,0 +1,195 @@
+const { performance } = require('perf_hooks');
+
+// buckets per power of two, so a bucket is at most 1/8 wider than its lower bound
+const SUB_BUCKETS = 8;
+// up to 2^32 us (more than an hour)
+const OCTAVES = 32;
+const BUCKET_COUNT = 1 + OCTAVES * SUB_BUCKETS;
+
+/**
+ * Log-linear histogram of durations in microseconds with a fixed number of buckets,
+ * so recording is a few arithmetic operations and no allocation.
+ * Percentiles are reported as the upper bound of their bucket.
+ */
+class LatencyHistogram {
+  constructor() {
+    this._counts = new Float64Array(BUCKET_COUNT);
+    this.reset();
+  }
+
+  reset() {
+    this._counts.fill(0);
+    this.count = 0;
+    this._sumUs = 0;
+    this._minUs = Infinity;
+    this._maxUs = 0;
+  }
+
+  /**
+   * @param {number} us
+   */
+  record(us) {
+    this._counts[bucketIndex(us)]++;
+    this.count++;
+    this._sumUs += us;
+    if (us < this._minUs) this._minUs = us;
+    if (us > this._maxUs) this._maxUs = us;
+  }
+
+  /**
+   * @param {number} p 0..1
+   * @returns {number}
+   */
+  percentile(p) {
+    const rank = Math.ceil(p * this.count);
+    let seen = 0;
+    for (let i = 0; i < BUCKET_COUNT; i++) {
+      seen += this._counts[i];
+      if (seen >= rank && this._counts[i] > 0) {
+        return Math.min(bucketUpperBound(i), this._maxUs);
+      }
+    }
+    return this._maxUs;
+  }
+
+  /**
+   * @returns {AsyncSRTLatencySummary}
+   */
+  summary() {
+    if (this.count === 0) {
+      return { count: 0, meanUs: null, minUs: null, maxUs: null, p50Us: null, p90Us: null, p99Us: null };
+    }
+    return {
+      count: this.count,
+      meanUs: round(this._sumUs / this.count),
+      minUs: round(this._minUs),
+      maxUs: round(this._maxUs),
+      p50Us: round(this.percentile(0.5)),
+      p90Us: round(this.percentile(0.9)),
+      p99Us: round(this.percentile(0.99))
+    };
+  }
+}
+
+function bucketIndex(us) {
+  if (!(us >= 1)) {
+    return 0;
+  }
+  const octave = Math.min(OCTAVES - 1, Math.floor(Math.log2(us)));
+  const base = Math.pow(2, octave);
+  const sub = Math.min(SUB_BUCKETS - 1, Math.floor((us - base) / base * SUB_BUCKETS));
+  return 1 + octave * SUB_BUCKETS + sub;
+}
+
+function bucketUpperBound(index) {
+  if (index === 0) {
+    return 1;
+  }
+  const octave = Math.floor((index - 1) / SUB_BUCKETS);
+  const sub = (index - 1) % SUB_BUCKETS;
+  return Math.pow(2, octave) * (1 + (sub + 1) / SUB_BUCKETS);
+}
+
+function round(us) {
+  return Math.round(us * 10) / 10;
+}
+
+/**
+ * @private
+ */
+class MethodMetrics {
+  constructor() {
+    this.calls = 0;
+    this.errors = 0;
+    this.roundTrip = new LatencyHistogram();
+    this.queued = new LatencyHistogram();
+    this.native = new LatencyHistogram();
+  }
+
+  snapshot() {
+    return {
+      calls: this.calls,
+      errors: this.errors,
+      roundTrip: this.roundTrip.summary(),
+      queued: this.queued.summary(),
+      native: this.native.summary()
+    };
+  }
+}
+
+/**
+ * Per-method call counts and latency histograms of an `AsyncSRT`,
+ * and the number of calls in flight (current and peak).
+ *
+ * The round trip is measured from the call to the settled result.
+ * `queued` (waiting for a native thread or the worker) and `native`
+ * (the binding call itself) are measured on the executing side.
+ */
+class AsyncSRTMetrics {
+  constructor() {
+    this._methods = new Map();
+    this.inFlight = 0;
+    this.reset();
+  }
+
+  reset() {
+    this._methods.clear();
+    this.peakInFlight = this.inFlight;
+    this._sinceMs = performance.now();
+  }
+
+  /**
+   * @returns {number} start time, pass it to `callEnded`
+   */
+  callStarted() {
+    if (++this.inFlight > this.peakInFlight) {
+      this.peakInFlight = this.inFlight;
+    }
+    return performance.now();
+  }
+
+  /**
+   * @param {string} method
+   * @param {number} startMs returned by `callStarted`
+   * @param {boolean} failed
+   * @param {number[] | null} timing [queuedUs, nativeUs] if known
+   */
+  callEnded(method, startMs, failed, timing) {
+    this.inFlight--;
+    let metrics = this._methods.get(method);
+    if (!metrics) {
+      metrics = new MethodMetrics();
+      this._methods.set(method, metrics);
+    }
+    metrics.calls++;
+    if (failed) {
+      metrics.errors++;
+    }
+    metrics.roundTrip.record((performance.now() - startMs) * 1000);
+    if (timing) {
+      metrics.queued.record(timing[0]);
+      metrics.native.record(timing[1]);
+    }
+  }
+
+  /**
+   * @returns {AsyncSRTMetricsSnapshot}
+   */
+  snapshot() {
+    const methods = {};
+    this._methods.forEach((metrics, method) => {
+      methods[method] = metrics.snapshot();
+    });
+    return {
+      periodMs: Math.round(performance.now() - this._sinceMs),
+      inFlight: this.inFlight,
+      peakInFlight: this.peakInFlight,
+      methods
+    };
+  }
+}
+
+module.exports = {
+  AsyncSRTMetrics,
+  LatencyHistogram
+};
@@ -1,9 +1,23 @@
+const { SRT } = require('../build/Release/node_srt.node');
+const { waitForSocket } = require('./srt-socket-waiter');
+
 const READ_BUF_SIZE = 16 * 1024;
+const READ_BATCH_MAX_MESSAGES = 256;
+// SRT_LIVE_MAX_PLSIZE
+const SRT_LIVE_MAX_PAYLOAD = 1456;
+// the binding allocates the bytes asked for up front, so one call never asks for more than it can fill
+const READ_BATCH_MAX_BYTES = READ_BATCH_MAX_MESSAGES * SRT_LIVE_MAX_PAYLOAD;
 
 /**
  * Will read at least max number of bytes from SRT socket in async loop.
  *
- * Returns Promise of array of buffers.
+ * Every call to the binding drains all messages pending on the socket
+ * (see `AsyncSRT#readBatch`), `readBufSize` bounds the bytes of one such call
+ * (up to READ_BATCH_MAX_BYTES when more are still to read).
+ * On a non-blocking socket with nothing pending, it waits for `EPOLL_IN`.
+ *
+ * Returns Promise of array of buffers (one per SRT message).
+ * Stops early when the socket read fails.
  *
  * @param {AsyncSRT} asyncSrt
  * @param {number} socketFd
@@ -17,18 +31,28 @@ async function readChunks(asyncSrt, socketFd, minBytesRead, readBufSize = READ_B
   let bytesRead = 0;
   const chunks = [];
   while (bytesRead < minBytesRead) {
-    const readReturn = await asyncSrt.read(socketFd, readBufSize);
-    if (readReturn instanceof Uint8Array) {
-      const readBuf = readReturn;
-      bytesRead += readBuf.byteLength;
-      if (onRead) {
-        onRead(readBuf);
-      }
-      chunks.push(readBuf);
-    } else if (result === SRT.ERROR || result === null) {
+    const result = await asyncSrt.readBatch(socketFd, READ_BATCH_MAX_MESSAGES,
+      Math.max(readBufSize, Math.min(minBytesRead - bytesRead, READ_BATCH_MAX_BYTES)));
+    if (result === SRT.ERROR || result === null) {
       if (onError) {
         onError(result);
       }
+      break;
+    } else if (result.buffer instanceof Uint8Array) {
+      const { buffer, offsets } = result;
+      if (offsets.length === 1) {
+        // non-blocking socket with nothing pending yet
+        await waitForSocket(socketFd, SRT.EPOLL_IN);
+        continue;
+      }
+      for (let i = 0; i < offsets.length - 1; i++) {
+        const readBuf = buffer.subarray(offsets[i], offsets[i + 1]);
+        if (onRead) {
+          onRead(readBuf);
+        }
+        chunks.push(readBuf);
+      }
+      bytesRead += buffer.byteLength;
     } else {
       throw new Error('Got unexpected read-result')
     }
@@ -38,5 +62,7 @@ async function readChunks(asyncSrt, socketFd, minBytesRead, readBufSize = READ_B
 
 module.exports = {
   READ_BUF_SIZE,
+  READ_BATCH_MAX_MESSAGES,
+  READ_BATCH_MAX_BYTES,
   readChunks
 }
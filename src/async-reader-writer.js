@@ -1,7 +1,8 @@
 const EventEmitter = require("events");
+const { SRT } = require('../build/Release/node_srt.node');
 
 const {
-  writeChunksWithYieldingLoop
+  writeBufferWithScatterSend
 } = require('../src/async-write-modes');
 
 const {
@@ -10,8 +11,9 @@ const {
 } = require('../src/async-read-modes');
 
 const DEFAULT_MTU_SIZE = 1316; // (for writes) should be the maximum on all IP networks cases
-const DEFAULT_WRITES_PER_TICK = 128; // tbi
+const DEFAULT_WRITES_PER_TICK = 128; // messages per native write call
 const DEFAULT_READ_BUFFER = READ_BUF_SIZE; // typical stream buffer size read in Node-JS internals
+const DEFAULT_TS_BYTES_PER_CALL = 128 * DEFAULT_MTU_SIZE; // TS bytes per native write call
 
 class AsyncReaderWriter {
 
@@ -21,11 +23,12 @@ class AsyncReaderWriter {
   }
 
   /**
+   * Sends the buffer as messages of `mtuSize` bytes, slicing it natively.
    *
    * @param {Uint8Array | Buffer} buffer
-   * @param {number} writesPerTick
+   * @param {number} writesPerTick messages sent per binding call
    * @param {number} mtuSize
-   * @param {Function} onWrite
+   * @param {Function} onWrite Called with the bytes sent and the index of the first message of each binding call
    * @returns {Promise<void>}
    */
   async writeChunks(buffer,
@@ -33,11 +36,40 @@ class AsyncReaderWriter {
     mtuSize = DEFAULT_MTU_SIZE,
     onWrite = null) {
 
-    const chunks = sliceBufferToChunks(buffer, mtuSize,
-      buffer.byteLength, 0);
+    return writeBufferWithScatterSend(this._asyncSrt, this._fd, buffer,
+      mtuSize, onWrite, writesPerTick);
+  }
+
+  /**
+   * Sends an MPEG-TS buffer as messages of 7 whole TS packets, cut natively
+   * (see `AsyncSRT#writeTs`), optionally paced in real time from the PCR.
+   *
+   * The buffer is handed over in slices of `bytesPerCall` bytes, so a paced
+   * write only holds the pacing thread of the socket for the play time of one slice at once.
+   *
+   * @param {Uint8Array | Buffer} buffer
+   * @param {boolean} pace
+   * @param {number} bytesPerCall
+   * @param {Function} onWrite Called with the bytes sent by each native call
+   * @returns {Promise<void>}
+   */
+  async writeTsChunks(buffer, pace = false,
+    bytesPerCall = DEFAULT_TS_BYTES_PER_CALL,
+    onWrite = null) {
 
-    return writeChunksWithYieldingLoop(this._asyncSrt, this._fd, chunks,
-      onWrite, writesPerTick);
+    let offset = 0;
+    do {
+      const end = Math.min(buffer.byteLength, offset + bytesPerCall);
+      const written = await this._asyncSrt.writeTs(this._fd, buffer.subarray(offset, end),
+        pace, end === buffer.byteLength);
+      if (written === SRT.ERROR) {
+        throw new Error('AsyncSRT.writeTs() failed');
+      }
+      if (onWrite) {
+        onWrite(written);
+      }
+      offset = end;
+    } while (offset < buffer.byteLength);
   }
 
   /**
@@ -66,5 +98,6 @@ module.exports = {
   AsyncReaderWriter,
   DEFAULT_MTU_SIZE,
   DEFAULT_WRITES_PER_TICK,
-  DEFAULT_READ_BUFFER
+  DEFAULT_READ_BUFFER,
+  DEFAULT_TS_BYTES_PER_CALL
 }
@@ -0,0 +1,91 @@
+const {
+  isMainThread, workerData
+} = require('worker_threads');
+
+const { performance } = require('perf_hooks');
+const debug = require('debug')('srt-async-shared-worker');
+
+const { SRT } = require('../build/Release/node_srt.node');
+
+const { argsToString, traceCallToString } = require('./async-helpers');
+const { SPSCRing, STOP_METHOD, encodedSize, writeValue, readValue } = require('./shared-ring');
+
+const DEBUG = false;
+
+// upper bound of a blocking wait, so a lost wake-up can't stall the ring for long
+const WAIT_TIMEOUT_MS = 100;
+
+if (isMainThread) {
+  throw new Error("Worker module can not load on main thread");
+}
+
+try {
+  run()
+} catch(err) {
+  console.error('AsyncSRT shared-ring task-runner internal exception:', err);
+}
+
+/**
+ * Takes [method, args, timestamp] calls from the `calls` ring, runs them on the sync binding in order
+ * and answers each with [method, errorMessage, result, timestamp, callStart, callEnd] on the `results` ring.
+ */
+function run() {
+
+  DEBUG && debug('AsyncSRT: Launching shared-ring task-runner');
+
+  const srtNapiObjw = new SRT();
+  const calls = new SPSCRing(workerData.calls);
+  const results = new SPSCRing(workerData.results);
+
+  for (;;) {
+    const sequence = calls.dataSequence();
+    let call;
+    while ((call = readValue(calls)) !== undefined) {
+      const [method, args, timestamp] = call;
+      if (method === STOP_METHOD) {
+        DEBUG && debug('AsyncSRT: Closing shared-ring task-runner');
+        return;
+      }
+      reply(results, execute(srtNapiObjw, method, args, timestamp));
+      results.publish();
+    }
+    calls.waitForData(sequence, WAIT_TIMEOUT_MS);
+  }
+}
+
+function execute(srtNapiObjw, method, args, timestamp) {
+  if (args.some((arg) => arg === undefined)) {
+    return [method, `Ignoring call: Can't have any arguments be undefined: ${argsToString(args)}`,
+      null, timestamp, 0, 0];
+  }
+
+  DEBUG && debug('Received call:', traceCallToString(method, args));
+
+  // wall-clock times, comparable with the ones of the main thread (see AsyncSRT metrics)
+  const callStart = performance.timeOrigin + performance.now();
+  let result;
+  try {
+    result = srtNapiObjw[method].apply(srtNapiObjw, args);
+  } catch(err) {
+    console.error(
+      `Exception thrown by native binding call "${traceCallToString(method, args)}":`, err);
+    return [method, err.message, null, timestamp, 0, 0];
+  }
+  const callEnd = performance.timeOrigin + performance.now();
+  return [method, null, result, timestamp, callStart, callEnd];
+}
+
+function reply(results, answer) {
+  let size = encodedSize(answer);
+  if (size > results.maxRecordBytes) {
+    answer = [answer[0], `Result of ${size} bytes does not fit the shared ring`, null, answer[3], 0, 0];
+    size = encodedSize(answer);
+  }
+  for (;;) {
+    const sequence = results.spaceSequence();
+    if (writeValue(results, answer, size)) return;
+    // let the main thread see what is there already before waiting for it to make room
+    results.publish();
+    results.waitForSpace(sequence, WAIT_TIMEOUT_MS);
+  }
+}
@@ -2,6 +2,7 @@ const {
   isMainThread, parentPort
 } = require('worker_threads');
 
+const { performance } = require('perf_hooks');
 const debug = require('debug')('srt-async-worker');
 
 const { SRT } = require('../build/Release/node_srt.node');
@@ -54,6 +55,8 @@ function run() {
 
     DEBUG && debug('Received call:', traceCallToString(data.method, data.args));
 
+    // wall-clock times, comparable with the ones of the main thread (see AsyncSRT metrics)
+    const callStart = performance.timeOrigin + performance.now();
     let result = 0;
     if (!DRY_RUN) {
       try {
@@ -67,11 +70,15 @@ function run() {
       }
     }
 
+    const callEnd = performance.timeOrigin + performance.now();
+
     const transferList = extractTransferListFromParams([result]);
 
     parentPort.postMessage({
       // workId: data.workId,
       timestamp: data.timestamp,
+      callStart,
+      callEnd,
       result
     }, transferList);
 
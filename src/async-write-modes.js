@@ -1,4 +1,5 @@
 const { SRT } = require('../build/Release/node_srt.node');
+const { waitForSocket } = require('./srt-socket-waiter');
 
 /**
  * @module async-write-modes
@@ -138,6 +139,10 @@ async function writeChunksWithYieldingLoop(asyncSrt, socketFd, chunks,
  *
  * TODO: Implement rescheduling based on write-resolution (optional).
  *
+ * For MPEG-TS played out in real time, prefer `AsyncReaderWriter#writeTsChunks`
+ * with `pace` set, which sends every message natively when its PCR says it is due.
+ * To send at a given bitrate, prefer `writeBufferWithSendScheduler`.
+ *
  * The clear advantage of this is the explict nature of scheduling,
  * allow pace of calls to be throttled by the set interval value.
  * This can be very useful when we can afford to write data not asap,
@@ -198,7 +203,92 @@ function writeChunksWithExplicitScheduling(asyncSrt, socketFd, chunks,
 
 }
 
+/**
+ * Writes a whole buffer with as few binding calls as possible,
+ * each one sending up to `messagesPerCall` messages of `payloadSize` bytes
+ * (see `AsyncSRT#writeMany`).
+ *
+ * When the send buffer of a non-blocking socket is full, the rest is sent once
+ * the socket reports `EPOLL_OUT` again.
+ *
+ * With the `worker` transport, every call posts a copy of the remaining data
+ * (the posted buffer gets neutered), so the source buffer stays usable.
+ *
+ * @param {AsyncSRT} asyncSrt
+ * @param {number} socketFd
+ * @param {Uint8Array} buffer
+ * @param {number} payloadSize
+ * @param {Function} onWrite Called with the bytes sent and the index of the first message of each call
+ * @param {number} messagesPerCall
+ * @returns {Promise<void>}
+ */
+async function writeBufferWithScatterSend(asyncSrt, socketFd, buffer, payloadSize,
+  onWrite = null, messagesPerCall = 128) {
+
+  const copy = asyncSrt.transport === 'worker';
+  let offset = 0;
+  while (offset < buffer.byteLength) {
+    const end = Math.min(buffer.byteLength, offset + payloadSize * messagesPerCall);
+    const data = copy
+      ? Uint8Array.prototype.slice.call(buffer, offset, end)
+      : buffer.subarray(offset, end);
+    const written = await asyncSrt.writeMany(socketFd, data, payloadSize);
+    if (written === SRT.ERROR) {
+      throw new Error('AsyncSRT.writeMany() failed');
+    }
+    if (written === 0) {
+      await waitForSocket(socketFd, SRT.EPOLL_OUT);
+      continue;
+    }
+    if (onWrite) {
+      onWrite(written, offset / payloadSize);
+    }
+    offset += written;
+  }
+}
+
+/**
+ * Queues a whole buffer on a native `SRTSendScheduler`, which paces it out
+ * at the bitrate the socket was configured with, from its own thread.
+ *
+ * The buffer is queued in slices of `messagesPerSlice` messages. While the queue
+ * of the socket is full, the next slice waits for the scheduler to report
+ * that enough of the queue was sent (`SRTSendScheduler#whenQueueBelow`), no timer is involved.
+ * Resolves once everything is queued, not sent (see `SRTSendScheduler#getMetrics`).
+ *
+ * @param {SRTSendScheduler} scheduler
+ * @param {number} socketFd configured with `scheduler.configure`
+ * @param {Uint8Array} buffer
+ * @param {number} payloadSize
+ * @param {number} messagesPerSlice
+ * @returns {Promise<void>}
+ */
+async function writeBufferWithSendScheduler(scheduler, socketFd, buffer, payloadSize = 1316,
+  messagesPerSlice = 128) {
+
+  let offset = 0;
+  while (offset < buffer.byteLength) {
+    const end = Math.min(buffer.byteLength, offset + payloadSize * messagesPerSlice);
+    const queued = scheduler.enqueue(socketFd, buffer.subarray(offset, end), payloadSize);
+    if (queued === 0) {
+      const metrics = scheduler.getMetrics(socketFd);
+      if (!metrics || metrics.broken) {
+        throw new Error('SRTSendScheduler: socket not configured or broken');
+      }
+      if (metrics.queuedBytes === 0) {
+        throw new Error('SRTSendScheduler: slice larger than the queue, use fewer messagesPerSlice');
+      }
+      // the slice didn't fit on top of the queue, it does once as much was sent
+      await scheduler.whenQueueBelow(socketFd, Math.max(metrics.queuedBytes - (end - offset), 0));
+      continue;
+    }
+    offset = end;
+  }
+}
+
 module.exports = {
+  writeBufferWithScatterSend,
+  writeBufferWithSendScheduler,
   writeChunksWithYieldingLoop,
   writeChunksWithExplicitScheduling
 }
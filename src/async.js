@@ -4,11 +4,26 @@ const {performance} = require("perf_hooks");
 
 const debug = require('debug')('srt-async');
 
-const { traceCallToString, extractTransferListFromParams } = require('./async-helpers');
-const { SRT } = require('../build/Release/node_srt.node');
+const { argsToString, traceCallToString, extractTransferListFromParams } = require('./async-helpers');
+const { AsyncSRTMetrics } = require('./async-metrics');
+const { SPSCRing, DEFAULT_RING_BYTES, STOP_METHOD, encodedSize, writeValue, readValue } = require('./shared-ring');
+const { SRT, SRTAsync } = require('../build/Release/node_srt.node');
 const EventEmitter = require('events');
 
 const DEFAULT_PROMISE_TIMEOUT_MS = 3000;
+const DEFAULT_NATIVE_THREADS = 4;
+const DEFAULT_PAYLOAD_SIZE = 1316;
+const DEFAULT_FILE_BLOCK_SIZE = 1024 * 1024;
+
+/**
+ * @readonly
+ * @enum {string}
+ */
+const AsyncSRTTransport = Object.freeze({
+  NATIVE: 'native',
+  WORKER: 'worker',
+  SHARED_RING: 'shared-ring'
+});
 
 const DEBUG = false;
 
@@ -24,32 +39,259 @@ class AsyncSRT extends EventEmitter {
    */
   static TimeoutMs = DEFAULT_PROMISE_TIMEOUT_MS;
 
-  constructor() {
+  /**
+   * The default `native` transport runs every binding call on a pool of native
+   * threads and resolves its Promise straight from C++.
+   * Calls on the same socket (or epoll id) always run in the order they were made.
+   *
+   * The `worker` transport is the former implementation, posting every call
+   * as a message to a JS Worker running the sync binding. It is kept for comparison.
+   *
+   * The `shared-ring` transport runs the same Worker, but passes calls and results
+   * through two ring buffers in shared memory instead of messages. Payloads are copied into
+   * and out of the rings, so buffers passed in are never detached.
+   *
+   * @param {object} [options]
+   * @param {AsyncSRTTransport} [options.transport] default: `native`
+   * @param {number} [options.threads] number of native threads (only `native` transport). default: 4
+   * @param {number} [options.ringBytes] size of each ring (only `shared-ring` transport),
+   *   a call or result can take up to half of it. default: 4 MiB
+   * @param {boolean} [options.metrics] collect call metrics from the start, see `getMetrics`. default: false
+   */
+  constructor(options = {}) {
     super()
+
+    this._transport = options.transport || AsyncSRTTransport.NATIVE;
+    this._binding = null;
+    this._worker = null;
+    this._workCbQueue = [];
+    // shared-ring transport: rings of calls to and results from the worker,
+    // and the calls waiting for room in the ring
+    this._calls = null;
+    this._results = null;
+    this._callBacklog = [];
+    this._publishScheduled = false;
+    this._metrics = null;
+    // [queuedUs, nativeUs] by call promise, reported by the native executor
+    this._nativeTimings = new WeakMap();
+    this._onNativeTiming = (promise, queuedUs, nativeUs) => {
+      this._nativeTimings.set(promise, [queuedUs, nativeUs]);
+    };
+
+    if (this._transport === AsyncSRTTransport.NATIVE) {
+      DEBUG && debug('Creating native executor instance');
+      this._binding = new SRTAsync(options.threads || DEFAULT_NATIVE_THREADS);
+      this.enableMetrics(!!options.metrics);
+      return;
+    }
+
+    if (this._transport === AsyncSRTTransport.SHARED_RING) {
+      this._startSharedRingWorker(options.ringBytes || DEFAULT_RING_BYTES);
+      this.enableMetrics(!!options.metrics);
+      return;
+    }
+
+    if (this._transport !== AsyncSRTTransport.WORKER) {
+      throw new Error(`Unknown AsyncSRT transport: ${this._transport}`);
+    }
+
     DEBUG && debug('Creating task-runner worker instance');
 
     this._worker = new Worker(path.resolve(__dirname, './async-worker.js'));
     this._worker.on('message', this._onWorkerMessage.bind(this));
+    this.enableMetrics(!!options.metrics);
     /*
     this._workIdGen = 0;
     this._workCbMap = new Map();
     */
-    this._workCbQueue = [];
   }
 
   /**
-   * @returns {Promise<number>} Resolves to exit code of Worker
+   * @returns {AsyncSRTTransport}
+   */
+  get transport() {
+    return this._transport;
+  }
+
+  /**
+   * Starts (or stops) collecting per-method call counts, latency histograms
+   * and the number of calls in flight. Cheap enough to leave on in production:
+   * a few clock reads and counter updates per call.
+   *
+   * Enabling again keeps what was collected, use `resetMetrics` to start over.
+   *
+   * @param {boolean} enabled default: true
+   */
+  enableMetrics(enabled = true) {
+    if (enabled && !this._metrics) {
+      this._metrics = new AsyncSRTMetrics();
+    } else if (!enabled) {
+      this._metrics = null;
+    }
+    if (this._binding) {
+      this._binding.setTimingCallback(enabled ? this._onNativeTiming : null);
+    }
+  }
+
+  /**
+   * Snapshot of the metrics collected since they were enabled or reset,
+   * null if they are not enabled.
+   *
+   * For every method: calls, errors and latency summaries (count, mean, min, max,
+   * p50/p90/p99 in microseconds) of the round trip, of the time queued for a native
+   * thread (or the worker) and of the time spent in the binding call itself.
+   *
+   * @returns {AsyncSRTMetricsSnapshot | null}
+   */
+  getMetrics() {
+    return this._metrics ? this._metrics.snapshot() : null;
+  }
+
+  /**
+   * Clears the collected metrics, the peak of calls in flight starts over from the current count.
+   */
+  resetMetrics() {
+    if (this._metrics) {
+      this._metrics.reset();
+    }
+  }
+
+  /**
+   * With the native transport, calls still queued are failed with "SRT executor was shut down"
+   * (they settle with `SRT.ERROR`, and an 'error' event if there are listeners).
+   *
+   * @returns {Promise<number>} Resolves to exit code of Worker (0 with the native transport)
    */
   dispose() {
+    if (this._binding) {
+      const binding = this._binding;
+      this._binding = null;
+      const dropped = binding.dispose();
+      if (dropped !== 0) {
+        console.warn(`AsyncSRT: rejected ${dropped} remaining jobs awaiting.`);
+      }
+      return Promise.resolve(0);
+    }
+
     const worker = this._worker;
     this._worker = null;
     if (this._workCbQueue.length !== 0) {
       console.warn(`AsyncSRT: flushing callback-queue with ${this._workCbQueue.length} remaining jobs awaiting.`);
       this._workCbQueue.length = 0;
     }
+    if (this._calls) {
+      this._callBacklog.length = 0;
+      // lets the worker leave its loop, in case it is blocked waiting on the ring
+      const stop = [STOP_METHOD, [], 0];
+      if (writeValue(this._calls, stop, encodedSize(stop))) {
+        this._calls.publish();
+      }
+      // ends the result pump
+      this._results.wake();
+    }
     return worker.terminate();
   }
 
+  /**
+   * @private
+   * @param {number} ringBytes
+   */
+  _startSharedRingWorker(ringBytes) {
+    if (typeof Atomics.waitAsync !== 'function') {
+      throw new Error('AsyncSRT: the shared-ring transport needs Atomics.waitAsync (Node.js 16 or later)');
+    }
+
+    DEBUG && debug('Creating shared-ring task-runner worker instance');
+
+    const calls = SPSCRing.allocate(ringBytes);
+    const results = SPSCRing.allocate(ringBytes);
+    this._calls = new SPSCRing(calls);
+    this._results = new SPSCRing(results);
+    this._publishCalls = () => {
+      this._publishScheduled = false;
+      this._calls.publish();
+    };
+    this._worker = new Worker(path.resolve(__dirname, './async-shared-worker.js'), {
+      workerData: {calls, results}
+    });
+    this._pumpSharedResults();
+  }
+
+  /**
+   * Settles the calls answered on the results ring,
+   * then waits for the worker to publish more until disposed.
+   *
+   * @private
+   */
+  async _pumpSharedResults() {
+    const results = this._results;
+    while (this._worker !== null) {
+      // read before draining, so a publish in between ends the wait right away
+      const sequence = results.dataSequence();
+      let answer;
+      while ((answer = readValue(results)) !== undefined) {
+        this._onSharedRingAnswer(answer);
+      }
+      this._flushCallBacklog();
+      const wait = results.waitForDataAsync(sequence);
+      if (wait) await wait;
+    }
+  }
+
+  /**
+   * @private
+   * @param {Array} answer [method, errorMessage, result, timestamp, callStart, callEnd]
+   */
+  _onSharedRingAnswer(answer) {
+    const [method, errMessage, result, timestamp, callStart, callEnd] = answer;
+    const data = errMessage === null
+      ? {result, timestamp, callStart, callEnd}
+      : {err: {message: errMessage}, call: {method, args: []}};
+    try {
+      this._onWorkerMessage(data);
+    } catch(err) {
+      // like from a message event, without stopping the pump
+      process.nextTick(() => { throw err; });
+    }
+  }
+
+  /**
+   * Writes the calls that did not fit before, in order, as far as there is room now.
+   *
+   * @private
+   */
+  _flushCallBacklog() {
+    const backlog = this._callBacklog;
+    let written = 0;
+    while (written < backlog.length
+      && writeValue(this._calls, backlog[written][0], backlog[written][1])) {
+      written++;
+    }
+    if (written > 0) {
+      backlog.splice(0, written);
+      this._calls.publish();
+    }
+  }
+
+  /**
+   * Copies the call into the ring, or queues it until there is room.
+   * The worker is woken once for all the calls made in the same tick.
+   *
+   * @private
+   * @param {Array} call [method, args, timestamp]
+   * @param {number} size
+   */
+  _writeSharedRingCall(call, size) {
+    if (this._callBacklog.length > 0 || !writeValue(this._calls, call, size)) {
+      this._callBacklog.push([call, size]);
+      return;
+    }
+    if (!this._publishScheduled) {
+      this._publishScheduled = true;
+      queueMicrotask(this._publishCalls);
+    }
+  }
+
   /**
    * @private
    * @param {object} data
@@ -60,7 +302,6 @@ class AsyncSRT extends EventEmitter {
     // but let's guard from that state anyway.
     if (this._worker === null) return;
 
-    const resolveTime = performance.now();
     const callback = this._workCbQueue.shift();
 
     if (data.err) {
@@ -69,11 +310,13 @@ class AsyncSRT extends EventEmitter {
         //'\n  Stacktrace:', data.err.stack
         );
       this.emit('error', data.err.message)
+      // settle like a failed native call does
+      callback(SRT.ERROR, data);
       return;
     }
 
-    const {timestamp, result, workId} = data;
-    callback(result);
+    const {result} = data;
+    callback(result, data);
   }
 
   /**
@@ -100,12 +343,122 @@ class AsyncSRT extends EventEmitter {
 
     DEBUG && debug('Sending call:', traceCallToString(method, args));
 
+    if (this._calls) {
+      if (this._worker === null) {
+        throw new Error('AsyncSRT: Can`t call a method after dispose');
+      }
+      const call = [method, args, timestamp];
+      const size = encodedSize(call);
+      if (size > this._calls.maxRecordBytes) {
+        throw new Error(`AsyncSRT: Call of ${size} bytes does not fit the shared ring (see the ringBytes option): ${traceCallToString(method, args)}`);
+      }
+      if (this._metrics) {
+        callback = this._measureWorkerCall(method, callback);
+      }
+      this._workCbQueue.push(callback);
+      this._writeSharedRingCall(call, size);
+      return;
+    }
+
     const transferList = extractTransferListFromParams(args);
 
+    if (this._metrics) {
+      callback = this._measureWorkerCall(method, callback);
+    }
     this._workCbQueue.push(callback);
     this._worker.postMessage({method, args, /*workId,*/ timestamp}, transferList);
   }
 
+  /**
+   * Wraps the callback of a worker call to record its metrics. The worker reports
+   * when it started and finished the binding call, on the shared wall-clock time line.
+   *
+   * @private
+   * @param {string} method
+   * @param {Function} callback
+   * @returns {Function}
+   */
+  _measureWorkerCall(method, callback) {
+    const metrics = this._metrics;
+    const start = metrics.callStarted();
+    return (result, data) => {
+      let timing = null;
+      if (data && data.callStart !== undefined) {
+        const postedAt = performance.timeOrigin + data.timestamp;
+        timing = [(data.callStart - postedAt) * 1000, (data.callEnd - data.callStart) * 1000];
+      }
+      metrics.callEnded(method, start, result === SRT.ERROR, timing);
+      callback(result);
+    };
+  }
+
+  /**
+   * The msgctrl argument is optional and can be left out in front of the callback.
+   * Its array is filled in on the executor side, so it can't be posted to a Worker.
+   *
+   * @private
+   * @param {Float64Array | Function | undefined} msgctrl
+   * @param {Function | undefined} callback
+   * @returns {Array} [msgctrl, callback]
+   */
+  _splitMsgCtrlArg(msgctrl, callback) {
+    if (typeof msgctrl === 'function') {
+      return [null, msgctrl];
+    }
+    if (msgctrl && !this._binding) {
+      throw new Error('AsyncSRT: msgctrl is only supported by the native transport');
+    }
+    return [msgctrl || null, callback];
+  }
+
+  /**
+   * @private
+   * @param {string} method
+   * @param {Array<any>} args
+   * @param {Function} callback
+   */
+  _callNative(method, args, callback) {
+    if (this._binding === null) {
+      throw new Error('AsyncSRT: Can`t call a method after dispose');
+    }
+
+    DEBUG && debug('Calling:', traceCallToString(method, args));
+
+    const call = args.some((arg) => arg === undefined)
+      ? Promise.reject(new Error(`Ignoring call: Can't have any arguments be undefined: ${argsToString(args)}`))
+      : this._binding[method](...args);
+
+    if (this._metrics) {
+      callback = this._measureNativeCall(method, call, callback);
+    }
+
+    call.then(callback, (err) => {
+      if (this.listenerCount('error') > 0) {
+        this.emit('error', err.message);
+      }
+      callback(SRT.ERROR);
+    });
+  }
+
+  /**
+   * Wraps the callback of a native call to record its metrics,
+   * with the timing the executor reported for its promise.
+   *
+   * @private
+   * @param {string} method
+   * @param {Promise} call
+   * @param {Function} callback
+   * @returns {Function}
+   */
+  _measureNativeCall(method, call, callback) {
+    const metrics = this._metrics;
+    const start = metrics.callStarted();
+    return (result) => {
+      metrics.callEnded(method, start, result === SRT.ERROR, this._nativeTimings.get(call) || null);
+      callback(result);
+    };
+  }
+
   /**
    * @private
    * @param {string} method
@@ -141,7 +494,11 @@ class AsyncSRT extends EventEmitter {
           rejected = true;
         }, timeoutMs);
       }
-      this._postAsyncWork(method, args, onResult);
+      if (this._binding) {
+        this._callNative(method, args, onResult);
+      } else {
+        this._postAsyncWork(method, args, onResult);
+      }
     });
   }
 
@@ -173,6 +530,7 @@ class AsyncSRT extends EventEmitter {
   }
 
   /**
+   * `host` may be an IPv4 or IPv6 address.
    *
    * @param {number} socket
    * @param {string} host
@@ -183,6 +541,21 @@ class AsyncSRT extends EventEmitter {
   }
 
   /**
+   * Starts connecting without waiting for the handshake: the socket is made non-blocking
+   * for receiving (`SRTO_RCVSYN` false) and reports `SRT.EPOLL_OUT` once connected,
+   * or `SRT.EPOLL_ERR` if the connection failed. See `SRTConnector`.
+   *
+   * @param {number} socket
+   * @param {string} host IPv4 or IPv6 address
+   * @param {number} port
+   * @returns {Promise<SRTResult>}
+   */
+  startConnect(socket, host, port, callback) {
+    return this._createAsyncWorkPromise("startConnect", [socket, host, port], callback);
+  }
+
+  /**
+   * Accepts one connection. The listener stays open.
    *
    * @param {number} socket
    */
@@ -190,6 +563,51 @@ class AsyncSRT extends EventEmitter {
     return this._createAsyncWorkPromise("accept", [socket], callback, useTimeout, timeoutMs);
   }
 
+  /**
+   * Accepts up to `maxSockets` pending connections in one call, with their peer address.
+   * Only the first accept may wait (on a blocking listener), the call returns
+   * as soon as no more connections are pending.
+   *
+   * `options` (e.g `{ [SRT.SRTO_RCVSYN]: false }`) that SRT still takes on a connected socket
+   * are set on every accepted socket before it is returned. The ones it only takes before connecting
+   * (latency, passphrase, payload size, ...) are set on the listener, which hands them to
+   * the connections it takes from then on. Pass `maxSockets` 0 to only do that, before binding.
+   * Resolves to SRT_ERROR if an option can't be set.
+   *
+   * @param {number} socket listener
+   * @param {number} maxSockets
+   * @param {Object<number, SRTSockOptValue>} options optional
+   * @returns {Promise<Array<{socket: number, host: string, port: number}> | SRTResult.SRT_ERROR>}
+   */
+  acceptMany(socket, maxSockets, options = {}, callback) {
+    return this._createAsyncWorkPromise("acceptMany", [socket, maxSockets, options], callback);
+  }
+
+  /**
+   * Rejects callers by stream id during the handshake, natively,
+   * so a connection storm of unwanted callers doesn't wake up JS.
+   * A stream id matching `deny`, or none of `allow` when it isn't empty, is rejected.
+   * Entries ending with '*' match by prefix.
+   *
+   * Set it before `listen`. Calling this again replaces the rules; closing the listener drops them.
+   *
+   * @param {number} socket listener
+   * @param {string[]} allow
+   * @param {string[]} deny
+   * @returns {Promise<SRTResult>}
+   */
+  setStreamIdFilter(socket, allow = [], deny = [], callback) {
+    return this._createAsyncWorkPromise("setStreamIdFilter", [socket, allow, deny], callback);
+  }
+
+  /**
+   * @param {number} socket listener
+   * @returns {Promise<{accepted: number, rejected: number} | null>} null if the listener has no stream id filter
+   */
+  getStreamIdFilterStats(socket, callback) {
+    return this._createAsyncWorkPromise("getStreamIdFilterStats", [socket], callback);
+  }
+
   /**
    *
    * @param {number} socket
@@ -202,10 +620,62 @@ class AsyncSRT extends EventEmitter {
    *
    * @param {number} socket
    * @param {number} chunkSize
+   * @param {Float64Array} [msgctrl] receives the message metadata (see `createMsgCtrl`, native transport only)
    * @returns {Promise<Buffer | SRTResult.SRT_ERROR | null>}
    */
-  read(socket, chunkSize, callback) {
-    return this._createAsyncWorkPromise("read", [socket, chunkSize], callback);
+  read(socket, chunkSize, msgctrl, callback) {
+    [msgctrl, callback] = this._splitMsgCtrlArg(msgctrl, callback);
+    const args = msgctrl ? [socket, chunkSize, msgctrl] : [socket, chunkSize];
+    return this._createAsyncWorkPromise("read", args, callback);
+  }
+
+  /**
+   * Receives as many messages as are pending (bounded by `maxMessages` and `maxBytes`)
+   * into one contiguous buffer.
+   *
+   * Message `i` spans `buffer.subarray(offsets[i], offsets[i + 1])`.
+   * An empty batch means a non-blocking socket had no data pending.
+   *
+   * @param {number} socket
+   * @param {number} maxMessages
+   * @param {number} maxBytes
+   * @returns {Promise<SRTReadBatch | SRTResult.SRT_ERROR>}
+   */
+  readBatch(socket, maxMessages, maxBytes, callback) {
+    return this._createAsyncWorkPromise("readBatch", [socket, maxMessages, maxBytes], callback);
+  }
+
+  /**
+   * Receives one message straight into `buffer` at `offset`,
+   * so that a fixed set of receive buffers can be recycled.
+   *
+   * Resolves to the number of bytes received, or SRT_ERROR
+   * (also when there is no data pending on a non-blocking socket).
+   *
+   * The buffer must not be touched until the returned Promise has settled.
+   * With the `worker` and `shared-ring` transports the message is received by `read` and copied in.
+   *
+   * @param {number} socket
+   * @param {Buffer | Uint8Array} buffer
+   * @param {number} offset default: 0
+   * @param {Float64Array} [msgctrl] receives the message metadata (see `createMsgCtrl`, native transport only)
+   * @returns {Promise<number | SRTResult.SRT_ERROR>}
+   */
+  readInto(socket, buffer, offset = 0, msgctrl, callback) {
+    [msgctrl, callback] = this._splitMsgCtrlArg(msgctrl, callback);
+    if (this._binding) {
+      const args = msgctrl ? [socket, buffer, offset, msgctrl] : [socket, buffer, offset];
+      return this._createAsyncWorkPromise("readInto", args, callback);
+    }
+    return this.read(socket, buffer.byteLength - offset)
+      .then((chunk) => {
+        const result = chunk instanceof Uint8Array ? chunk.byteLength : SRT.ERROR;
+        if (result !== SRT.ERROR) {
+          buffer.set(chunk, offset);
+        }
+        if (callback) callback(result);
+        return result;
+      });
   }
 
   /**
@@ -221,22 +691,27 @@ class AsyncSRT extends EventEmitter {
    * where the error is thrown (on the binding call to the native SRT API),
    * and in the async API internals as it gets propagated back from the task-runner).
    *
-   * Note that any underlying data buffer passed in
+   * With the `worker` transport, any underlying data buffer passed in
    * will be *neutered* by our worker thread and
    * therefore become unusable (i.e go to detached state, `byteLengh === 0`)
    * for the calling thread of this method.
    * When consuming from a larger piece of data,
    * chunks written will need to be slice copies of the source buffer.
+   * The `native` and `shared-ring` transports leave the buffer attached, but it must not
+   * be modified until the returned Promise has settled.
    *
    * For a usage example, check the performance & smoke testbench.
    *
    * @param {number} socket Socket identifier to write to
-   * @param {Buffer | Uint8Array} chunk The underlying `buffer` (ArrayBufferLike) will get "neutered" by creating the async task. Pass in or use a copy respectively if concurrent data usage is intended.
+   * @param {Buffer | Uint8Array} chunk With the `worker` transport the underlying `buffer` (ArrayBufferLike) will get "neutered" by creating the async task. Pass in or use a copy respectively if concurrent data usage is intended.
+   * @param {Float64Array} [msgctrl] TTL, in-order flag and source time to send with, gets the sequence and message numbers assigned (see `createMsgCtrl`, native transport only)
    */
-  write(socket, chunk, callback) {
+  write(socket, chunk, msgctrl, callback) {
+    [msgctrl, callback] = this._splitMsgCtrlArg(msgctrl, callback);
     const byteLength = chunk.byteLength;
     DEBUG && debug(`write ${byteLength} to socket:`, socket)
-    return this._createAsyncWorkPromise("write", [socket, chunk], callback)
+    const args = msgctrl ? [socket, chunk, msgctrl] : [socket, chunk];
+    return this._createAsyncWorkPromise("write", args, callback)
       .then((result) => {
         if (result !== SRT.ERROR) {
           return byteLength;
@@ -244,6 +719,93 @@ class AsyncSRT extends EventEmitter {
       });
   }
 
+  /**
+   * Sends a whole buffer as consecutive messages of `payloadSize` bytes
+   * (the last one may be shorter), slicing it natively.
+   *
+   * Resolves to the number of bytes sent. This is less than `buffer.byteLength`
+   * when the send buffer of a non-blocking socket filled up (0 if nothing could be sent),
+   * so the caller can retry with `buffer.subarray(bytesSent)` later.
+   *
+   * The same notes about the buffer ownership as for `write` apply.
+   *
+   * An array of buffers is repacked as if it was one buffer, without concatenating it first.
+   *
+   * @param {number} socket
+   * @param {Buffer | Uint8Array | Array<Buffer | Uint8Array>} buffer
+   * @param {number} payloadSize default: 1316
+   * @returns {Promise<number | SRTResult.SRT_ERROR>}
+   */
+  writeMany(socket, buffer, payloadSize = DEFAULT_PAYLOAD_SIZE, callback) {
+    return this._createAsyncWorkPromise("writeMany", [socket, buffer, payloadSize], callback);
+  }
+
+  /**
+   * Sends an MPEG-TS stream as messages of exactly 7 TS packets (1316 bytes),
+   * cut natively. The stream may be passed in chunks of any size:
+   * packets cut by the end of a chunk are completed by the next call on the socket.
+   * Bytes out of sync are skipped until the next sync byte (0x47).
+   *
+   * With `pace`, every message is sent when due according to the PCR,
+   * so a file or buffer is played out in real time. From its first paced call on,
+   * the stream of a socket is written from a thread of its own, until the call with `end`
+   * or `close`, so waiting for a message to be due never delays calls on other sockets.
+   * Meanwhile the other calls on that socket run on the same thread, in order with the writes.
+   *
+   * Pass `end` with the last chunk to send the last, shorter, message and reset the stream state.
+   * Only supported by the native transport.
+   *
+   * @param {number} socket
+   * @param {Buffer | Uint8Array} buffer must not be modified until the returned Promise has settled
+   * @param {boolean} pace default: false
+   * @param {boolean} end default: false
+   * @returns {Promise<number | SRTResult.SRT_ERROR>} Bytes sent
+   */
+  writeTs(socket, buffer, pace = false, end = false, callback) {
+    if (!this._binding) {
+      throw new Error('AsyncSRT: writeTs is only supported by the native transport');
+    }
+    return this._createAsyncWorkPromise("writeTs", [socket, buffer, pace, end], callback);
+  }
+
+  /**
+   * Sends `size` bytes of the file at `path`, starting at `offset`, with `srt_sendfile`.
+   * The socket should be a blocking one with `SRTO_TRANSTYPE` set to `SRT.SRTT_FILE`
+   * (before connecting). The call holds its thread until the range is sent,
+   * see `SRTFileTransfer` for progress and resuming.
+   *
+   * @param {number} socket
+   * @param {string} path
+   * @param {number} offset
+   * @param {number} size
+   * @param {number} blockSize default: 1 MiB
+   * @returns {Promise<number | SRTResult.SRT_ERROR>} Bytes sent
+   */
+  sendFile(socket, path, offset, size, blockSize = DEFAULT_FILE_BLOCK_SIZE, callback) {
+    return this._createAsyncWorkPromise("sendFile", [socket, path, offset, size, blockSize], callback);
+  }
+
+  /**
+   * Receives `size` bytes into the file at `path`, starting at `offset`.
+   * The file is created if needed and never truncated, so the range can be
+   * the rest of an interrupted transfer.
+   *
+   * Resolves to the bytes written, which is less than `size`
+   * when the connection broke after some data went through.
+   * Fails with the errno message if the file can't be opened, seeked,
+   * or written before any data went through.
+   *
+   * @param {number} socket
+   * @param {string} path
+   * @param {number} offset
+   * @param {number} size
+   * @param {number} blockSize default: 1 MiB
+   * @returns {Promise<number | SRTResult.SRT_ERROR>} Bytes received
+   */
+  recvFile(socket, path, offset, size, blockSize = DEFAULT_FILE_BLOCK_SIZE, callback) {
+    return this._createAsyncWorkPromise("recvFile", [socket, path, offset, size, blockSize], callback);
+  }
+
   /**
    *
    * @param {number} socket
@@ -271,6 +833,65 @@ class AsyncSRT extends EventEmitter {
     return this._createAsyncWorkPromise("getSockState", [socket], callback);
   }
 
+  /**
+   * Creates a socket group (bonding), to be connected with `connectGroup`,
+   * or accepted from a listener with `SRTO_GROUPCONNECT` set.
+   * The group id is used like a socket with read/write, epoll and stats.
+   *
+   * @param {number} type SRT.SRT_GTYPE_BROADCAST or SRT.SRT_GTYPE_BACKUP
+   * @returns {Promise<number | SRTResult.SRT_ERROR>} Group id
+   */
+  createGroup(type, callback) {
+    return this._createAsyncWorkPromise("createGroup", [type], callback);
+  }
+
+  /**
+   * Connects the group to every endpoint, one member socket per link.
+   * With a backup group, `weight` sets the priority of the link (higher goes first).
+   * Resolves once the first member connected (blocking group),
+   * links failing later are reported by `groupData`.
+   *
+   * @param {number} group
+   * @param {Array<{host: string, port: number, weight?: number, token?: number}>} endpoints
+   * @returns {Promise<number | SRTResult.SRT_ERROR>} Socket of the first connected member
+   */
+  connectGroup(group, endpoints, callback) {
+    return this._createAsyncWorkPromise("connectGroup", [group, endpoints], callback);
+  }
+
+  /**
+   * Current members of a group, with their socket and group status
+   * (`state` is a SRTS_ value, `status` a SRT_GST_ value).
+   *
+   * @param {number} group
+   * @returns {Promise<SRTGroupMember[] | SRTResult.SRT_ERROR>}
+   */
+  groupData(group, callback) {
+    return this._createAsyncWorkPromise("groupData", [group], callback);
+  }
+
+  /**
+   * Stats of a group as a whole, and of each of its members.
+   *
+   * @param {number} group
+   * @param {boolean} clear
+   * @returns {Promise<{group: SRTStats, members: Array<SRTGroupMember & {stats: SRTStats}>} | SRTResult.SRT_ERROR>}
+   */
+  async groupStats(group, clear = false) {
+    const members = await this.groupData(group);
+    if (members === SRT.ERROR) {
+      return SRT.ERROR;
+    }
+    const [groupStats, ...memberStats] = await Promise.all([
+      this.stats(group, clear),
+      ...members.map((member) => this.stats(member.socket, clear))
+    ]);
+    return {
+      group: groupStats,
+      members: members.map((member, i) => Object.assign({}, member, { stats: memberStats[i] }))
+    };
+  }
+
   /**
    * @returns {number} epid
    */
@@ -288,6 +909,52 @@ class AsyncSRT extends EventEmitter {
     return this._createAsyncWorkPromise("epollAddUsock", [epid, socket, events], callback);
   }
 
+  /**
+   *
+   * @param {number} epid
+   * @param {number} socket
+   * @param {number} events
+   */
+  epollUpdateUsock(epid, socket, events, callback) {
+    return this._createAsyncWorkPromise("epollUpdateUsock", [epid, socket, events], callback);
+  }
+
+  /**
+   *
+   * @param {number} epid
+   * @param {number} socket
+   */
+  epollRemoveUsock(epid, socket, callback) {
+    return this._createAsyncWorkPromise("epollRemoveUsock", [epid, socket], callback);
+  }
+
+  /**
+   *
+   * @param {number} epid
+   */
+  epollClearUsocks(epid, callback) {
+    return this._createAsyncWorkPromise("epollClearUsocks", [epid], callback);
+  }
+
+  /**
+   * Pass -1 as flags to only read the current ones.
+   *
+   * @param {number} epid
+   * @param {number} flags SRT.EPOLL_ENABLE_EMPTY | SRT.EPOLL_ENABLE_OUTPUTCHECK
+   * @returns {Promise<number>} Flags now set
+   */
+  epollSet(epid, flags, callback) {
+    return this._createAsyncWorkPromise("epollSet", [epid, flags], callback);
+  }
+
+  /**
+   *
+   * @param {number} epid
+   */
+  epollRelease(epid, callback) {
+    return this._createAsyncWorkPromise("epollRelease", [epid], callback);
+  }
+
   /**
    *
    * @param {number} epid
@@ -297,6 +964,37 @@ class AsyncSRT extends EventEmitter {
     return this._createAsyncWorkPromise("epollUWait", [epid, msTimeOut], callback);
   }
 
+  /**
+   * Waits like `epollUWait` but writes (socket, events) pairs into `events`
+   * instead of allocating an object per ready socket.
+   *
+   * The array must not be read until the returned Promise has settled.
+   * With the `worker` and `shared-ring` transports the events of `epollUWait` are copied in.
+   *
+   * @param {number} epid
+   * @param {number} msTimeOut
+   * @param {Int32Array} events Room for `events.length / 2` sockets
+   * @returns {Promise<number>} Number of ready sockets written
+   */
+  epollUWaitInto(epid, msTimeOut, events, callback) {
+    if (this._binding) {
+      return this._createAsyncWorkPromise("epollUWaitInto", [epid, msTimeOut, events], callback);
+    }
+    return this.epollUWait(epid, msTimeOut)
+      .then((result) => {
+        let n = 0;
+        if (Array.isArray(result)) {
+          n = Math.min(result.length, events.length >> 1);
+          for (let i = 0; i < n; i++) {
+            events[2 * i] = result[i].socket;
+            events[2 * i + 1] = result[i].events;
+          }
+        }
+        if (callback) callback(n);
+        return n;
+      });
+  }
+
   /**
    *
    * @param {number | SRTLoggingLevel} logLevel
@@ -315,9 +1013,44 @@ class AsyncSRT extends EventEmitter {
    stats(socket, clear, callback) {
     return this._createAsyncWorkPromise("stats", [socket, clear], callback);
   }
+
+  /**
+   * Samples the stats of many sockets in one call, into one row
+   * of `SRT.STATS_FIELD_COUNT` values per socket (see `createStatsRows` and `decodeStatsRow`).
+   *
+   * The rows must not be read until the returned Promise has settled.
+   * With the `worker` and `shared-ring` transports every socket is sampled with `stats` instead.
+   *
+   * @param {number[]} sockets
+   * @param {Float64Array} rows
+   * @param {boolean} clear
+   * @returns {Promise<number>} Number of sockets sampled
+   */
+  statsInto(sockets, rows, clear = false, callback) {
+    if (this._binding) {
+      return this._createAsyncWorkPromise("statsInto", [sockets, rows, clear], callback);
+    }
+    return Promise.all(sockets.map((socket) => this.stats(socket, clear)))
+      .then((results) => {
+        let sampled = 0;
+        results.forEach((stats, row) => {
+          const offset = row * SRT.STATS_FIELD_COUNT;
+          if (!stats || stats === SRT.ERROR) {
+            rows.fill(NaN, offset, offset + SRT.STATS_FIELD_COUNT);
+            return;
+          }
+          SRT.STATS_FIELDS.forEach((name, i) => {
+            rows[offset + i] = stats[name];
+          });
+          sampled++;
+        });
+        if (callback) callback(sampled);
+        return sampled;
+      });
+  }
 }
 
-module.exports = {AsyncSRT};
+module.exports = {AsyncSRT, AsyncSRTTransport};
 
 
 
@@ -1,8 +1,18 @@
 #include <napi.h>
 #include "node-srt.h"
+#include "node-srt-async.h"
+#include "node-srt-fan-out.h"
+#include "node-srt-relay.h"
+#include "node-srt-send-scheduler.h"
+#include "node-srt-stats-sampler.h"
 
 Napi::Object InitAll(Napi::Env env, Napi::Object exports) {
-  return NodeSRT::Init(env, exports);
+  NodeSRT::Init(env, exports);
+  NodeSRTAsync::Init(env, exports);
+  NodeSRTFanOut::Init(env, exports);
+  NodeSRTRelay::Init(env, exports);
+  NodeSRTSendScheduler::Init(env, exports);
+  return NodeSRTStatsSampler::Init(env, exports);
 }
 
-NODE_API_MODULE(NODE_GYP_MODULE_NAME, InitAll)
\ No newline at end of file
+NODE_API_MODULE(NODE_GYP_MODULE_NAME, InitAll)
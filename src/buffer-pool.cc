@@ -0,0 +1,94 @@
+#include "buffer-pool.h"
+
+#if defined(_WIN32)
+#include <srt.h>
+#else
+#include <srt/srt.h>
+#endif
+
+#include <algorithm>
+
+using namespace std;
+
+#define BUFFER_POOL_DEFAULT_MAX_BLOCKS 4096
+#define BUFFER_POOL_BLOCKS_PER_SLAB 64
+
+BufferPool& BufferPool::Shared() {
+  // never destroyed: Buffers may still be collected while the process exits
+  static BufferPool* pool = new BufferPool(SRT_LIVE_MAX_PLSIZE, BUFFER_POOL_DEFAULT_MAX_BLOCKS);
+  return *pool;
+}
+
+BufferPool::BufferPool(size_t blockSize, size_t maxBlocks)
+  : blockSize_(blockSize),
+    maxBlocks_(maxBlocks),
+    allocatedBlocks_(0),
+    hits_(0),
+    misses_(0) {
+}
+
+bool BufferPool::Grow() {
+  if (allocatedBlocks_ >= maxBlocks_) {
+    return false;
+  }
+  size_t count = min((size_t)BUFFER_POOL_BLOCKS_PER_SLAB, maxBlocks_ - allocatedBlocks_);
+  char* slab = new char[count * blockSize_];
+  slabs_.emplace_back(slab);
+  for (size_t i = 0; i < count; i++) {
+    free_.push_back(slab + i * blockSize_);
+  }
+  allocatedBlocks_ += count;
+  return true;
+}
+
+char* BufferPool::Acquire(size_t size) {
+  lock_guard<mutex> lock(mutex_);
+  if (size > blockSize_ || (free_.empty() && !Grow())) {
+    misses_++;
+    return nullptr;
+  }
+  hits_++;
+  char* block = free_.back();
+  free_.pop_back();
+  return block;
+}
+
+void BufferPool::Release(char* block) {
+  lock_guard<mutex> lock(mutex_);
+  free_.push_back(block);
+}
+
+Napi::Buffer<uint8_t> BufferPool::ToBuffer(Napi::Env env, char* block, size_t length) {
+  return Napi::Buffer<uint8_t>::New(env, (uint8_t *)block, length,
+    [](Napi::Env env, uint8_t* data, BufferPool* pool) {
+      pool->Release((char *)data);
+    }, this);
+}
+
+void BufferPool::SetMaxBlocks(size_t maxBlocks) {
+  lock_guard<mutex> lock(mutex_);
+  maxBlocks_ = maxBlocks;
+}
+
+BufferPool::Stats BufferPool::GetStats() {
+  lock_guard<mutex> lock(mutex_);
+  Stats stats;
+  stats.blockSize = blockSize_;
+  stats.maxBlocks = maxBlocks_;
+  stats.allocatedBlocks = allocatedBlocks_;
+  stats.freeBlocks = free_.size();
+  stats.hits = hits_;
+  stats.misses = misses_;
+  return stats;
+}
+
+Napi::Object BufferPoolStatsToObject(Napi::Env env, const BufferPool::Stats& stats) {
+  Napi::Object obj = Napi::Object::New(env);
+  obj.Set("blockSize", Napi::Number::New(env, (double)stats.blockSize));
+  obj.Set("maxBlocks", Napi::Number::New(env, (double)stats.maxBlocks));
+  obj.Set("allocatedBlocks", Napi::Number::New(env, (double)stats.allocatedBlocks));
+  obj.Set("freeBlocks", Napi::Number::New(env, (double)stats.freeBlocks));
+  obj.Set("hits", Napi::Number::New(env, (double)stats.hits));
+  obj.Set("misses", Napi::Number::New(env, (double)stats.misses));
+  return obj;
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <napi.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+/**
+ * Process-wide pool of MTU-sized receive blocks, carved from slabs on demand.
+ *
+ * A block is handed to JS as the memory of a Buffer whose finalizer puts it back,
+ * so receiving a message costs neither an allocation nor a copy once the pool is warm.
+ * Requests larger than a block, or made while the pool is exhausted,
+ * fall back to the heap and are counted as misses.
+ *
+ * Slabs are kept for the lifetime of the process.
+ */
+class BufferPool {
+  public:
+    struct Stats {
+      size_t blockSize;
+      size_t maxBlocks;
+      size_t allocatedBlocks;
+      size_t freeBlocks;
+      uint64_t hits;
+      uint64_t misses;
+    };
+
+    static BufferPool& Shared();
+
+    /**
+     * Returns a block of at least `size` bytes, or nullptr on a miss.
+     */
+    char* Acquire(size_t size);
+    void Release(char* block);
+
+    /**
+     * Wraps an acquired block into a Buffer of `length` bytes that gives the block back when collected.
+     */
+    Napi::Buffer<uint8_t> ToBuffer(Napi::Env env, char* block, size_t length);
+
+    /**
+     * Limits how many blocks may be carved in total. Blocks already carved are kept.
+     */
+    void SetMaxBlocks(size_t maxBlocks);
+
+    Stats GetStats();
+
+    size_t BlockSize() const { return blockSize_; }
+
+  private:
+    BufferPool(size_t blockSize, size_t maxBlocks);
+
+    bool Grow();
+
+    std::mutex mutex_;
+    const size_t blockSize_;
+    size_t maxBlocks_;
+    size_t allocatedBlocks_;
+    std::vector<std::unique_ptr<char[]>> slabs_;
+    std::vector<char*> free_;
+    uint64_t hits_;
+    uint64_t misses_;
+};
+
+Napi::Object BufferPoolStatsToObject(Napi::Env env, const BufferPool::Stats& stats);
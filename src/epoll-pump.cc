@@ -0,0 +1,139 @@
+#include "epoll-pump.h"
+
+#define EPOLL_PUMP_EVENTS_NUM_MAX 1024
+#define EPOLL_PUMP_WAIT_MS 100
+
+std::shared_ptr<EpollPump> EpollPump::Start(Napi::Env env, int epid, Napi::Function callback) {
+  // Without this flag a wait on an epoll with no subscribed sockets fails
+  // immediately, e.g a listener stream that has not accepted anything yet.
+  int32_t flags = srt_epoll_set(epid, -1);
+  if (flags == SRT_ERROR) {
+    Napi::Error::New(env, srt_getlasterror_str()).ThrowAsJavaScriptException();
+    return nullptr;
+  }
+  srt_epoll_set(epid, flags | SRT_EPOLL_ENABLE_EMPTY);
+
+  std::shared_ptr<EpollPump> pump = std::make_shared<EpollPump>(epid);
+  // The context keeps the pump alive until every queued call has been run
+  pump->tsfn_ = Napi::ThreadSafeFunction::New(env, callback, "SRTEpollPump", 0, 1,
+    new std::shared_ptr<EpollPump>(pump), Finalize);
+  pump->thread_ = std::thread(&EpollPump::Run, pump.get());
+  return pump;
+}
+
+EpollPump::EpollPump(int epid)
+  : epid_(epid),
+    state_(std::make_shared<ArmState>()),
+    stopped_(false),
+    finalized_(false),
+    events_(EPOLL_PUMP_EVENTS_NUM_MAX),
+    ready_(0) {
+}
+
+EpollPump::~EpollPump() {
+  StopThread();
+}
+
+void EpollPump::Stop() {
+  if (stopped_.exchange(true)) {
+    return;
+  }
+  StopThread();
+  if (!finalized_) {
+    tsfn_.Release();
+  }
+}
+
+void EpollPump::StopThread() {
+  {
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    state_->running = false;
+  }
+  state_->cv.notify_all();
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+}
+
+void EpollPump::Rearm(const std::shared_ptr<ArmState>& state) {
+  {
+    std::lock_guard<std::mutex> lock(state->mutex);
+    state->armed = true;
+  }
+  state->cv.notify_all();
+}
+
+void EpollPump::Run() {
+  const int fdsSetSize = (int) events_.size();
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(state_->mutex);
+      state_->cv.wait(lock, [this] { return state_->armed || !state_->running; });
+      if (!state_->running) {
+        break;
+      }
+    }
+
+    // A bounded wait lets us notice Stop() without any JS involvement
+    int n = srt_epoll_uwait(epid_, events_.data(), fdsSetSize, EPOLL_PUMP_WAIT_MS);
+    if (n == 0) {
+      continue;
+    }
+    if (n < 0) {
+      if (srt_getlasterror(nullptr) == SRT_ETIMEOUT) {
+        continue;
+      }
+      error_ = srt_getlasterror_str();
+      ready_ = 0;
+    } else {
+      // uwait returns fdsSetSize + 1 when more sockets are ready than reported
+      ready_ = n > fdsSetSize ? fdsSetSize : n;
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(state_->mutex);
+      state_->armed = false;
+    }
+    if (tsfn_.NonBlockingCall(this, CallJs) != napi_ok || !error_.empty()) {
+      break;
+    }
+  }
+}
+
+void EpollPump::CallJs(Napi::Env env, Napi::Function callback, EpollPump* pump) {
+  if (env == nullptr || pump->stopped_) {
+    return;
+  }
+
+  if (!pump->error_.empty()) {
+    callback.Call({ env.Null(), Napi::String::New(env, pump->error_) });
+    return;
+  }
+
+  Napi::Array events = Napi::Array::New(env, pump->ready_);
+  for (int i = 0; i < pump->ready_; i++) {
+    Napi::Object event = Napi::Object::New(env);
+    event.Set(Napi::String::New(env, "socket"), Napi::Number::New(env, pump->events_[i].fd));
+    event.Set(Napi::String::New(env, "events"), Napi::Number::New(env, pump->events_[i].events));
+    events[i] = event;
+  }
+
+  std::shared_ptr<ArmState> state = pump->state_;
+  Napi::Value result = callback.Call({ events });
+  if (!result.IsEmpty() && result.IsPromise()) {
+    // wait for the handler to settle before reporting the same readiness again
+    Napi::Function rearm = Napi::Function::New(env, [state](const Napi::CallbackInfo& info) {
+      Rearm(state);
+    });
+    Napi::Function then = result.As<Napi::Object>().Get("then").As<Napi::Function>();
+    then.Call(result, { rearm, rearm });
+    return;
+  }
+  Rearm(state);
+}
+
+void EpollPump::Finalize(Napi::Env env, std::shared_ptr<EpollPump>* context) {
+  (*context)->finalized_ = true;
+  (*context)->StopThread();
+  delete context;
+}
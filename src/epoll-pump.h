@@ -0,0 +1,66 @@
+#pragma once
+
+#include <napi.h>
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#if defined(_WIN32)
+#include <srt.h>
+#else
+#include <srt/srt.h>
+#endif
+
+/**
+ * Runs `srt_epoll_uwait` on a dedicated thread and hands every batch of
+ * ready sockets to a JS callback through a thread-safe function.
+ *
+ * Only one batch is in flight at any time: the thread waits again only
+ * after the JS callback has returned (or the Promise it returned has settled).
+ * This keeps level-triggered subscriptions from flooding the event loop
+ * with the same readiness while JS is still handling it.
+ */
+class EpollPump {
+  public:
+    static std::shared_ptr<EpollPump> Start(Napi::Env env, int epid, Napi::Function callback);
+
+    EpollPump(int epid);
+    ~EpollPump();
+
+    /**
+     * Joins the wait thread and releases the thread-safe function.
+     * Calls already queued to the main thread are dropped.
+     */
+    void Stop();
+
+    int Epid() const { return epid_; }
+
+  private:
+    struct ArmState {
+      std::mutex mutex;
+      std::condition_variable cv;
+      bool armed = true;
+      bool running = true;
+    };
+
+    void Run();
+    void StopThread();
+    static void Rearm(const std::shared_ptr<ArmState>& state);
+    static void CallJs(Napi::Env env, Napi::Function callback, EpollPump* pump);
+    static void Finalize(Napi::Env env, std::shared_ptr<EpollPump>* context);
+
+    int epid_;
+    std::shared_ptr<ArmState> state_;
+    std::atomic<bool> stopped_;
+    bool finalized_;
+    std::vector<SRT_EPOLL_EVENT> events_;
+    int ready_;
+    std::string error_;
+    std::thread thread_;
+    Napi::ThreadSafeFunction tsfn_;
+};
@@ -0,0 +1,270 @@
+#include "fan-out.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+#include "srt-io.h"
+#include "ts-packetizer.h"
+
+using namespace std;
+
+// how long the thread waits before it looks at `running_` again
+#define FANOUT_WAIT_MS 100
+#define FANOUT_EVENTS_MAX 256
+#define FANOUT_BATCH_MESSAGES 64
+
+FanOut::FanOut(SRTSOCKET source, size_t capacity, Policy policy)
+  : source_(source),
+    capacity_(capacity > 0 ? capacity : 1),
+    policy_(policy),
+    epid_(srt_epoll_create()),
+    running_(true),
+    broken_(false),
+    head_(0),
+    ring_(capacity_ * SRT_LIVE_MAX_PLSIZE),
+    slots_(capacity_),
+    scratch_(FANOUT_BATCH_MESSAGES * SRT_LIVE_MAX_PLSIZE) {
+  srt_epoll_set(epid_, SRT_EPOLL_ENABLE_EMPTY);
+  int events = SRT_EPOLL_IN | SRT_EPOLL_ERR;
+  if (srt_epoll_add_usock(epid_, source_, &events) == SRT_ERROR) {
+    broken_ = true;
+  }
+  thread_ = thread(&FanOut::Run, this);
+}
+
+FanOut::~FanOut() {
+  Stop();
+  srt_epoll_release(epid_);
+}
+
+void FanOut::Stop() {
+  running_ = false;
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+}
+
+bool FanOut::HasRandomAccessPoint(const char* data, int length) {
+  for (int offset = 0; offset + TS_PACKET_SIZE <= length; offset += TS_PACKET_SIZE) {
+    const uint8_t* packet = (const uint8_t*)data + offset;
+    if (packet[0] != TS_SYNC_BYTE) {
+      continue;
+    }
+    bool hasAdaptationField = (packet[3] & 0x20) != 0;
+    if (hasAdaptationField && packet[4] > 0 && (packet[5] & 0x40) != 0) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool FanOut::AddSubscriber(SRTSOCKET socket, Policy policy) {
+  bool sndsyn = false;
+  if (srt_setsockflag(socket, SRTO_SNDSYN, &sndsyn, sizeof(sndsyn)) == SRT_ERROR) {
+    return false;
+  }
+  lock_guard<mutex> lock(mutex_);
+  if (subscribers_.count(socket) != 0) {
+    return true;
+  }
+  Subscriber& subscriber = subscribers_[socket];
+  subscriber.policy = policy;
+  subscriber.cursor = head_;
+  if (policy == POLICY_SKIP_TO_KEYFRAME) {
+    uint64_t keyframe;
+    if (FindKeyframe(keyframe)) {
+      subscriber.cursor = keyframe;
+    } else {
+      subscriber.waitKeyframe = true;
+    }
+  }
+  return true;
+}
+
+bool FanOut::RemoveSubscriber(SRTSOCKET socket) {
+  lock_guard<mutex> lock(mutex_);
+  auto it = subscribers_.find(socket);
+  if (it == subscribers_.end()) {
+    return false;
+  }
+  if (it->second.blocked) {
+    srt_epoll_remove_usock(epid_, socket);
+  }
+  subscribers_.erase(it);
+  return true;
+}
+
+void FanOut::GetStats(Stats& stats) {
+  lock_guard<mutex> lock(mutex_);
+  stats.counters = counters_;
+  stats.broken = broken_;
+  stats.subscribers.clear();
+  for (auto& entry : subscribers_) {
+    const Subscriber& subscriber = entry.second;
+    stats.subscribers.push_back(SubscriberStats{
+      entry.first,
+      subscriber.counters,
+      head_ - subscriber.cursor,
+      subscriber.blocked,
+      subscriber.disconnected
+    });
+  }
+}
+
+void FanOut::Run() {
+  vector<SRT_EPOLL_EVENT> events(FANOUT_EVENTS_MAX);
+  while (running_) {
+    int n = srt_epoll_uwait(epid_, events.data(), (int)events.size(), FANOUT_WAIT_MS);
+    if (n == SRT_ERROR) {
+      if (srt_getlasterror(nullptr) != SRT_ETIMEOUT) {
+        this_thread::sleep_for(chrono::milliseconds(FANOUT_WAIT_MS));
+      }
+      continue;
+    }
+    n = min(n, (int)events.size());
+
+    lock_guard<mutex> lock(mutex_);
+    for (int i = 0; i < n; i++) {
+      if (events[i].fd == source_ && !broken_) {
+        Receive();
+      }
+    }
+    // blocked subscribers are only tried again once SRT reported room for them
+    for (int i = 0; i < n; i++) {
+      auto it = subscribers_.find(events[i].fd);
+      if (it != subscribers_.end() && it->second.blocked) {
+        SetBlocked(it->first, it->second, false);
+      }
+    }
+    for (auto& entry : subscribers_) {
+      Subscriber& subscriber = entry.second;
+      if (subscriber.disconnected) {
+        continue;
+      }
+      if (subscriber.blocked) {
+        // falling behind is handled right away rather than once there is room again
+        if (head_ - subscriber.cursor > capacity_) {
+          CatchUp(entry.first, subscriber);
+        }
+        continue;
+      }
+      Flush(entry.first, subscriber);
+    }
+  }
+}
+
+void FanOut::Receive() {
+  int count = RecvBatch(source_, scratch_.data(), (int)scratch_.size(), FANOUT_BATCH_MESSAGES, offsets_);
+  if (count == SRT_ERROR) {
+    broken_ = true;
+    srt_epoll_remove_usock(epid_, source_);
+    return;
+  }
+  for (int i = 0; i < count; i++) {
+    const char* message = scratch_.data() + offsets_[i];
+    int length = (int)(offsets_[i + 1] - offsets_[i]);
+    if (length > SRT_LIVE_MAX_PLSIZE) {
+      // a message-API source in file mode can deliver more than a slot holds
+      counters_.drops++;
+      continue;
+    }
+    size_t index = head_ % capacity_;
+    memcpy(ring_.data() + index * SRT_LIVE_MAX_PLSIZE, message, length);
+    slots_[index].length = length;
+    slots_[index].keyframe = HasRandomAccessPoint(message, length);
+    head_++;
+    counters_.packets++;
+    counters_.bytes += length;
+  }
+}
+
+void FanOut::Flush(SRTSOCKET socket, Subscriber& subscriber) {
+  if (head_ - subscriber.cursor > capacity_) {
+    CatchUp(socket, subscriber);
+    if (subscriber.disconnected) {
+      return;
+    }
+  }
+  while (subscriber.cursor < head_) {
+    const Slot& slot = slots_[subscriber.cursor % capacity_];
+    if (subscriber.waitKeyframe) {
+      if (!slot.keyframe) {
+        subscriber.cursor++;
+        subscriber.counters.drops++;
+        continue;
+      }
+      subscriber.waitKeyframe = false;
+    }
+    const char* message = ring_.data() + (subscriber.cursor % capacity_) * SRT_LIVE_MAX_PLSIZE;
+    if (srt_sendmsg2(socket, message, slot.length, nullptr) == SRT_ERROR) {
+      if (srt_getlasterror(nullptr) == SRT_EASYNCSND) {
+        SetBlocked(socket, subscriber, true);
+      } else {
+        // broken or closed elsewhere, its owner removes it
+        subscriber.disconnected = true;
+      }
+      return;
+    }
+    subscriber.cursor++;
+    subscriber.counters.packets++;
+    subscriber.counters.bytes += slot.length;
+  }
+}
+
+void FanOut::CatchUp(SRTSOCKET socket, Subscriber& subscriber) {
+  uint64_t oldest = head_ - capacity_;
+  switch (subscriber.policy) {
+    case POLICY_DISCONNECT:
+      subscriber.counters.drops += head_ - subscriber.cursor;
+      subscriber.cursor = head_;
+      Disconnect(socket, subscriber);
+      return;
+    case POLICY_SKIP_TO_KEYFRAME: {
+      uint64_t keyframe;
+      if (FindKeyframe(keyframe)) {
+        subscriber.counters.drops += keyframe - subscriber.cursor;
+        subscriber.cursor = keyframe;
+        return;
+      }
+      // the messages still in the ring are dropped until a random access point arrives
+      subscriber.counters.drops += oldest - subscriber.cursor;
+      subscriber.cursor = oldest;
+      subscriber.waitKeyframe = true;
+      return;
+    }
+    default:
+      subscriber.counters.drops += oldest - subscriber.cursor;
+      subscriber.cursor = oldest;
+      return;
+  }
+}
+
+void FanOut::SetBlocked(SRTSOCKET socket, Subscriber& subscriber, bool blocked) {
+  if (blocked) {
+    int events = SRT_EPOLL_OUT | SRT_EPOLL_ERR;
+    srt_epoll_add_usock(epid_, socket, &events);
+  } else {
+    srt_epoll_remove_usock(epid_, socket);
+  }
+  subscriber.blocked = blocked;
+}
+
+void FanOut::Disconnect(SRTSOCKET socket, Subscriber& subscriber) {
+  if (subscriber.blocked) {
+    SetBlocked(socket, subscriber, false);
+  }
+  srt_close(socket);
+  subscriber.disconnected = true;
+}
+
+bool FanOut::FindKeyframe(uint64_t& sequence) {
+  uint64_t oldest = head_ > capacity_ ? head_ - capacity_ : 0;
+  for (uint64_t i = head_; i > oldest; i--) {
+    if (slots_[(i - 1) % capacity_].keyframe) {
+      sequence = i - 1;
+      return true;
+    }
+  }
+  return false;
+}
@@ -0,0 +1,113 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#if defined(_WIN32)
+#include <srt.h>
+#else
+#include <srt/srt.h>
+#endif
+
+/**
+ * Receives every message of one source socket once, into a ring shared by all
+ * subscribers, and sends it from there to each subscriber socket, on its own thread.
+ *
+ * Every subscriber has its own cursor into the ring. Subscribers are made non-blocking:
+ * one that can't take more waits for SRT_EPOLL_OUT while the others go on.
+ * A subscriber that falls behind by more than the ring holds is handled by its policy.
+ * Source messages longer than SRT_LIVE_MAX_PLSIZE don't fit a slot and are counted as drops.
+ */
+class FanOut {
+  public:
+    enum Policy {
+      POLICY_DROP_OLDEST = 0,   // go on with the oldest message still in the ring
+      POLICY_DISCONNECT,        // close the subscriber socket
+      POLICY_SKIP_TO_KEYFRAME,  // go on with the newest MPEG-TS random access point in the ring
+      POLICY_COUNT
+    };
+
+    struct Counters {
+      uint64_t packets = 0;
+      uint64_t bytes = 0;
+      uint64_t drops = 0;
+    };
+
+    struct SubscriberStats {
+      SRTSOCKET socket;
+      Counters counters;
+      uint64_t lag;             // messages received but not sent yet
+      bool blocked;             // waiting for room in the send buffer
+      bool disconnected;
+    };
+
+    struct Stats {
+      Counters counters;        // received from the source, drops are messages too long for a slot
+      bool broken;              // the source failed
+      std::vector<SubscriberStats> subscribers;
+    };
+
+    FanOut(SRTSOCKET source, size_t capacity, Policy policy);
+    ~FanOut();
+
+    /**
+     * Starts sending to `socket` from the newest message on
+     * (from the newest random access point with POLICY_SKIP_TO_KEYFRAME).
+     * Returns false if the socket can't be made non-blocking (srt_getlasterror tells why).
+     */
+    bool AddSubscriber(SRTSOCKET socket, Policy policy);
+
+    bool RemoveSubscriber(SRTSOCKET socket);
+
+    void GetStats(Stats& stats);
+
+    void Stop();
+
+    /**
+     * Whether an MPEG-TS payload holds a packet with the random_access_indicator set.
+     */
+    static bool HasRandomAccessPoint(const char* data, int length);
+
+  private:
+    struct Slot {
+      int length = 0;
+      bool keyframe = false;
+    };
+
+    struct Subscriber {
+      Policy policy;
+      uint64_t cursor;
+      bool waitKeyframe = false;
+      bool blocked = false;
+      bool disconnected = false;
+      Counters counters;
+    };
+
+    void Run();
+    void Receive();
+    void Flush(SRTSOCKET socket, Subscriber& subscriber);
+    void CatchUp(SRTSOCKET socket, Subscriber& subscriber);
+    void SetBlocked(SRTSOCKET socket, Subscriber& subscriber, bool blocked);
+    void Disconnect(SRTSOCKET socket, Subscriber& subscriber);
+    bool FindKeyframe(uint64_t& sequence);
+
+    const SRTSOCKET source_;
+    const size_t capacity_;
+    const Policy policy_;
+    int epid_;
+    std::mutex mutex_;
+    std::atomic<bool> running_;
+    bool broken_;
+    Counters counters_;
+    uint64_t head_;           // sequence of the next message, its slot is head_ % capacity_
+    std::vector<char> ring_;
+    std::vector<Slot> slots_;
+    std::vector<char> scratch_;
+    std::vector<uint32_t> offsets_;
+    std::map<SRTSOCKET, Subscriber> subscribers_;
+    std::thread thread_;
+};
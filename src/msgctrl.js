@@ -0,0 +1,38 @@
+const { SRT } = require('../build/Release/node_srt.node');
+
+// defaults of `srt_msgctrl_default`
+const MSGTTL_INF = -1;
+const SEQNO_NONE = -1;
+const MSGNO_NONE = -1;
+const PB_SUBSEQUENT = 0;
+
+/**
+ * Creates the Float64Array that `read`, `readInto` and `write` accept as `msgctrl`.
+ * Its slots are indexed by `SRT.MSGCTRL_*`.
+ *
+ * Create it once and pass it to every call:
+ * a write reads `MSGCTRL_TTL`, `MSGCTRL_INORDER` and `MSGCTRL_SRCTIME` from it
+ * and gets `MSGCTRL_PKTSEQ` and `MSGCTRL_NO` back,
+ * a read fills in all fields of the received message.
+ *
+ * @param {object} [options]
+ * @param {number} [options.ttl] milliseconds after which SRT may drop the message unsent. default: -1 (infinite)
+ * @param {boolean} [options.inorder] only for message mode. default: false
+ * @param {number} [options.srctime] source time in microseconds on the SRT clock. default: 0 (time of the call)
+ * @returns {Float64Array}
+ */
+function createMsgCtrl({ ttl = MSGTTL_INF, inorder = false, srctime = 0 } = {}) {
+  const msgctrl = new Float64Array(SRT.MSGCTRL_LENGTH);
+  msgctrl[SRT.MSGCTRL_FLAGS] = 0;
+  msgctrl[SRT.MSGCTRL_TTL] = ttl;
+  msgctrl[SRT.MSGCTRL_INORDER] = inorder ? 1 : 0;
+  msgctrl[SRT.MSGCTRL_BOUNDARY] = PB_SUBSEQUENT;
+  msgctrl[SRT.MSGCTRL_SRCTIME] = srctime;
+  msgctrl[SRT.MSGCTRL_PKTSEQ] = SEQNO_NONE;
+  msgctrl[SRT.MSGCTRL_NO] = MSGNO_NONE;
+  return msgctrl;
+}
+
+module.exports = {
+  createMsgCtrl
+};
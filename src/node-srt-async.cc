@@ -0,0 +1,992 @@
+#if defined(_WIN32)
+#include <srt.h>
+#else
+#include <srt/srt.h>
+#endif
+#include "node-srt-async.h"
+#include "buffer-pool.h"
+#include "srt-address.h"
+#include "srt-group.h"
+#include "srt-io.h"
+#include "srt-values.h"
+#include "stream-id-filter.h"
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+using namespace std;
+
+#define EPOLL_EVENTS_NUM_MAX 1024
+#define DEFAULT_EXECUTOR_THREADS 4
+
+Napi::FunctionReference NodeSRTAsync::constructor;
+
+static Napi::Value RejectedPromise(Napi::Env env, const string& message) {
+  Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(env);
+  deferred.Reject(Napi::Error::New(env, message).Value());
+  return deferred.Promise();
+}
+
+static Napi::Value RejectedWithPendingException(Napi::Env env) {
+  Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(env);
+  deferred.Reject(env.GetAndClearPendingException().Value());
+  return deferred.Promise();
+}
+
+/**
+ * Carries the SRT_MSGCTRL of a call to the executor thread and back,
+ * keeping the caller's Float64Array alive in between.
+ */
+struct MsgCtrlSlot {
+  Napi::ObjectReference array;
+  SRT_MSGCTRL mctrl;
+
+  SRT_MSGCTRL* Get() {
+    return array.IsEmpty() ? nullptr : &mctrl;
+  }
+
+  // main thread only
+  void Store() {
+    if (!array.IsEmpty()) {
+      MsgCtrlToArray(mctrl, array.Value().As<Napi::Float64Array>().Data());
+    }
+  }
+};
+
+static shared_ptr<MsgCtrlSlot> NewMsgCtrlSlot(Napi::Float64Array array, bool input) {
+  shared_ptr<MsgCtrlSlot> slot = make_shared<MsgCtrlSlot>();
+  srt_msgctrl_init(&slot->mctrl);
+  if (!array.IsEmpty()) {
+    if (input) {
+      MsgCtrlFromArray(array.Data(), slot->mctrl);
+    }
+    slot->array = Napi::Persistent(array.As<Napi::Object>());
+  }
+  return slot;
+}
+
+Napi::Object NodeSRTAsync::Init(Napi::Env env, Napi::Object exports) {
+  Napi::HandleScope scope(env);
+
+  Napi::Function func = DefineClass(env, "SRTAsync", {
+    InstanceMethod("createSocket", &NodeSRTAsync::CreateSocket),
+    InstanceMethod("bind", &NodeSRTAsync::Bind),
+    InstanceMethod("listen", &NodeSRTAsync::Listen),
+    InstanceMethod("connect", &NodeSRTAsync::Connect),
+    InstanceMethod("startConnect", &NodeSRTAsync::StartConnect),
+    InstanceMethod("accept", &NodeSRTAsync::Accept),
+    InstanceMethod("acceptMany", &NodeSRTAsync::AcceptMany),
+    InstanceMethod("setStreamIdFilter", &NodeSRTAsync::SetStreamIdFilter),
+    InstanceMethod("getStreamIdFilterStats", &NodeSRTAsync::GetStreamIdFilterStats),
+    InstanceMethod("close", &NodeSRTAsync::Close),
+    InstanceMethod("read", &NodeSRTAsync::Read),
+    InstanceMethod("readBatch", &NodeSRTAsync::ReadBatch),
+    InstanceMethod("readInto", &NodeSRTAsync::ReadInto),
+    InstanceMethod("write", &NodeSRTAsync::Write),
+    InstanceMethod("writeMany", &NodeSRTAsync::WriteMany),
+    InstanceMethod("writeTs", &NodeSRTAsync::WriteTs),
+    InstanceMethod("sendFile", &NodeSRTAsync::SendFile),
+    InstanceMethod("recvFile", &NodeSRTAsync::RecvFile),
+    InstanceMethod("setSockOpt", &NodeSRTAsync::SetSockOpt),
+    InstanceMethod("getSockOpt", &NodeSRTAsync::GetSockOpt),
+    InstanceMethod("getSockState", &NodeSRTAsync::GetSockState),
+    InstanceMethod("createGroup", &NodeSRTAsync::CreateGroup),
+    InstanceMethod("connectGroup", &NodeSRTAsync::ConnectGroup),
+    InstanceMethod("groupData", &NodeSRTAsync::GroupData),
+    InstanceMethod("epollCreate", &NodeSRTAsync::EpollCreate),
+    InstanceMethod("epollAddUsock", &NodeSRTAsync::EpollAddUsock),
+    InstanceMethod("epollUpdateUsock", &NodeSRTAsync::EpollUpdateUsock),
+    InstanceMethod("epollRemoveUsock", &NodeSRTAsync::EpollRemoveUsock),
+    InstanceMethod("epollClearUsocks", &NodeSRTAsync::EpollClearUsocks),
+    InstanceMethod("epollSet", &NodeSRTAsync::EpollSet),
+    InstanceMethod("epollRelease", &NodeSRTAsync::EpollRelease),
+    InstanceMethod("epollUWait", &NodeSRTAsync::EpollUWait),
+    InstanceMethod("epollUWaitInto", &NodeSRTAsync::EpollUWaitInto),
+    InstanceMethod("setLogLevel", &NodeSRTAsync::SetLogLevel),
+    InstanceMethod("stats", &NodeSRTAsync::Stats),
+    InstanceMethod("statsInto", &NodeSRTAsync::StatsInto),
+    InstanceMethod("setTimingCallback", &NodeSRTAsync::SetTimingCallback),
+    InstanceMethod("dispose", &NodeSRTAsync::Dispose),
+  });
+
+  constructor = Napi::Persistent(func);
+  constructor.SuppressDestruct();
+
+  exports.Set("SRTAsync", func);
+  return exports;
+}
+
+NodeSRTAsync::NodeSRTAsync(const Napi::CallbackInfo& info) : Napi::ObjectWrap<NodeSRTAsync>(info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  size_t numThreads = DEFAULT_EXECUTOR_THREADS;
+  if (info.Length() > 0 && info[0].IsNumber()) {
+    numThreads = info[0].As<Napi::Number>().Uint32Value();
+  }
+
+  srt_startup();
+  executor.reset(new SRTExecutor(env, numThreads));
+  tsWriters = make_shared<TsWriters>();
+  pacingExecutors = make_shared<PacingExecutors>();
+}
+
+NodeSRTAsync::~NodeSRTAsync() {
+  srt_cleanup();
+}
+
+void NodeSRTAsync::Finalize(Napi::Env env) {
+  executor->Shutdown(env);
+  ShutdownPacingExecutors(env, *pacingExecutors);
+}
+
+size_t NodeSRTAsync::ShutdownPacingExecutors(Napi::Env env, PacingExecutors& executors) {
+  size_t dropped = 0;
+  for (auto& entry : executors) {
+    dropped += entry.second->Shutdown(env);
+  }
+  executors.clear();
+  return dropped;
+}
+
+void NodeSRTAsync::ReleasePacingExecutor(Napi::Env env, PacingExecutors& executors, SRTSOCKET socket) {
+  auto it = executors.find(socket);
+  if (it != executors.end() && it->second->Pending() == 0) {
+    it->second->Shutdown(env);
+    executors.erase(it);
+  }
+}
+
+SRTExecutor* NodeSRTAsync::ExecutorFor(SRTSOCKET socket) {
+  auto it = pacingExecutors->find(socket);
+  return it == pacingExecutors->end() ? executor.get() : it->second.get();
+}
+
+Napi::Value NodeSRTAsync::CreateSocket(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  bool isSender = info.Length() > 0 && info[0].IsBoolean() && info[0].As<Napi::Boolean>();
+
+  SRTAsyncJob* job = new SRTAsyncJob(env);
+  job->execute = [isSender]() {
+    SRTSOCKET socket = srt_create_socket();
+    if (socket != SRT_INVALID_SOCK && isSender) {
+      int yes = 1;
+      srt_setsockflag(socket, SRTO_SENDER, &yes, sizeof(yes));
+    }
+    return (int) socket;
+  };
+  return executor->Submit(env, SRTExecutor::NO_KEY, job);
+}
+
+Napi::Value NodeSRTAsync::Bind(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  SRTSOCKET socket = info[0].As<Napi::Number>();
+  Napi::String address = info[1].As<Napi::String>();
+  Napi::Number port = info[2].As<Napi::Number>();
+
+  sockaddr_storage addr;
+  int addrLen;
+  if (!ToSockAddr(address, port.Int32Value(), addr, addrLen)) {
+    return RejectedPromise(env, "Invalid IPv4 or IPv6 address: " + address.Utf8Value());
+  }
+
+  SRTAsyncJob* job = new SRTAsyncJob(env);
+  job->execute = [socket, addr, addrLen]() {
+    int result = srt_bind(socket, (struct sockaddr *)&addr, addrLen);
+    if (result == SRT_ERROR) {
+      srt_close(socket);
+    }
+    return result;
+  };
+  return ExecutorFor(socket)->Submit(env, socket, job);
+}
+
+Napi::Value NodeSRTAsync::Listen(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  SRTSOCKET socket = info[0].As<Napi::Number>();
+  int backlog = info[1].As<Napi::Number>();
+
+  SRTAsyncJob* job = new SRTAsyncJob(env);
+  job->execute = [socket, backlog]() {
+    int result = srt_listen(socket, backlog);
+    if (result == SRT_ERROR) {
+      srt_close(socket);
+    }
+    return result;
+  };
+  return ExecutorFor(socket)->Submit(env, socket, job);
+}
+
+Napi::Value NodeSRTAsync::Connect(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  SRTSOCKET socket = info[0].As<Napi::Number>();
+  Napi::String host = info[1].As<Napi::String>();
+  Napi::Number port = info[2].As<Napi::Number>();
+
+  sockaddr_storage addr;
+  int addrLen;
+  if (!ToSockAddr(host, port.Int32Value(), addr, addrLen)) {
+    return RejectedPromise(env, "Invalid IPv4 or IPv6 address: " + host.Utf8Value());
+  }
+
+  SRTAsyncJob* job = new SRTAsyncJob(env);
+  job->execute = [socket, addr, addrLen]() {
+    int result = srt_connect(socket, (struct sockaddr *)&addr, addrLen);
+    if (result == SRT_ERROR) {
+      srt_close(socket);
+    }
+    return result;
+  };
+  return ExecutorFor(socket)->Submit(env, socket, job);
+}
+
+Napi::Value NodeSRTAsync::StartConnect(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  SRTSOCKET socket = info[0].As<Napi::Number>();
+  Napi::String host = info[1].As<Napi::String>();
+  Napi::Number port = info[2].As<Napi::Number>();
+
+  sockaddr_storage addr;
+  int addrLen;
+  if (!ToSockAddr(host, port.Int32Value(), addr, addrLen)) {
+    return RejectedPromise(env, "Invalid IPv4 or IPv6 address: " + host.Utf8Value());
+  }
+
+  SRTAsyncJob* job = new SRTAsyncJob(env);
+  job->execute = [socket, addr, addrLen]() {
+    int result = StartConnectSocket(socket, addr, addrLen);
+    if (result == SRT_ERROR) {
+      srt_close(socket);
+    }
+    return result;
+  };
+  return ExecutorFor(socket)->Submit(env, socket, job);
+}
+
+Napi::Value NodeSRTAsync::Accept(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  SRTSOCKET socket = info[0].As<Napi::Number>();
+
+  SRTAsyncJob* job = new SRTAsyncJob(env);
+  job->execute = [socket]() {
+    sockaddr_storage their_addr;
+    int addr_size = sizeof (their_addr);
+    // the listener stays open for further connections
+    int their_fd = srt_accept(socket, (struct sockaddr *)&their_addr, &addr_size);
+    return their_fd == SRT_INVALID_SOCK ? SRT_ERROR : their_fd;
+  };
+  return ExecutorFor(socket)->Submit(env, socket, job);
+}
+
+Napi::Value NodeSRTAsync::AcceptMany(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  SRTSOCKET socket = info[0].As<Napi::Number>();
+  int maxSockets = info[1].As<Napi::Number>();
+  shared_ptr<SockOptValues> options = make_shared<SockOptValues>();
+  if (!GetSockOptValuesArg(info, 2, *options)) {
+    return RejectedWithPendingException(env);
+  }
+  shared_ptr<vector<AcceptedSocket>> accepted = make_shared<vector<AcceptedSocket>>();
+
+  SRTAsyncJob* job = new SRTAsyncJob(env);
+  job->execute = [socket, maxSockets, options, accepted]() {
+    return ::AcceptMany(socket, maxSockets, *options, *accepted);
+  };
+  job->complete = [accepted](Napi::Env env, int count) -> Napi::Value {
+    return AcceptedToArray(env, *accepted);
+  };
+  return ExecutorFor(socket)->Submit(env, socket, job);
+}
+
+Napi::Value NodeSRTAsync::SetStreamIdFilter(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  SRTSOCKET socket = info[0].As<Napi::Number>();
+  shared_ptr<vector<string>> allow = make_shared<vector<string>>();
+  shared_ptr<vector<string>> deny = make_shared<vector<string>>();
+  if (!GetStreamIdFilterArgs(info, 1, *allow, *deny)) {
+    return RejectedWithPendingException(env);
+  }
+
+  SRTAsyncJob* job = new SRTAsyncJob(env);
+  job->execute = [socket, allow, deny]() {
+    return StreamIdFilters::Shared().Set(socket, *allow, *deny);
+  };
+  return ExecutorFor(socket)->Submit(env, socket, job);
+}
+
+Napi::Value NodeSRTAsync::GetStreamIdFilterStats(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  SRTSOCKET socket = info[0].As<Napi::Number>();
+  shared_ptr<StreamIdFilters::Counters> counters = make_shared<StreamIdFilters::Counters>();
+
+  SRTAsyncJob* job = new SRTAsyncJob(env);
+  job->execute = [socket, counters]() {
+    return StreamIdFilters::Shared().GetCounters(socket, *counters) ? 1 : 0;
+  };
+  job->complete = [counters](Napi::Env env, int found) -> Napi::Value {
+    if (!found) {
+      return env.Null();
+    }
+    return StreamIdCountersToObject(env, *counters);
+  };
+  return ExecutorFor(socket)->Submit(env, socket, job);
+}
+
+Napi::Value NodeSRTAsync::Close(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  SRTSOCKET socket = info[0].As<Napi::Number>();
+
+  SRTAsyncJob* job = new SRTAsyncJob(env);
+  shared_ptr<TsWriters> writers = tsWriters;
+  job->execute = [socket, writers]() {
+    writers->Erase(socket);
+    StreamIdFilters::Shared().Remove(socket);
+    return srt_close(socket);
+  };
+  // runs after the paced writes queued before it, then takes their thread along
+  shared_ptr<PacingExecutors> pacing = pacingExecutors;
+  job->complete = [socket, pacing](Napi::Env env, int result) -> Napi::Value {
+    ReleasePacingExecutor(env, *pacing, socket);
+    return Napi::Number::New(env, result);
+  };
+  return ExecutorFor(socket)->Submit(env, socket, job);
+}
+
+Napi::Value NodeSRTAsync::Read(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  SRTSOCKET socket = info[0].As<Napi::Number>();
+  size_t bufferSize = info[1].As<Napi::Number>().Uint32Value();
+
+  Napi::Float64Array msgCtrlArray;
+  if (!GetMsgCtrlArg(info, 2, msgCtrlArray)) {
+    return RejectedWithPendingException(env);
+  }
+  shared_ptr<MsgCtrlSlot> msgCtrl = NewMsgCtrlSlot(msgCtrlArray, false);
+
+  // received straight into the memory handed over to the JS Buffer,
+  // a pooled block for MTU-sized reads
+  struct Block {
+    char* data = nullptr;
+    bool pooled = false;
+    ~Block() {
+      if (pooled) {
+        BufferPool::Shared().Release(data);
+      } else {
+        free(data);
+      }
+    }
+  };
+  shared_ptr<Block> block = make_shared<Block>();
+  block->data = BufferPool::Shared().Acquire(bufferSize);
+  block->pooled = block->data != nullptr;
+  if (!block->pooled) {
+    block->data = (char *)malloc(bufferSize);
+  }
+
+  SRTAsyncJob* job = new SRTAsyncJob(env);
+  job->toleratedError = SRT_EASYNCRCV;
+  job->execute = [socket, block, bufferSize, msgCtrl]() {
+    return srt_recvmsg2(socket, block->data, (int)bufferSize, msgCtrl->Get());
+  };
+  job->complete = [block, msgCtrl](Napi::Env env, int nb) -> Napi::Value {
+    if (nb == SRT_ERROR) {
+      return Napi::Number::New(env, SRT_ERROR);
+    }
+    msgCtrl->Store();
+    char* data = block->data;
+    block->data = nullptr;
+    if (block->pooled) {
+      block->pooled = false;
+      return BufferPool::Shared().ToBuffer(env, data, nb);
+    }
+    return Napi::Buffer<uint8_t>::New(env, (uint8_t *)data, nb,
+      [](Napi::Env env, uint8_t* data) {
+        free(data);
+      });
+  };
+  return ExecutorFor(socket)->Submit(env, socket, job);
+}
+
+Napi::Value NodeSRTAsync::ReadBatch(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  SRTSOCKET socket = info[0].As<Napi::Number>();
+  int maxMessages = info[1].As<Napi::Number>();
+  int maxBytes = info[2].As<Napi::Number>();
+
+  struct Batch {
+    char* data = nullptr;
+    vector<uint32_t> offsets;
+    ~Batch() { free(data); }
+  };
+  shared_ptr<Batch> batch = make_shared<Batch>();
+  batch->data = (char *)malloc(maxBytes > 0 ? maxBytes : 0);
+
+  SRTAsyncJob* job = new SRTAsyncJob(env);
+  job->execute = [socket, maxMessages, maxBytes, batch]() {
+    return RecvBatch(socket, batch->data, maxBytes, maxMessages, batch->offsets);
+  };
+  job->complete = [batch](Napi::Env env, int count) -> Napi::Value {
+    char* data = batch->data;
+    batch->data = nullptr;
+    return RecvBatchToObject(env, data, batch->offsets);
+  };
+  return ExecutorFor(socket)->Submit(env, socket, job);
+}
+
+Napi::Value NodeSRTAsync::ReadInto(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  SRTSOCKET socket = info[0].As<Napi::Number>();
+  Napi::Buffer<uint8_t> buffer = info[1].As<Napi::Buffer<uint8_t>>();
+  size_t offset = info.Length() > 2 && info[2].IsNumber() ? info[2].As<Napi::Number>().Uint32Value() : 0;
+
+  if (offset >= buffer.Length()) {
+    return RejectedPromise(env, "Offset is out of the buffer bounds");
+  }
+
+  Napi::Float64Array msgCtrlArray;
+  if (!GetMsgCtrlArg(info, 3, msgCtrlArray)) {
+    return RejectedWithPendingException(env);
+  }
+  shared_ptr<MsgCtrlSlot> msgCtrl = NewMsgCtrlSlot(msgCtrlArray, false);
+
+  // the receive goes straight into the JS memory, which we keep alive until then
+  shared_ptr<Napi::ObjectReference> bufferRef = make_shared<Napi::ObjectReference>(Napi::Persistent(buffer.As<Napi::Object>()));
+  char* data = (char *)buffer.Data() + offset;
+  int length = (int)(buffer.Length() - offset);
+
+  SRTAsyncJob* job = new SRTAsyncJob(env);
+  job->toleratedError = SRT_EASYNCRCV;
+  job->execute = [socket, data, length, bufferRef, msgCtrl]() {
+    return srt_recvmsg2(socket, data, length, msgCtrl->Get());
+  };
+  job->complete = [msgCtrl](Napi::Env env, int nb) -> Napi::Value {
+    if (nb != SRT_ERROR) {
+      msgCtrl->Store();
+    }
+    return Napi::Number::New(env, nb);
+  };
+  return ExecutorFor(socket)->Submit(env, socket, job);
+}
+
+Napi::Value NodeSRTAsync::Write(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  SRTSOCKET socket = info[0].As<Napi::Number>();
+  Napi::Buffer<uint8_t> chunk = info[1].As<Napi::Buffer<uint8_t>>();
+
+  Napi::Float64Array msgCtrlArray;
+  if (!GetMsgCtrlArg(info, 2, msgCtrlArray)) {
+    return RejectedWithPendingException(env);
+  }
+  shared_ptr<MsgCtrlSlot> msgCtrl = NewMsgCtrlSlot(msgCtrlArray, true);
+
+  // keeps the chunk from being collected while the executor thread reads it
+  shared_ptr<Napi::ObjectReference> chunkRef = make_shared<Napi::ObjectReference>(Napi::Persistent(chunk.As<Napi::Object>()));
+  const char* data = (const char *)chunk.Data();
+  int length = (int)chunk.Length();
+
+  SRTAsyncJob* job = new SRTAsyncJob(env);
+  job->execute = [socket, data, length, chunkRef, msgCtrl]() {
+    return srt_sendmsg2(socket, data, length, msgCtrl->Get());
+  };
+  job->complete = [msgCtrl](Napi::Env env, int result) -> Napi::Value {
+    msgCtrl->Store();
+    return Napi::Number::New(env, result);
+  };
+  return ExecutorFor(socket)->Submit(env, socket, job);
+}
+
+Napi::Value NodeSRTAsync::WriteMany(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  SRTSOCKET socket = info[0].As<Napi::Number>();
+  shared_ptr<vector<SendPart>> parts = make_shared<vector<SendPart>>();
+  if (!GetSendPartsArg(info, 1, *parts)) {
+    return RejectedWithPendingException(env);
+  }
+  int payloadSize = info.Length() > 2 && info[2].IsNumber() ? info[2].As<Napi::Number>().Int32Value() : SRT_LIVE_DEF_PLSIZE;
+
+  // keeps the buffer (or the array holding the buffers) alive until sent
+  shared_ptr<Napi::ObjectReference> bufferRef = make_shared<Napi::ObjectReference>(Napi::Persistent(info[1].As<Napi::Object>()));
+
+  SRTAsyncJob* job = new SRTAsyncJob(env);
+  job->execute = [socket, parts, payloadSize, bufferRef]() {
+    return SendMany(socket, *parts, payloadSize);
+  };
+  return ExecutorFor(socket)->Submit(env, socket, job);
+}
+
+shared_ptr<NodeSRTAsync::TsWriter> NodeSRTAsync::TsWriters::Get(SRTSOCKET socket) {
+  lock_guard<std::mutex> lock(mutex);
+  shared_ptr<TsWriter>& writer = writers[socket];
+  if (!writer) {
+    writer = make_shared<TsWriter>();
+  }
+  return writer;
+}
+
+void NodeSRTAsync::TsWriters::Erase(SRTSOCKET socket) {
+  lock_guard<std::mutex> lock(mutex);
+  writers.erase(socket);
+}
+
+Napi::Value NodeSRTAsync::WriteTs(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  SRTSOCKET socket = info[0].As<Napi::Number>();
+  Napi::Buffer<uint8_t> buffer = info[1].As<Napi::Buffer<uint8_t>>();
+  bool pace = info.Length() > 2 && info[2].ToBoolean();
+  bool end = info.Length() > 3 && info[3].ToBoolean();
+
+  shared_ptr<Napi::ObjectReference> bufferRef = make_shared<Napi::ObjectReference>(Napi::Persistent(buffer.As<Napi::Object>()));
+  const uint8_t* data = buffer.Data();
+  size_t length = buffer.Length();
+  shared_ptr<TsWriters> writers = tsWriters;
+  shared_ptr<TsWriter> writer = writers->Get(socket);
+
+  // once paced, all calls on a socket go to its pacing thread (see ExecutorFor), to keep them in order
+  shared_ptr<PacingExecutors> pacing = pacingExecutors;
+  if (pace && pacing->count(socket) == 0 && !executor->IsShutdown()) {
+    pacing->emplace(socket, unique_ptr<SRTExecutor>(new SRTExecutor(env, 1)));
+  }
+  SRTExecutor* target = ExecutorFor(socket);
+
+  SRTAsyncJob* job = new SRTAsyncJob(env);
+  job->execute = [socket, data, length, pace, end, writers, writer, bufferRef]() {
+    lock_guard<mutex> lock(writer->mutex);
+    TsPacketizer& packetizer = writer->packetizer;
+    packetizer.Push(data, length, end);
+
+    int sent = 0;
+    int result = 0;
+    for (const TsPacketizer::Message& message : packetizer.Messages()) {
+      if (pace) {
+        writer->pacer.WaitFor(message.timeUs);
+      }
+      const char* payload = (const char *)packetizer.Data().data() + message.offset;
+      if (srt_sendmsg2(socket, payload, (int)message.length, nullptr) == SRT_ERROR) {
+        // the messages left of this call are dropped
+        result = sent > 0 ? sent : SRT_ERROR;
+        break;
+      }
+      sent += (int)message.length;
+      result = sent;
+    }
+    if (end) {
+      writers->Erase(socket);
+    }
+    return result;
+  };
+  if (end && target != executor.get()) {
+    // the pacing thread goes away with the stream, unless more calls were made on it meanwhile
+    job->complete = [socket, pacing](Napi::Env env, int result) -> Napi::Value {
+      ReleasePacingExecutor(env, *pacing, socket);
+      return Napi::Number::New(env, result);
+    };
+  }
+  return target->Submit(env, socket, job);
+}
+
+Napi::Value NodeSRTAsync::SendFile(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  SRTSOCKET socket = info[0].As<Napi::Number>();
+  string path = info[1].As<Napi::String>();
+  int64_t offset = info[2].As<Napi::Number>().Int64Value();
+  int64_t size = info[3].As<Napi::Number>().Int64Value();
+  int blockSize = info.Length() > 4 && info[4].IsNumber() ? info[4].As<Napi::Number>().Int32Value() : FILE_TRANSFER_DEF_BLOCK;
+
+  // byte counts of a range can exceed the int result of a job
+  shared_ptr<int64_t> transferred = make_shared<int64_t>(0);
+
+  SRTAsyncJob* job = new SRTAsyncJob(env);
+  job->execute = [socket, path, offset, size, blockSize, transferred]() {
+    int64_t result = SendFileRange(socket, path.c_str(), offset, size, blockSize);
+    if (result == SRT_ERROR) {
+      return SRT_ERROR;
+    }
+    *transferred = result;
+    return 0;
+  };
+  job->complete = [transferred](Napi::Env env, int result) -> Napi::Value {
+    return Napi::Number::New(env, (double)*transferred);
+  };
+  return ExecutorFor(socket)->Submit(env, socket, job);
+}
+
+Napi::Value NodeSRTAsync::RecvFile(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  SRTSOCKET socket = info[0].As<Napi::Number>();
+  string path = info[1].As<Napi::String>();
+  int64_t offset = info[2].As<Napi::Number>().Int64Value();
+  int64_t size = info[3].As<Napi::Number>().Int64Value();
+  int blockSize = info.Length() > 4 && info[4].IsNumber() ? info[4].As<Napi::Number>().Int32Value() : FILE_TRANSFER_DEF_BLOCK;
+
+  // opened here so that file errors don't pass for SRT ones
+  FILE* openedFile = OpenRecvFile(path.c_str());
+  if (openedFile == nullptr) {
+    return RejectedPromise(env, string("Can't open ") + path + ": " + strerror(errno));
+  }
+  shared_ptr<FILE> file(openedFile, fclose);
+  shared_ptr<int64_t> transferred = make_shared<int64_t>(0);
+  shared_ptr<int> fileError = make_shared<int>(0);
+
+  SRTAsyncJob* job = new SRTAsyncJob(env);
+  job->execute = [socket, file, offset, size, blockSize, transferred, fileError]() {
+    int64_t result = RecvFileRange(socket, file.get(), offset, size, blockSize, *fileError);
+    if (result == SRT_ERROR) {
+      // file errors leave the SRT error state clear, complete rejects with them
+      return *fileError != 0 ? 0 : SRT_ERROR;
+    }
+    *transferred = result;
+    return 0;
+  };
+  job->complete = [path, transferred, fileError](Napi::Env env, int result) -> Napi::Value {
+    if (*fileError != 0) {
+      Napi::Error::New(env, string("Can't write ") + path + ": " + strerror(*fileError)).ThrowAsJavaScriptException();
+      return env.Undefined();
+    }
+    return Napi::Number::New(env, (double)*transferred);
+  };
+  return ExecutorFor(socket)->Submit(env, socket, job);
+}
+
+Napi::Value NodeSRTAsync::SetSockOpt(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  SRTSOCKET socket = info[0].As<Napi::Number>();
+  int option = info[1].As<Napi::Number>();
+
+  if (info[2].IsEmpty()) {
+    return RejectedPromise(env, "Value is empty");
+  }
+
+  SockOptValue value;
+  if (!SockOptValueFromJS(env, info[2], value)) {
+    return RejectedWithPendingException(env);
+  }
+
+  SRTAsyncJob* job = new SRTAsyncJob(env);
+  job->execute = [socket, option, value]() {
+    return SetSockOptValue(socket, option, value);
+  };
+  return ExecutorFor(socket)->Submit(env, socket, job);
+}
+
+Napi::Value NodeSRTAsync::GetSockOpt(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  SRTSOCKET socket = info[0].As<Napi::Number>();
+  int option = info[1].As<Napi::Number>();
+
+  shared_ptr<SockOptValue> value = make_shared<SockOptValue>();
+
+  SRTAsyncJob* job = new SRTAsyncJob(env);
+  job->execute = [socket, option, value]() {
+    return GetSockOptValue(socket, option, *value);
+  };
+  job->complete = [value](Napi::Env env, int result) -> Napi::Value {
+    if (value->type == SockOptValue::NONE) {
+      Napi::Error::New(env, "SOCKOPT not implemented yet").ThrowAsJavaScriptException();
+      return env.Undefined();
+    }
+    return SockOptValueToJS(env, *value);
+  };
+  return ExecutorFor(socket)->Submit(env, socket, job);
+}
+
+Napi::Value NodeSRTAsync::GetSockState(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  SRTSOCKET socket = info[0].As<Napi::Number>();
+
+  SRTAsyncJob* job = new SRTAsyncJob(env);
+  job->execute = [socket]() {
+    return (int) srt_getsockstate(socket);
+  };
+  return ExecutorFor(socket)->Submit(env, socket, job);
+}
+
+Napi::Value NodeSRTAsync::CreateGroup(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  SRT_GROUP_TYPE type = (SRT_GROUP_TYPE)info[0].As<Napi::Number>().Int32Value();
+
+  SRTAsyncJob* job = new SRTAsyncJob(env);
+  job->execute = [type]() {
+    SRTSOCKET group = srt_create_group(type);
+    return group == SRT_INVALID_SOCK ? SRT_ERROR : (int)group;
+  };
+  return executor->Submit(env, SRTExecutor::NO_KEY, job);
+}
+
+Napi::Value NodeSRTAsync::ConnectGroup(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  SRTSOCKET group = info[0].As<Napi::Number>();
+  shared_ptr<vector<SRT_SOCKGROUPCONFIG>> members = make_shared<vector<SRT_SOCKGROUPCONFIG>>();
+  if (!GetGroupEndpointsArg(info, 1, *members)) {
+    return RejectedWithPendingException(env);
+  }
+
+  SRTAsyncJob* job = new SRTAsyncJob(env);
+  job->execute = [group, members]() {
+    return srt_connect_group(group, members->data(), (int)members->size());
+  };
+  return ExecutorFor(group)->Submit(env, group, job);
+}
+
+Napi::Value NodeSRTAsync::GroupData(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  SRTSOCKET group = info[0].As<Napi::Number>();
+  shared_ptr<vector<SRT_SOCKGROUPDATA>> members = make_shared<vector<SRT_SOCKGROUPDATA>>();
+
+  SRTAsyncJob* job = new SRTAsyncJob(env);
+  job->execute = [group, members]() {
+    return GetGroupData(group, *members);
+  };
+  job->complete = [members](Napi::Env env, int count) -> Napi::Value {
+    return GroupDataToArray(env, *members);
+  };
+  return ExecutorFor(group)->Submit(env, group, job);
+}
+
+Napi::Value NodeSRTAsync::EpollCreate(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  SRTAsyncJob* job = new SRTAsyncJob(env);
+  job->execute = []() {
+    int epid = srt_epoll_create();
+    return epid < 0 ? SRT_ERROR : epid;
+  };
+  return executor->Submit(env, SRTExecutor::NO_KEY, job);
+}
+
+Napi::Value NodeSRTAsync::EpollAddUsock(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  int epid = info[0].As<Napi::Number>();
+  SRTSOCKET socket = info[1].As<Napi::Number>();
+  int events = info[2].As<Napi::Number>();
+
+  SRTAsyncJob* job = new SRTAsyncJob(env);
+  job->execute = [epid, socket, events]() {
+    return srt_epoll_add_usock(epid, socket, &events);
+  };
+  // epoll calls are ordered per epoll rather than per socket
+  return executor->Submit(env, epid, job);
+}
+
+Napi::Value NodeSRTAsync::EpollUpdateUsock(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  int epid = info[0].As<Napi::Number>();
+  SRTSOCKET socket = info[1].As<Napi::Number>();
+  int events = info[2].As<Napi::Number>();
+
+  SRTAsyncJob* job = new SRTAsyncJob(env);
+  job->execute = [epid, socket, events]() {
+    return srt_epoll_update_usock(epid, socket, &events);
+  };
+  return executor->Submit(env, epid, job);
+}
+
+Napi::Value NodeSRTAsync::EpollRemoveUsock(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  int epid = info[0].As<Napi::Number>();
+  SRTSOCKET socket = info[1].As<Napi::Number>();
+
+  SRTAsyncJob* job = new SRTAsyncJob(env);
+  job->execute = [epid, socket]() {
+    return srt_epoll_remove_usock(epid, socket);
+  };
+  return executor->Submit(env, epid, job);
+}
+
+Napi::Value NodeSRTAsync::EpollClearUsocks(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  int epid = info[0].As<Napi::Number>();
+
+  SRTAsyncJob* job = new SRTAsyncJob(env);
+  job->execute = [epid]() {
+    return srt_epoll_clear_usocks(epid);
+  };
+  return executor->Submit(env, epid, job);
+}
+
+Napi::Value NodeSRTAsync::EpollSet(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  int epid = info[0].As<Napi::Number>();
+  int32_t flags = info[1].As<Napi::Number>().Int32Value();
+
+  SRTAsyncJob* job = new SRTAsyncJob(env);
+  job->execute = [epid, flags]() {
+    return (int) srt_epoll_set(epid, flags);
+  };
+  return executor->Submit(env, epid, job);
+}
+
+Napi::Value NodeSRTAsync::EpollRelease(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  int epid = info[0].As<Napi::Number>();
+
+  SRTAsyncJob* job = new SRTAsyncJob(env);
+  job->execute = [epid]() {
+    return srt_epoll_release(epid);
+  };
+  return executor->Submit(env, epid, job);
+}
+
+Napi::Value NodeSRTAsync::EpollUWait(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  int epid = info[0].As<Napi::Number>();
+  int64_t msTimeOut = info[1].As<Napi::Number>().Int64Value();
+
+  shared_ptr<vector<SRT_EPOLL_EVENT>> fdsSet = make_shared<vector<SRT_EPOLL_EVENT>>(EPOLL_EVENTS_NUM_MAX);
+
+  SRTAsyncJob* job = new SRTAsyncJob(env);
+  job->toleratedError = SRT_ETIMEOUT;
+  job->execute = [epid, msTimeOut, fdsSet]() {
+    int n = srt_epoll_uwait(epid, fdsSet->data(), (int)fdsSet->size(), msTimeOut);
+    return n > (int)fdsSet->size() ? (int)fdsSet->size() : n;
+  };
+  job->complete = [fdsSet](Napi::Env env, int n) -> Napi::Value {
+    if (n < 0) {
+      n = 0;
+    }
+    Napi::Array events = Napi::Array::New(env, n);
+    for(int i = 0; i < n; i++) {
+      Napi::Object event = Napi::Object::New(env);
+      event.Set(Napi::String::New(env, "socket"), Napi::Number::New(env, (*fdsSet)[i].fd));
+      event.Set(Napi::String::New(env, "events"), Napi::Number::New(env, (*fdsSet)[i].events));
+      events[i] = event;
+    }
+    return events;
+  };
+  return executor->Submit(env, epid, job);
+}
+
+Napi::Value NodeSRTAsync::EpollUWaitInto(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  int epid = info[0].As<Napi::Number>();
+  int64_t msTimeOut = info[1].As<Napi::Number>().Int64Value();
+
+  Napi::Int32Array events;
+  if (!GetEpollEventsArg(info, 2, events)) {
+    return RejectedWithPendingException(env);
+  }
+
+  // written in place, the array is kept alive until then
+  shared_ptr<Napi::ObjectReference> eventsRef = make_shared<Napi::ObjectReference>(Napi::Persistent(events.As<Napi::Object>()));
+  SRT_EPOLL_EVENT* fdsSet = (SRT_EPOLL_EVENT *)events.Data();
+  int fdsSetSize = (int)(events.ElementLength() / 2);
+
+  SRTAsyncJob* job = new SRTAsyncJob(env);
+  job->toleratedError = SRT_ETIMEOUT;
+  job->execute = [epid, msTimeOut, fdsSet, fdsSetSize, eventsRef]() {
+    int n = srt_epoll_uwait(epid, fdsSet, fdsSetSize, msTimeOut);
+    return n > fdsSetSize ? fdsSetSize : n;
+  };
+  job->complete = [](Napi::Env env, int n) -> Napi::Value {
+    return Napi::Number::New(env, n < 0 ? 0 : n);
+  };
+  return executor->Submit(env, epid, job);
+}
+
+Napi::Value NodeSRTAsync::SetLogLevel(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  int logLevel = info[0].As<Napi::Number>().Int32Value();
+
+  SRTAsyncJob* job = new SRTAsyncJob(env);
+  job->execute = [logLevel]() {
+    if (logLevel >= 0 && logLevel <= 7) {
+      srt_setloglevel(logLevel);
+      return 0;
+    }
+    return SRT_ERROR;
+  };
+  return executor->Submit(env, SRTExecutor::NO_KEY, job);
+}
+
+Napi::Value NodeSRTAsync::Stats(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  SRTSOCKET socket = info[0].As<Napi::Number>();
+  bool clear = info[1].As<Napi::Boolean>();
+
+  shared_ptr<SRT_TRACEBSTATS> stats = make_shared<SRT_TRACEBSTATS>();
+
+  SRTAsyncJob* job = new SRTAsyncJob(env);
+  job->execute = [socket, clear, stats]() {
+    return srt_bstats(socket, stats.get(), clear);
+  };
+  job->complete = [stats](Napi::Env env, int result) -> Napi::Value {
+    return StatsToObject(env, *stats);
+  };
+  return ExecutorFor(socket)->Submit(env, socket, job);
+}
+
+Napi::Value NodeSRTAsync::StatsInto(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  shared_ptr<vector<SRTSOCKET>> sockets = make_shared<vector<SRTSOCKET>>();
+  Napi::Float64Array rows;
+  if (!GetStatsIntoArgs(info, 0, *sockets, rows)) {
+    return RejectedWithPendingException(env);
+  }
+  bool clear = info.Length() > 2 && info[2].ToBoolean();
+
+  // written in place, the array is kept alive until then
+  shared_ptr<Napi::ObjectReference> rowsRef = make_shared<Napi::ObjectReference>(Napi::Persistent(rows.As<Napi::Object>()));
+  double* data = rows.Data();
+
+  SRTAsyncJob* job = new SRTAsyncJob(env);
+  job->execute = [sockets, data, clear, rowsRef]() {
+    return SampleStats(*sockets, data, clear);
+  };
+  return executor->Submit(env, SRTExecutor::NO_KEY, job);
+}
+
+Napi::Value NodeSRTAsync::SetTimingCallback(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+
+  if (info.Length() > 0 && info[0].IsFunction()) {
+    executor->SetTimingCallback(info[0].As<Napi::Function>());
+  } else {
+    executor->SetTimingCallback(Napi::Function());
+  }
+  return Napi::Number::New(env, 0);
+}
+
+Napi::Value NodeSRTAsync::Dispose(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  size_t dropped = executor->Shutdown(env);
+  dropped += ShutdownPacingExecutors(env, *pacingExecutors);
+  return Napi::Number::New(env, (double)dropped);
+}
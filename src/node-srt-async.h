@@ -0,0 +1,109 @@
+#pragma once
+
+#include <napi.h>
+
+#include <map>
+#include <memory>
+#include <mutex>
+
+#include "srt-executor.h"
+#include "ts-packetizer.h"
+
+/**
+ * Promise-based variant of the NodeSRT binding.
+ *
+ * Each call runs on an SRTExecutor thread picked by its socket (or epoll) id,
+ * so the main thread never blocks in SRT and calls on one socket stay in order.
+ */
+class NodeSRTAsync : public Napi::ObjectWrap<NodeSRTAsync> {
+  public:
+    static Napi::Object Init(Napi::Env env, Napi::Object exports);
+    NodeSRTAsync(const Napi::CallbackInfo& info);
+    ~NodeSRTAsync();
+
+  private:
+    static Napi::FunctionReference constructor;
+    Napi::Value CreateSocket(const Napi::CallbackInfo& info);
+    Napi::Value Bind(const Napi::CallbackInfo& info);
+    Napi::Value Listen(const Napi::CallbackInfo& info);
+    Napi::Value Connect(const Napi::CallbackInfo& info);
+    Napi::Value StartConnect(const Napi::CallbackInfo& info);
+    Napi::Value Accept(const Napi::CallbackInfo& info);
+    Napi::Value AcceptMany(const Napi::CallbackInfo& info);
+    Napi::Value SetStreamIdFilter(const Napi::CallbackInfo& info);
+    Napi::Value GetStreamIdFilterStats(const Napi::CallbackInfo& info);
+    Napi::Value Close(const Napi::CallbackInfo& info);
+    Napi::Value Read(const Napi::CallbackInfo& info);
+    Napi::Value ReadBatch(const Napi::CallbackInfo& info);
+    Napi::Value ReadInto(const Napi::CallbackInfo& info);
+    Napi::Value Write(const Napi::CallbackInfo& info);
+    Napi::Value WriteMany(const Napi::CallbackInfo& info);
+    Napi::Value WriteTs(const Napi::CallbackInfo& info);
+    Napi::Value SendFile(const Napi::CallbackInfo& info);
+    Napi::Value RecvFile(const Napi::CallbackInfo& info);
+    Napi::Value SetSockOpt(const Napi::CallbackInfo& info);
+    Napi::Value GetSockOpt(const Napi::CallbackInfo& info);
+    Napi::Value GetSockState(const Napi::CallbackInfo& info);
+    Napi::Value CreateGroup(const Napi::CallbackInfo& info);
+    Napi::Value ConnectGroup(const Napi::CallbackInfo& info);
+    Napi::Value GroupData(const Napi::CallbackInfo& info);
+
+    Napi::Value EpollCreate(const Napi::CallbackInfo& info);
+    Napi::Value EpollAddUsock(const Napi::CallbackInfo& info);
+    Napi::Value EpollUpdateUsock(const Napi::CallbackInfo& info);
+    Napi::Value EpollRemoveUsock(const Napi::CallbackInfo& info);
+    Napi::Value EpollClearUsocks(const Napi::CallbackInfo& info);
+    Napi::Value EpollSet(const Napi::CallbackInfo& info);
+    Napi::Value EpollRelease(const Napi::CallbackInfo& info);
+    Napi::Value EpollUWait(const Napi::CallbackInfo& info);
+    Napi::Value EpollUWaitInto(const Napi::CallbackInfo& info);
+
+    Napi::Value SetLogLevel(const Napi::CallbackInfo& info);
+
+    Napi::Value Stats(const Napi::CallbackInfo& info);
+    Napi::Value StatsInto(const Napi::CallbackInfo& info);
+
+    Napi::Value SetTimingCallback(const Napi::CallbackInfo& info);
+    Napi::Value Dispose(const Napi::CallbackInfo& info);
+
+    void Finalize(Napi::Env env) override;
+
+    /**
+     * Stream state of `writeTs`, kept per socket between calls.
+     * Calls normally run on the executor lane of their socket, and on its pacing thread
+     * once the socket was written with `pace`; the lock covers the switch over.
+     */
+    struct TsWriter {
+      std::mutex mutex;
+      TsPacketizer packetizer;
+      TsPacer pacer;
+    };
+
+    // shared with the jobs, which may outlive this object
+    struct TsWriters {
+      std::mutex mutex;
+      std::map<SRTSOCKET, std::shared_ptr<TsWriter>> writers;
+
+      std::shared_ptr<TsWriter> Get(SRTSOCKET socket);
+      void Erase(SRTSOCKET socket);
+    };
+
+    // one thread per socket written with `pace`, so that sleeping until a message
+    // is due never holds up the executor lanes the socket shares with others
+    typedef std::map<SRTSOCKET, std::unique_ptr<SRTExecutor>> PacingExecutors;
+
+    static size_t ShutdownPacingExecutors(Napi::Env env, PacingExecutors& executors);
+    // shuts the thread of `socket` down once nothing is queued on it anymore
+    static void ReleasePacingExecutor(Napi::Env env, PacingExecutors& executors, SRTSOCKET socket);
+
+    /**
+     * The pacing thread of a paced socket, so that all of its calls stay in order
+     * with its paced writes, or the shared executor.
+     */
+    SRTExecutor* ExecutorFor(SRTSOCKET socket);
+
+    std::unique_ptr<SRTExecutor> executor;
+    std::shared_ptr<TsWriters> tsWriters;
+    // only used on the main thread, shared with the completions of paced jobs
+    std::shared_ptr<PacingExecutors> pacingExecutors;
+};
@@ -0,0 +1,133 @@
+#include "node-srt-fan-out.h"
+
+#define DEFAULT_FANOUT_CAPACITY 2048
+
+Napi::FunctionReference NodeSRTFanOut::constructor;
+
+Napi::Object NodeSRTFanOut::Init(Napi::Env env, Napi::Object exports) {
+  Napi::HandleScope scope(env);
+
+  Napi::Function func = DefineClass(env, "SRTFanOut", {
+    InstanceMethod("addSubscriber", &NodeSRTFanOut::AddSubscriber),
+    InstanceMethod("removeSubscriber", &NodeSRTFanOut::RemoveSubscriber),
+    InstanceMethod("getStats", &NodeSRTFanOut::GetStats),
+    InstanceMethod("stop", &NodeSRTFanOut::Stop),
+
+    StaticValue("POLICY_DROP_OLDEST", Napi::Number::New(env, FanOut::POLICY_DROP_OLDEST)),
+    StaticValue("POLICY_DISCONNECT", Napi::Number::New(env, FanOut::POLICY_DISCONNECT)),
+    StaticValue("POLICY_SKIP_TO_KEYFRAME", Napi::Number::New(env, FanOut::POLICY_SKIP_TO_KEYFRAME)),
+  });
+
+  constructor = Napi::Persistent(func);
+  constructor.SuppressDestruct();
+
+  exports.Set("SRTFanOut", func);
+  return exports;
+}
+
+static bool GetPolicyArg(const Napi::CallbackInfo& info, size_t index, FanOut::Policy& policy) {
+  if (info.Length() <= index || info[index].IsUndefined()) {
+    return true;
+  }
+  int value = info[index].IsNumber() ? info[index].As<Napi::Number>().Int32Value() : -1;
+  if (value < 0 || value >= FanOut::POLICY_COUNT) {
+    Napi::TypeError::New(info.Env(), "Policy must be one of SRTFanOut.POLICY_*").ThrowAsJavaScriptException();
+    return false;
+  }
+  policy = (FanOut::Policy)value;
+  return true;
+}
+
+NodeSRTFanOut::NodeSRTFanOut(const Napi::CallbackInfo& info) : Napi::ObjectWrap<NodeSRTFanOut>(info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  SRTSOCKET source = info[0].As<Napi::Number>().Int32Value();
+  size_t capacity = info.Length() > 1 && info[1].IsNumber()
+    ? info[1].As<Napi::Number>().Uint32Value() : DEFAULT_FANOUT_CAPACITY;
+  policy = FanOut::POLICY_DROP_OLDEST;
+  if (!GetPolicyArg(info, 2, policy)) {
+    return;
+  }
+
+  srt_startup();
+  fanOut.reset(new FanOut(source, capacity, policy));
+}
+
+NodeSRTFanOut::~NodeSRTFanOut() {
+  if (fanOut) {
+    fanOut.reset();
+    srt_cleanup();
+  }
+}
+
+Napi::Value NodeSRTFanOut::AddSubscriber(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  Napi::Number socketValue = info[0].As<Napi::Number>();
+  FanOut::Policy subscriberPolicy = policy;
+  if (!GetPolicyArg(info, 1, subscriberPolicy)) {
+    return Napi::Number::New(env, SRT_ERROR);
+  }
+
+  if (!fanOut->AddSubscriber(socketValue.Int32Value(), subscriberPolicy)) {
+    Napi::Error::New(env, srt_getlasterror_str()).ThrowAsJavaScriptException();
+    return Napi::Number::New(env, SRT_ERROR);
+  }
+  return Napi::Number::New(env, 0);
+}
+
+Napi::Value NodeSRTFanOut::RemoveSubscriber(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  Napi::Number socketValue = info[0].As<Napi::Number>();
+  if (!fanOut->RemoveSubscriber(socketValue.Int32Value())) {
+    Napi::Error::New(env, "Not a subscriber").ThrowAsJavaScriptException();
+    return Napi::Number::New(env, SRT_ERROR);
+  }
+  return Napi::Number::New(env, 0);
+}
+
+static Napi::Object CountersToObject(Napi::Env env, const FanOut::Counters& counters) {
+  Napi::Object obj = Napi::Object::New(env);
+  obj.Set("packets", Napi::Number::New(env, (double)counters.packets));
+  obj.Set("bytes", Napi::Number::New(env, (double)counters.bytes));
+  obj.Set("drops", Napi::Number::New(env, (double)counters.drops));
+  return obj;
+}
+
+Napi::Value NodeSRTFanOut::GetStats(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  FanOut::Stats stats;
+  fanOut->GetStats(stats);
+
+  Napi::Object obj = Napi::Object::New(env);
+  obj.Set("packets", Napi::Number::New(env, (double)stats.counters.packets));
+  obj.Set("bytes", Napi::Number::New(env, (double)stats.counters.bytes));
+  obj.Set("drops", Napi::Number::New(env, (double)stats.counters.drops));
+  obj.Set("broken", Napi::Boolean::New(env, stats.broken));
+  Napi::Array subscribers = Napi::Array::New(env, stats.subscribers.size());
+  for (size_t i = 0; i < stats.subscribers.size(); i++) {
+    const FanOut::SubscriberStats& entry = stats.subscribers[i];
+    Napi::Object subscriber = CountersToObject(env, entry.counters);
+    subscriber.Set("socket", Napi::Number::New(env, entry.socket));
+    subscriber.Set("lag", Napi::Number::New(env, (double)entry.lag));
+    subscriber.Set("blocked", Napi::Boolean::New(env, entry.blocked));
+    subscriber.Set("disconnected", Napi::Boolean::New(env, entry.disconnected));
+    subscribers[i] = subscriber;
+  }
+  obj.Set("subscribers", subscribers);
+  return obj;
+}
+
+Napi::Value NodeSRTFanOut::Stop(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  fanOut->Stop();
+  return Napi::Number::New(env, 0);
+}
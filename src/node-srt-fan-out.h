@@ -0,0 +1,24 @@
+#pragma once
+
+#include <napi.h>
+
+#include <memory>
+
+#include "fan-out.h"
+
+class NodeSRTFanOut : public Napi::ObjectWrap<NodeSRTFanOut> {
+  public:
+    static Napi::Object Init(Napi::Env env, Napi::Object exports);
+    NodeSRTFanOut(const Napi::CallbackInfo& info);
+    ~NodeSRTFanOut();
+
+  private:
+    static Napi::FunctionReference constructor;
+    Napi::Value AddSubscriber(const Napi::CallbackInfo& info);
+    Napi::Value RemoveSubscriber(const Napi::CallbackInfo& info);
+    Napi::Value GetStats(const Napi::CallbackInfo& info);
+    Napi::Value Stop(const Napi::CallbackInfo& info);
+
+    std::unique_ptr<FanOut> fanOut;
+    FanOut::Policy policy;
+};
@@ -0,0 +1,123 @@
+#include "node-srt-relay.h"
+
+#include <vector>
+
+using namespace std;
+
+Napi::FunctionReference NodeSRTRelay::constructor;
+
+Napi::Object NodeSRTRelay::Init(Napi::Env env, Napi::Object exports) {
+  Napi::HandleScope scope(env);
+
+  Napi::Function func = DefineClass(env, "SRTRelay", {
+    InstanceMethod("addRoute", &NodeSRTRelay::AddRoute),
+    InstanceMethod("removeRoute", &NodeSRTRelay::RemoveRoute),
+    InstanceMethod("removeDestination", &NodeSRTRelay::RemoveDestination),
+    InstanceMethod("getRouteStats", &NodeSRTRelay::GetRouteStats),
+    InstanceMethod("stop", &NodeSRTRelay::Stop),
+  });
+
+  constructor = Napi::Persistent(func);
+  constructor.SuppressDestruct();
+
+  exports.Set("SRTRelay", func);
+  return exports;
+}
+
+NodeSRTRelay::NodeSRTRelay(const Napi::CallbackInfo& info) : Napi::ObjectWrap<NodeSRTRelay>(info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  srt_startup();
+  relay.reset(new Relay());
+}
+
+NodeSRTRelay::~NodeSRTRelay() {
+  relay.reset();
+  srt_cleanup();
+}
+
+static Napi::Object CountersToObject(Napi::Env env, const Relay::Counters& counters) {
+  Napi::Object obj = Napi::Object::New(env);
+  obj.Set("packets", Napi::Number::New(env, (double)counters.packets));
+  obj.Set("bytes", Napi::Number::New(env, (double)counters.bytes));
+  obj.Set("drops", Napi::Number::New(env, (double)counters.drops));
+  return obj;
+}
+
+Napi::Value NodeSRTRelay::AddRoute(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  Napi::Number sourceValue = info[0].As<Napi::Number>();
+  if (!info[1].IsArray()) {
+    Napi::TypeError::New(env, "Destinations must be an array of sockets").ThrowAsJavaScriptException();
+    return Napi::Number::New(env, SRT_ERROR);
+  }
+  Napi::Array destinationsValue = info[1].As<Napi::Array>();
+  vector<SRTSOCKET> destinations(destinationsValue.Length());
+  for (uint32_t i = 0; i < destinationsValue.Length(); i++) {
+    destinations[i] = destinationsValue.Get(i).As<Napi::Number>().Int32Value();
+  }
+
+  if (!relay->AddRoute(sourceValue.Int32Value(), destinations)) {
+    Napi::Error::New(env, srt_getlasterror_str()).ThrowAsJavaScriptException();
+    return Napi::Number::New(env, SRT_ERROR);
+  }
+  return Napi::Number::New(env, 0);
+}
+
+Napi::Value NodeSRTRelay::RemoveRoute(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  Napi::Number sourceValue = info[0].As<Napi::Number>();
+  if (!relay->RemoveRoute(sourceValue.Int32Value())) {
+    Napi::Error::New(env, "No route from this socket").ThrowAsJavaScriptException();
+    return Napi::Number::New(env, SRT_ERROR);
+  }
+  return Napi::Number::New(env, 0);
+}
+
+Napi::Value NodeSRTRelay::RemoveDestination(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  Napi::Number sourceValue = info[0].As<Napi::Number>();
+  Napi::Number destinationValue = info[1].As<Napi::Number>();
+  if (!relay->RemoveDestination(sourceValue.Int32Value(), destinationValue.Int32Value())) {
+    Napi::Error::New(env, "No route from this socket to the destination").ThrowAsJavaScriptException();
+    return Napi::Number::New(env, SRT_ERROR);
+  }
+  return Napi::Number::New(env, 0);
+}
+
+Napi::Value NodeSRTRelay::GetRouteStats(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  Napi::Number sourceValue = info[0].As<Napi::Number>();
+  Relay::Route route;
+  if (!relay->GetRoute(sourceValue.Int32Value(), route)) {
+    return env.Null();
+  }
+
+  Napi::Object obj = CountersToObject(env, route.counters);
+  obj.Set("broken", Napi::Boolean::New(env, route.broken));
+  Napi::Array destinations = Napi::Array::New(env, route.destinations.size());
+  for (size_t i = 0; i < route.destinations.size(); i++) {
+    Napi::Object destination = CountersToObject(env, route.destinations[i].counters);
+    destination.Set("socket", Napi::Number::New(env, route.destinations[i].socket));
+    destinations[i] = destination;
+  }
+  obj.Set("destinations", destinations);
+  return obj;
+}
+
+Napi::Value NodeSRTRelay::Stop(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  relay->Stop();
+  return Napi::Number::New(env, 0);
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <napi.h>
+
+#include <memory>
+
+#include "relay.h"
+
+class NodeSRTRelay : public Napi::ObjectWrap<NodeSRTRelay> {
+  public:
+    static Napi::Object Init(Napi::Env env, Napi::Object exports);
+    NodeSRTRelay(const Napi::CallbackInfo& info);
+    ~NodeSRTRelay();
+
+  private:
+    static Napi::FunctionReference constructor;
+    Napi::Value AddRoute(const Napi::CallbackInfo& info);
+    Napi::Value RemoveRoute(const Napi::CallbackInfo& info);
+    Napi::Value RemoveDestination(const Napi::CallbackInfo& info);
+    Napi::Value GetRouteStats(const Napi::CallbackInfo& info);
+    Napi::Value Stop(const Napi::CallbackInfo& info);
+
+    std::unique_ptr<Relay> relay;
+};
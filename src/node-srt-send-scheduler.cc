@@ -0,0 +1,181 @@
+#include "node-srt-send-scheduler.h"
+
+#include <algorithm>
+
+#define DEFAULT_LATE_THRESHOLD_US 1000
+#define DEFAULT_BURST_BYTES (10 * SRT_LIVE_DEF_PLSIZE)
+#define DEFAULT_MAX_QUEUE_BYTES (8 * 1024 * 1024)
+
+Napi::FunctionReference NodeSRTSendScheduler::constructor;
+
+Napi::Object NodeSRTSendScheduler::Init(Napi::Env env, Napi::Object exports) {
+  Napi::HandleScope scope(env);
+
+  Napi::Function func = DefineClass(env, "SRTSendScheduler", {
+    InstanceMethod("configure", &NodeSRTSendScheduler::Configure),
+    InstanceMethod("enqueue", &NodeSRTSendScheduler::Enqueue),
+    InstanceMethod("remove", &NodeSRTSendScheduler::Remove),
+    InstanceMethod("getMetrics", &NodeSRTSendScheduler::GetMetrics),
+    InstanceMethod("whenQueueBelow", &NodeSRTSendScheduler::WhenQueueBelow),
+    InstanceMethod("stop", &NodeSRTSendScheduler::Stop),
+  });
+
+  constructor = Napi::Persistent(func);
+  constructor.SuppressDestruct();
+
+  exports.Set("SRTSendScheduler", func);
+  return exports;
+}
+
+NodeSRTSendScheduler::NodeSRTSendScheduler(const Napi::CallbackInfo& info) : Napi::ObjectWrap<NodeSRTSendScheduler>(info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  int64_t lateThresholdUs = info.Length() > 0 && info[0].IsNumber()
+    ? info[0].As<Napi::Number>().Int64Value() : DEFAULT_LATE_THRESHOLD_US;
+
+  drainWaiters = std::make_shared<DrainWaiters>();
+  Napi::Function noop = Napi::Function::New(env, [](const Napi::CallbackInfo& info) {});
+  drainWaiters->tsfn = Napi::ThreadSafeFunction::New(env, noop, "SRTSendSchedulerDrain", 0, 1);
+  drainWaiters->tsfn.Unref(env);
+
+  std::shared_ptr<DrainWaiters> waiters = drainWaiters;
+  Napi::ThreadSafeFunction tsfn = drainWaiters->tsfn;
+  srt_startup();
+  scheduler.reset(new SendScheduler(lateThresholdUs, [tsfn, waiters](SRTSOCKET socket) {
+    tsfn.NonBlockingCall([waiters, socket](Napi::Env env, Napi::Function callback) {
+      waiters->Resolve(env, socket);
+    });
+  }));
+}
+
+NodeSRTSendScheduler::~NodeSRTSendScheduler() {
+  // joins the thread, so nothing calls the thread-safe function anymore
+  scheduler.reset();
+  drainWaiters->tsfn.Release();
+  srt_cleanup();
+}
+
+void NodeSRTSendScheduler::DrainWaiters::Add(Napi::Env env, SRTSOCKET socket, Napi::Promise::Deferred deferred) {
+  bySocket[socket].push_back(deferred);
+  if (count++ == 0) {
+    tsfn.Ref(env);
+  }
+}
+
+void NodeSRTSendScheduler::DrainWaiters::Resolve(Napi::Env env, SRTSOCKET socket) {
+  auto it = bySocket.find(socket);
+  if (it == bySocket.end()) {
+    return;
+  }
+  std::vector<Napi::Promise::Deferred> deferreds;
+  deferreds.swap(it->second);
+  bySocket.erase(it);
+  count -= deferreds.size();
+  if (count == 0) {
+    tsfn.Unref(env);
+  }
+  for (Napi::Promise::Deferred& deferred : deferreds) {
+    deferred.Resolve(env.Undefined());
+  }
+}
+
+void NodeSRTSendScheduler::DrainWaiters::ResolveAll(Napi::Env env) {
+  while (!bySocket.empty()) {
+    Resolve(env, bySocket.begin()->first);
+  }
+}
+
+Napi::Value NodeSRTSendScheduler::Configure(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  Napi::Number socketValue = info[0].As<Napi::Number>();
+  Napi::Number bitrateValue = info[1].As<Napi::Number>();
+  size_t burstBytes = info.Length() > 2 && info[2].IsNumber()
+    ? info[2].As<Napi::Number>().Uint32Value() : DEFAULT_BURST_BYTES;
+  size_t maxQueueBytes = info.Length() > 3 && info[3].IsNumber()
+    ? info[3].As<Napi::Number>().Uint32Value() : DEFAULT_MAX_QUEUE_BYTES;
+
+  if (bitrateValue.DoubleValue() <= 0) {
+    Napi::RangeError::New(env, "Bitrate must be positive").ThrowAsJavaScriptException();
+    return Napi::Number::New(env, SRT_ERROR);
+  }
+  if (!scheduler->Configure(socketValue.Int32Value(), bitrateValue.DoubleValue(), burstBytes, maxQueueBytes)) {
+    Napi::Error::New(env, srt_getlasterror_str()).ThrowAsJavaScriptException();
+    return Napi::Number::New(env, SRT_ERROR);
+  }
+  return Napi::Number::New(env, 0);
+}
+
+Napi::Value NodeSRTSendScheduler::Enqueue(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  Napi::Number socketValue = info[0].As<Napi::Number>();
+  Napi::Buffer<char> buffer = info[1].As<Napi::Buffer<char>>();
+  int payloadSize = info.Length() > 2 && info[2].IsNumber()
+    ? info[2].As<Napi::Number>().Int32Value() : SRT_LIVE_DEF_PLSIZE;
+
+  size_t queued = scheduler->Enqueue(socketValue.Int32Value(), buffer.Data(), buffer.Length(), payloadSize);
+  return Napi::Number::New(env, (double)queued);
+}
+
+Napi::Value NodeSRTSendScheduler::Remove(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  Napi::Number socketValue = info[0].As<Napi::Number>();
+  scheduler->Remove(socketValue.Int32Value());
+  drainWaiters->Resolve(env, socketValue.Int32Value());
+  return Napi::Number::New(env, 0);
+}
+
+Napi::Value NodeSRTSendScheduler::GetMetrics(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  Napi::Number socketValue = info[0].As<Napi::Number>();
+  SendScheduler::Metrics metrics;
+  if (!scheduler->GetMetrics(socketValue.Int32Value(), metrics)) {
+    return env.Null();
+  }
+
+  Napi::Object obj = Napi::Object::New(env);
+  obj.Set("queuedBytes", Napi::Number::New(env, (double)metrics.queuedBytes));
+  obj.Set("queuedMessages", Napi::Number::New(env, (double)metrics.queuedMessages));
+  obj.Set("sentBytes", Napi::Number::New(env, (double)metrics.sentBytes));
+  obj.Set("sentMessages", Napi::Number::New(env, (double)metrics.sentMessages));
+  obj.Set("lateSends", Napi::Number::New(env, (double)metrics.lateSends));
+  obj.Set("maxLateUs", Napi::Number::New(env, metrics.maxLateUs));
+  obj.Set("meanLateUs", Napi::Number::New(env, metrics.meanLateUs));
+  obj.Set("broken", Napi::Boolean::New(env, metrics.broken));
+  return obj;
+}
+
+Napi::Value NodeSRTSendScheduler::WhenQueueBelow(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  Napi::Number socketValue = info[0].As<Napi::Number>();
+  int64_t queuedBytes = info.Length() > 1 && info[1].IsNumber()
+    ? info[1].As<Napi::Number>().Int64Value() : 0;
+
+  Napi::Promise::Deferred deferred = Napi::Promise::Deferred::New(env);
+  // a drain reported from now on is only handled after this call returns
+  if (scheduler->WatchDrain(socketValue.Int32Value(), (uint64_t)std::max<int64_t>(queuedBytes, 0))) {
+    drainWaiters->Add(env, socketValue.Int32Value(), deferred);
+  } else {
+    deferred.Resolve(env.Undefined());
+  }
+  return deferred.Promise();
+}
+
+Napi::Value NodeSRTSendScheduler::Stop(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  scheduler->Stop();
+  drainWaiters->ResolveAll(env);
+  return Napi::Number::New(env, 0);
+}
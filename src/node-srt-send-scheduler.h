@@ -0,0 +1,41 @@
+#pragma once
+
+#include <napi.h>
+
+#include <map>
+#include <memory>
+#include <vector>
+
+#include "send-scheduler.h"
+
+class NodeSRTSendScheduler : public Napi::ObjectWrap<NodeSRTSendScheduler> {
+  public:
+    static Napi::Object Init(Napi::Env env, Napi::Object exports);
+    NodeSRTSendScheduler(const Napi::CallbackInfo& info);
+    ~NodeSRTSendScheduler();
+
+  private:
+    static Napi::FunctionReference constructor;
+    Napi::Value Configure(const Napi::CallbackInfo& info);
+    Napi::Value Enqueue(const Napi::CallbackInfo& info);
+    Napi::Value Remove(const Napi::CallbackInfo& info);
+    Napi::Value GetMetrics(const Napi::CallbackInfo& info);
+    Napi::Value WhenQueueBelow(const Napi::CallbackInfo& info);
+    Napi::Value Stop(const Napi::CallbackInfo& info);
+
+    // promises of whenQueueBelow, only used on the main thread,
+    // shared with the drain calls queued on the thread-safe function
+    struct DrainWaiters {
+      std::map<SRTSOCKET, std::vector<Napi::Promise::Deferred>> bySocket;
+      size_t count = 0;
+      // only keeps the process alive while a drain is awaited
+      Napi::ThreadSafeFunction tsfn;
+
+      void Add(Napi::Env env, SRTSOCKET socket, Napi::Promise::Deferred deferred);
+      void Resolve(Napi::Env env, SRTSOCKET socket);
+      void ResolveAll(Napi::Env env);
+    };
+
+    std::shared_ptr<DrainWaiters> drainWaiters;
+    std::unique_ptr<SendScheduler> scheduler;
+};
@@ -0,0 +1,99 @@
+#include "node-srt-stats-sampler.h"
+
+#define DEFAULT_SAMPLE_INTERVAL_MS 100
+#define DEFAULT_SAMPLE_WINDOW_SIZE 600
+
+Napi::FunctionReference NodeSRTStatsSampler::constructor;
+
+Napi::Object NodeSRTStatsSampler::Init(Napi::Env env, Napi::Object exports) {
+  Napi::HandleScope scope(env);
+
+  Napi::Function func = DefineClass(env, "SRTStatsSampler", {
+    InstanceMethod("add", &NodeSRTStatsSampler::Add),
+    InstanceMethod("remove", &NodeSRTStatsSampler::Remove),
+    InstanceMethod("query", &NodeSRTStatsSampler::Query),
+    InstanceMethod("stop", &NodeSRTStatsSampler::Stop),
+
+    StaticValue("METRIC_RTT", Napi::Number::New(env, StatsSampler::METRIC_RTT)),
+    StaticValue("METRIC_SEND_RATE", Napi::Number::New(env, StatsSampler::METRIC_SEND_RATE)),
+    StaticValue("METRIC_RECV_RATE", Napi::Number::New(env, StatsSampler::METRIC_RECV_RATE)),
+    StaticValue("METRIC_RCV_LOSS", Napi::Number::New(env, StatsSampler::METRIC_RCV_LOSS)),
+    StaticValue("METRIC_RETRANS", Napi::Number::New(env, StatsSampler::METRIC_RETRANS)),
+    StaticValue("METRIC_RCV_BUF", Napi::Number::New(env, StatsSampler::METRIC_RCV_BUF)),
+  });
+
+  constructor = Napi::Persistent(func);
+  constructor.SuppressDestruct();
+
+  exports.Set("SRTStatsSampler", func);
+  return exports;
+}
+
+NodeSRTStatsSampler::NodeSRTStatsSampler(const Napi::CallbackInfo& info) : Napi::ObjectWrap<NodeSRTStatsSampler>(info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  int intervalMs = info.Length() > 0 && info[0].IsNumber()
+    ? info[0].As<Napi::Number>().Int32Value() : DEFAULT_SAMPLE_INTERVAL_MS;
+  size_t windowSize = info.Length() > 1 && info[1].IsNumber()
+    ? info[1].As<Napi::Number>().Uint32Value() : DEFAULT_SAMPLE_WINDOW_SIZE;
+
+  srt_startup();
+  sampler.reset(new StatsSampler(intervalMs, windowSize));
+}
+
+NodeSRTStatsSampler::~NodeSRTStatsSampler() {
+  sampler.reset();
+  srt_cleanup();
+}
+
+Napi::Value NodeSRTStatsSampler::Add(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  Napi::Number socketValue = info[0].As<Napi::Number>();
+  sampler->Add(socketValue.Int32Value());
+  return Napi::Number::New(env, 0);
+}
+
+Napi::Value NodeSRTStatsSampler::Remove(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  Napi::Number socketValue = info[0].As<Napi::Number>();
+  sampler->Remove(socketValue.Int32Value());
+  return Napi::Number::New(env, 0);
+}
+
+Napi::Value NodeSRTStatsSampler::Query(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  Napi::Number socketValue = info[0].As<Napi::Number>();
+  Napi::Number metric = info[1].As<Napi::Number>();
+  size_t samples = info.Length() > 2 && info[2].IsNumber() ? info[2].As<Napi::Number>().Uint32Value() : 0;
+
+  StatsSampler::Summary summary;
+  if (!sampler->Query(socketValue.Int32Value(), (StatsSampler::Metric)metric.Int32Value(), samples, summary)) {
+    return env.Null();
+  }
+
+  Napi::Object obj = Napi::Object::New(env);
+  obj.Set("count", Napi::Number::New(env, (double)summary.count));
+  obj.Set("min", Napi::Number::New(env, summary.min));
+  obj.Set("max", Napi::Number::New(env, summary.max));
+  obj.Set("mean", Napi::Number::New(env, summary.mean));
+  obj.Set("p50", Napi::Number::New(env, summary.p50));
+  obj.Set("p95", Napi::Number::New(env, summary.p95));
+  obj.Set("p99", Napi::Number::New(env, summary.p99));
+  obj.Set("last", Napi::Number::New(env, summary.last));
+  return obj;
+}
+
+Napi::Value NodeSRTStatsSampler::Stop(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  sampler->Stop();
+  return Napi::Number::New(env, 0);
+}
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <napi.h>
+
+#include <memory>
+
+#include "stats-sampler.h"
+
+class NodeSRTStatsSampler : public Napi::ObjectWrap<NodeSRTStatsSampler> {
+  public:
+    static Napi::Object Init(Napi::Env env, Napi::Object exports);
+    NodeSRTStatsSampler(const Napi::CallbackInfo& info);
+    ~NodeSRTStatsSampler();
+
+  private:
+    static Napi::FunctionReference constructor;
+    Napi::Value Add(const Napi::CallbackInfo& info);
+    Napi::Value Remove(const Napi::CallbackInfo& info);
+    Napi::Value Query(const Napi::CallbackInfo& info);
+    Napi::Value Stop(const Napi::CallbackInfo& info);
+
+    std::unique_ptr<StatsSampler> sampler;
+};
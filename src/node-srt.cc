@@ -6,7 +6,16 @@
 #include <sys/syslog.h>
 #endif
 #include "node-srt.h"
+#include "buffer-pool.h"
+#include "srt-address.h"
 #include "srt-enums.h"
+#include "srt-group.h"
+#include "srt-io.h"
+#include "srt-values.h"
+#include "stream-id-filter.h"
+
+#include <cerrno>
+#include <cstring>
 
 using namespace std;
 
@@ -22,18 +31,41 @@ Napi::Object NodeSRT::Init(Napi::Env env, Napi::Object exports) {
     InstanceMethod("bind", &NodeSRT::Bind),
     InstanceMethod("listen", &NodeSRT::Listen),
     InstanceMethod("connect", &NodeSRT::Connect),
+    InstanceMethod("startConnect", &NodeSRT::StartConnect),
     InstanceMethod("accept", &NodeSRT::Accept),
+    InstanceMethod("acceptMany", &NodeSRT::AcceptMany),
+    InstanceMethod("setStreamIdFilter", &NodeSRT::SetStreamIdFilter),
+    InstanceMethod("getStreamIdFilterStats", &NodeSRT::GetStreamIdFilterStats),
     InstanceMethod("close", &NodeSRT::Close),
     InstanceMethod("read", &NodeSRT::Read),
+    InstanceMethod("readBatch", &NodeSRT::ReadBatch),
+    InstanceMethod("readInto", &NodeSRT::ReadInto),
     InstanceMethod("write", &NodeSRT::Write),
+    InstanceMethod("writeMany", &NodeSRT::WriteMany),
+    InstanceMethod("sendFile", &NodeSRT::SendFile),
+    InstanceMethod("recvFile", &NodeSRT::RecvFile),
     InstanceMethod("setSockOpt", &NodeSRT::SetSockOpt),
     InstanceMethod("getSockOpt", &NodeSRT::GetSockOpt),
     InstanceMethod("getSockState", &NodeSRT::GetSockState),
+    InstanceMethod("createGroup", &NodeSRT::CreateGroup),
+    InstanceMethod("connectGroup", &NodeSRT::ConnectGroup),
+    InstanceMethod("groupData", &NodeSRT::GroupData),
     InstanceMethod("epollCreate", &NodeSRT::EpollCreate),
     InstanceMethod("epollAddUsock", &NodeSRT::EpollAddUsock),
+    InstanceMethod("epollUpdateUsock", &NodeSRT::EpollUpdateUsock),
+    InstanceMethod("epollRemoveUsock", &NodeSRT::EpollRemoveUsock),
+    InstanceMethod("epollClearUsocks", &NodeSRT::EpollClearUsocks),
+    InstanceMethod("epollSet", &NodeSRT::EpollSet),
+    InstanceMethod("epollRelease", &NodeSRT::EpollRelease),
     InstanceMethod("epollUWait", &NodeSRT::EpollUWait),
+    InstanceMethod("epollUWaitInto", &NodeSRT::EpollUWaitInto),
+    InstanceMethod("epollWatch", &NodeSRT::EpollWatch),
+    InstanceMethod("epollUnwatch", &NodeSRT::EpollUnwatch),
     InstanceMethod("setLogLevel", &NodeSRT::SetLogLevel),
     InstanceMethod("stats", &NodeSRT::Stats),
+    InstanceMethod("statsInto", &NodeSRT::StatsInto),
+    InstanceMethod("setBufferPoolSize", &NodeSRT::SetBufferPoolSize),
+    InstanceMethod("getBufferPoolStats", &NodeSRT::GetBufferPoolStats),
 
     StaticValue("OK", Napi::Number::New(env, 0)),
     StaticValue("ERROR", Napi::Number::New(env, SRT_ERROR)),
@@ -45,11 +77,30 @@ Napi::Object NodeSRT::Init(Napi::Env env, Napi::Object exports) {
     // Socket status
     SOCKET_STATUS,
 
+    // Values of SRTO_TRANSTYPE
+    TRANSTYPES,
+
+    // Socket groups
+    GROUP_TYPES,
+    GROUP_MEMBER_STATUS,
+
+    // Layout of the msgctrl Float64Array
+    MSGCTRL_FIELDS,
+
+    // Row layout of statsInto
+    StaticValue("STATS_FIELDS", StatsFieldNames(env)),
+    StaticValue("STATS_FIELD_COUNT", Napi::Number::New(env, (double)STATS_FIELD_COUNT)),
+
     // Epoll options
     StaticValue("EPOLL_IN", Napi::Number::New(env, SRT_EPOLL_IN)),
     StaticValue("EPOLL_OUT", Napi::Number::New(env, SRT_EPOLL_OUT)),
     StaticValue("EPOLL_ERR", Napi::Number::New(env, SRT_EPOLL_ERR)),
     StaticValue("EPOLL_ET", Napi::Number::New(env, SRT_EPOLL_ET)),
+    StaticValue("EPOLL_UPDATE", Napi::Number::New(env, SRT_EPOLL_UPDATE)),
+
+    // Epoll flags
+    StaticValue("EPOLL_ENABLE_EMPTY", Napi::Number::New(env, SRT_EPOLL_ENABLE_EMPTY)),
+    StaticValue("EPOLL_ENABLE_OUTPUTCHECK", Napi::Number::New(env, SRT_EPOLL_ENABLE_OUTPUTCHECK)),
   });
 
   constructor = Napi::Persistent(func);
@@ -68,6 +119,10 @@ NodeSRT::NodeSRT(const Napi::CallbackInfo& info) : Napi::ObjectWrap<NodeSRT>(inf
 }
 
 NodeSRT::~NodeSRT() {
+  for (auto& entry : epollPumps) {
+    entry.second->Stop();
+  }
+  epollPumps.clear();
 
   srt_cleanup();
 }
@@ -102,17 +157,14 @@ Napi::Value NodeSRT::Bind(const Napi::CallbackInfo& info) {
   Napi::String address = info[1].As<Napi::String>();
   Napi::Number port = info[2].As<Napi::Number>();
 
-  struct sockaddr_in addr;
-  memset(&addr, 0, sizeof (addr));
-  addr.sin_family = AF_INET;
-  addr.sin_port = htons(uint32_t(port));
-  int result = inet_pton(AF_INET, std::string(address).c_str(), &addr.sin_addr);
-  if (result != 1) {
-    Napi::Error::New(env, "Failed to init addr.sin_addr").ThrowAsJavaScriptException();
-    return Napi::Number::New(env, result);
+  sockaddr_storage addr;
+  int addrLen;
+  if (!ToSockAddr(address, port.Int32Value(), addr, addrLen)) {
+    Napi::Error::New(env, "Invalid IPv4 or IPv6 address: " + address.Utf8Value()).ThrowAsJavaScriptException();
+    return Napi::Number::New(env, SRT_ERROR);
   }
 
-  result = srt_bind(socketId, (struct sockaddr *)&addr, sizeof(addr));
+  int result = srt_bind(socketId, (struct sockaddr *)&addr, addrLen);
   if (result == SRT_ERROR) {
     srt_close(socketId);
     Napi::Error::New(env, srt_getlasterror_str()).ThrowAsJavaScriptException();
@@ -145,14 +197,38 @@ Napi::Value NodeSRT::Connect(const Napi::CallbackInfo& info) {
   Napi::String host = info[1].As<Napi::String>();
   Napi::Number port = info[2].As<Napi::Number>();
 
-  struct sockaddr_in addr;
-  memset(&addr, 0, sizeof (addr));
-  addr.sin_family = AF_INET;
-  addr.sin_port = htons(uint32_t(port));
+  sockaddr_storage addr;
+  int addrLen;
+  if (!ToSockAddr(host, port.Int32Value(), addr, addrLen)) {
+    Napi::Error::New(env, "Invalid IPv4 or IPv6 address: " + host.Utf8Value()).ThrowAsJavaScriptException();
+    return Napi::Number::New(env, SRT_ERROR);
+  }
+
+  int result = srt_connect(socketValue, (struct sockaddr *)&addr, addrLen);
+  if (result == SRT_ERROR) {
+    srt_close(socketValue);
+    Napi::Error::New(env, srt_getlasterror_str()).ThrowAsJavaScriptException();
+    return Napi::Number::New(env, SRT_ERROR);
+  }
+  return Napi::Number::New(env, result);
+}
 
-  inet_pton(AF_INET, std::string(host).c_str(), &addr.sin_addr);
+Napi::Value NodeSRT::StartConnect(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
 
-  int result = srt_connect(socketValue, (struct sockaddr *)&addr, sizeof(addr));
+  Napi::Number socketValue = info[0].As<Napi::Number>();
+  Napi::String host = info[1].As<Napi::String>();
+  Napi::Number port = info[2].As<Napi::Number>();
+
+  sockaddr_storage addr;
+  int addrLen;
+  if (!ToSockAddr(host, port.Int32Value(), addr, addrLen)) {
+    Napi::Error::New(env, "Invalid IPv4 or IPv6 address: " + host.Utf8Value()).ThrowAsJavaScriptException();
+    return Napi::Number::New(env, SRT_ERROR);
+  }
+
+  int result = StartConnectSocket(socketValue, addr, addrLen);
   if (result == SRT_ERROR) {
     srt_close(socketValue);
     Napi::Error::New(env, srt_getlasterror_str()).ThrowAsJavaScriptException();
@@ -167,26 +243,78 @@ Napi::Value NodeSRT::Accept(const Napi::CallbackInfo& info) {
 
   Napi::Number socketValue = info[0].As<Napi::Number>();
 
-  sockaddr_in their_addr;
-  int addr_size = sizeof (sockaddr_in);
+  sockaddr_storage their_addr;
+  int addr_size = sizeof (their_addr);
 
+  // the listener stays open for further connections
   int their_fd = srt_accept(socketValue, (struct sockaddr *)&their_addr, &addr_size);
   if (their_fd == SRT_INVALID_SOCK) {
-    srt_close(socketValue);
-    socketValue = Napi::Number::New(env, SRT_INVALID_SOCK);
     Napi::Error::New(env, srt_getlasterror_str()).ThrowAsJavaScriptException();
     return Napi::Number::New(env, SRT_ERROR);
   }
-  srt_close(socketValue);
-  socketValue = Napi::Number::New(env, SRT_INVALID_SOCK);
   return Napi::Number::New(env, their_fd);
 }
 
+Napi::Value NodeSRT::AcceptMany(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  Napi::Number socketValue = info[0].As<Napi::Number>();
+  int maxSockets = info[1].As<Napi::Number>();
+  SockOptValues options;
+  if (!GetSockOptValuesArg(info, 2, options)) {
+    return Napi::Number::New(env, SRT_ERROR);
+  }
+
+  vector<AcceptedSocket> accepted;
+  if (::AcceptMany(socketValue, maxSockets, options, accepted) == SRT_ERROR) {
+    string err(string("srt_accept: ")
+      + string(srt_getlasterror_str()));
+    Napi::Error::New(env, err).ThrowAsJavaScriptException();
+    return Napi::Number::New(env, SRT_ERROR);
+  }
+  return AcceptedToArray(env, accepted);
+}
+
+Napi::Value NodeSRT::SetStreamIdFilter(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  Napi::Number socketValue = info[0].As<Napi::Number>();
+  vector<string> allow;
+  vector<string> deny;
+  if (!GetStreamIdFilterArgs(info, 1, allow, deny)) {
+    return Napi::Number::New(env, SRT_ERROR);
+  }
+
+  int result = StreamIdFilters::Shared().Set(socketValue, allow, deny);
+  if (result == SRT_ERROR) {
+    string err(string("srt_listen_callback: ")
+      + string(srt_getlasterror_str()));
+    Napi::Error::New(env, err).ThrowAsJavaScriptException();
+    return Napi::Number::New(env, SRT_ERROR);
+  }
+  return Napi::Number::New(env, result);
+}
+
+Napi::Value NodeSRT::GetStreamIdFilterStats(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  Napi::Number socketValue = info[0].As<Napi::Number>();
+  StreamIdFilters::Counters counters;
+  if (!StreamIdFilters::Shared().GetCounters(socketValue, counters)) {
+    return env.Null();
+  }
+  return StreamIdCountersToObject(env, counters);
+}
+
 Napi::Value NodeSRT::Close(const Napi::CallbackInfo& info) {
   Napi::Env env = info.Env();
   Napi::HandleScope scope(env);
 
   Napi::Number socketValue = info[0].As<Napi::Number>();
+  StreamIdFilters::Shared().Remove(socketValue);
   int result = srt_close(socketValue);
   if (result == SRT_ERROR) {
     Napi::Error::New(env, srt_getlasterror_str()).ThrowAsJavaScriptException();
@@ -202,26 +330,113 @@ Napi::Value NodeSRT::Read(const Napi::CallbackInfo& info) {
   Napi::Number socketValue = info[0].As<Napi::Number>();
   Napi::Number chunkSize = info[1].As<Napi::Number>();
 
+  Napi::Float64Array msgCtrlArray;
+  if (!GetMsgCtrlArg(info, 2, msgCtrlArray)) {
+    return Napi::Number::New(env, SRT_ERROR);
+  }
+  SRT_MSGCTRL mctrl;
+  srt_msgctrl_init(&mctrl);
+
   // Q: why not converting to `int` directly here?
   size_t bufferSize = uint32_t(chunkSize);
-  uint8_t *buffer = (uint8_t *)malloc(bufferSize);
-  memset(buffer, 0, bufferSize);
 
-  int nb = srt_recvmsg(socketValue, (char *)buffer, (int)bufferSize);
+  // MTU-sized reads are received into a pooled block that becomes the Buffer memory
+  BufferPool& pool = BufferPool::Shared();
+  char *block = pool.Acquire(bufferSize);
+  char *buffer = block != nullptr ? block : (char *)malloc(bufferSize);
+
+  int nb = srt_recvmsg2(socketValue, buffer, (int)bufferSize, msgCtrlArray.IsEmpty() ? nullptr : &mctrl);
   if (nb == SRT_ERROR) {
+    if (block != nullptr) {
+      pool.Release(block);
+    } else {
+      free(buffer);
+    }
+    // no data pending on a non-blocking socket, let the caller wait for readiness
+    if (srt_getlasterror(nullptr) == SRT_EASYNCRCV) {
+      return Napi::Number::New(env, SRT_ERROR);
+    }
     string err(string("srt_recvmsg: ")
       + string(srt_getlasterror_str()));
     Napi::Error::New(env, err).ThrowAsJavaScriptException();
     return Napi::Number::New(env, SRT_ERROR);
   }
 
+  if (!msgCtrlArray.IsEmpty()) {
+    MsgCtrlToArray(mctrl, msgCtrlArray.Data());
+  }
+
+  if (block != nullptr) {
+    return pool.ToBuffer(env, block, nb);
+  }
+
   // Q: why not using char as data/template type?
-  Napi::Value nbuff = Napi::Buffer<uint8_t>::Copy(env, buffer, nb);
+  Napi::Value nbuff = Napi::Buffer<uint8_t>::Copy(env, (uint8_t *)buffer, nb);
   free(buffer);
 
   return nbuff;
 }
 
+Napi::Value NodeSRT::ReadBatch(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  Napi::Number socketValue = info[0].As<Napi::Number>();
+  int maxMessages = info[1].As<Napi::Number>();
+  int maxBytes = info[2].As<Napi::Number>();
+
+  char *buffer = (char *)malloc(maxBytes > 0 ? maxBytes : 0);
+  vector<uint32_t> offsets;
+
+  int count = RecvBatch(socketValue, buffer, maxBytes, maxMessages, offsets);
+  if (count == SRT_ERROR) {
+    free(buffer);
+    string err(string("srt_recvmsg: ")
+      + string(srt_getlasterror_str()));
+    Napi::Error::New(env, err).ThrowAsJavaScriptException();
+    return Napi::Number::New(env, SRT_ERROR);
+  }
+
+  return RecvBatchToObject(env, buffer, offsets);
+}
+
+Napi::Value NodeSRT::ReadInto(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  Napi::Number socketValue = info[0].As<Napi::Number>();
+  Napi::Buffer<uint8_t> buffer = info[1].As<Napi::Buffer<uint8_t>>();
+  size_t offset = info.Length() > 2 && info[2].IsNumber() ? info[2].As<Napi::Number>().Uint32Value() : 0;
+
+  if (offset >= buffer.Length()) {
+    Napi::Error::New(env, "Offset is out of the buffer bounds").ThrowAsJavaScriptException();
+    return Napi::Number::New(env, SRT_ERROR);
+  }
+
+  Napi::Float64Array msgCtrlArray;
+  if (!GetMsgCtrlArg(info, 3, msgCtrlArray)) {
+    return Napi::Number::New(env, SRT_ERROR);
+  }
+  SRT_MSGCTRL mctrl;
+  srt_msgctrl_init(&mctrl);
+
+  int nb = srt_recvmsg2(socketValue, (char *)buffer.Data() + offset, (int)(buffer.Length() - offset),
+    msgCtrlArray.IsEmpty() ? nullptr : &mctrl);
+  if (nb == SRT_ERROR) {
+    if (srt_getlasterror(nullptr) == SRT_EASYNCRCV) {
+      return Napi::Number::New(env, SRT_ERROR);
+    }
+    string err(string("srt_recvmsg: ")
+      + string(srt_getlasterror_str()));
+    Napi::Error::New(env, err).ThrowAsJavaScriptException();
+    return Napi::Number::New(env, SRT_ERROR);
+  }
+  if (!msgCtrlArray.IsEmpty()) {
+    MsgCtrlToArray(mctrl, msgCtrlArray.Data());
+  }
+  return Napi::Number::New(env, nb);
+}
+
 Napi::Value NodeSRT::Write(const Napi::CallbackInfo& info) {
   Napi::Env env = info.Env();
   Napi::HandleScope scope(env);
@@ -231,72 +446,121 @@ Napi::Value NodeSRT::Write(const Napi::CallbackInfo& info) {
   // Q: why not using char as data/template type?
   Napi::Buffer<uint8_t> chunk = info[1].As<Napi::Buffer<uint8_t>>();
 
-  int result = srt_sendmsg2(socketValue, (const char *)chunk.Data(), chunk.Length(), nullptr);
+  // ttl, inorder and srctime go in, SRT fills in the sequence and message numbers
+  Napi::Float64Array msgCtrlArray;
+  if (!GetMsgCtrlArg(info, 2, msgCtrlArray)) {
+    return Napi::Number::New(env, SRT_ERROR);
+  }
+  SRT_MSGCTRL mctrl;
+  if (!msgCtrlArray.IsEmpty()) {
+    MsgCtrlFromArray(msgCtrlArray.Data(), mctrl);
+  }
+
+  int result = srt_sendmsg2(socketValue, (const char *)chunk.Data(), chunk.Length(),
+    msgCtrlArray.IsEmpty() ? nullptr : &mctrl);
   if (result == SRT_ERROR) {
     string err(string("srt_sendmsg2: ")
       + string(srt_getlasterror_str()));
     Napi::Error::New(env, err).ThrowAsJavaScriptException();
     return Napi::Number::New(env, SRT_ERROR);
   }
+  if (!msgCtrlArray.IsEmpty()) {
+    MsgCtrlToArray(mctrl, msgCtrlArray.Data());
+  }
   return Napi::Number::New(env, result);
 }
 
+Napi::Value NodeSRT::WriteMany(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  Napi::Number socketValue = info[0].As<Napi::Number>();
+  vector<SendPart> parts;
+  if (!GetSendPartsArg(info, 1, parts)) {
+    return Napi::Number::New(env, SRT_ERROR);
+  }
+  int payloadSize = info.Length() > 2 && info[2].IsNumber() ? info[2].As<Napi::Number>().Int32Value() : SRT_LIVE_DEF_PLSIZE;
+
+  int result = SendMany(socketValue, parts, payloadSize);
+  if (result == SRT_ERROR) {
+    string err(string("srt_sendmsg2: ")
+      + string(srt_getlasterror_str()));
+    Napi::Error::New(env, err).ThrowAsJavaScriptException();
+    return Napi::Number::New(env, SRT_ERROR);
+  }
+  return Napi::Number::New(env, result);
+}
+
+Napi::Value NodeSRT::SendFile(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  Napi::Number socketValue = info[0].As<Napi::Number>();
+  string path = info[1].As<Napi::String>();
+  int64_t offset = info[2].As<Napi::Number>().Int64Value();
+  int64_t size = info[3].As<Napi::Number>().Int64Value();
+  int blockSize = info.Length() > 4 && info[4].IsNumber() ? info[4].As<Napi::Number>().Int32Value() : FILE_TRANSFER_DEF_BLOCK;
+
+  int64_t result = SendFileRange(socketValue, path.c_str(), offset, size, blockSize);
+  if (result == SRT_ERROR) {
+    string err(string("srt_sendfile: ")
+      + string(srt_getlasterror_str()));
+    Napi::Error::New(env, err).ThrowAsJavaScriptException();
+    return Napi::Number::New(env, SRT_ERROR);
+  }
+  return Napi::Number::New(env, (double)result);
+}
+
+Napi::Value NodeSRT::RecvFile(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  Napi::Number socketValue = info[0].As<Napi::Number>();
+  string path = info[1].As<Napi::String>();
+  int64_t offset = info[2].As<Napi::Number>().Int64Value();
+  int64_t size = info[3].As<Napi::Number>().Int64Value();
+  int blockSize = info.Length() > 4 && info[4].IsNumber() ? info[4].As<Napi::Number>().Int32Value() : FILE_TRANSFER_DEF_BLOCK;
+
+  FILE* file = OpenRecvFile(path.c_str());
+  if (file == nullptr) {
+    string err(string("Can't open ") + path + ": " + strerror(errno));
+    Napi::Error::New(env, err).ThrowAsJavaScriptException();
+    return Napi::Number::New(env, SRT_ERROR);
+  }
+  int fileError = 0;
+  int64_t result = RecvFileRange(socketValue, file, offset, size, blockSize, fileError);
+  fclose(file);
+  if (result == SRT_ERROR) {
+    string err(fileError != 0
+      ? string("Can't write ") + path + ": " + strerror(fileError)
+      : string("srt_recv: ") + string(srt_getlasterror_str()));
+    Napi::Error::New(env, err).ThrowAsJavaScriptException();
+    return Napi::Number::New(env, SRT_ERROR);
+  }
+  return Napi::Number::New(env, (double)result);
+}
+
 Napi::Value NodeSRT::SetSockOpt(const Napi::CallbackInfo& info) {
   Napi::Env env = info.Env();
   Napi::HandleScope scope(env);
 
   Napi::Number socketValue = info[0].As<Napi::Number>();
   Napi::Number option = info[1].As<Napi::Number>();
-  int result = SRT_ERROR;
 
   if (info[2].IsEmpty()) {
       Napi::TypeError::New(env, "Value is empty").ThrowAsJavaScriptException();
       return env.Undefined();
   }
 
-  if (info[2].IsBigInt()) {
-    Napi::BigInt value = info[2].As<Napi::BigInt>();
-    int32_t optName = option;
-    bool lossless = true;
-    int64_t optValue = value.Int64Value(&lossless);
-    if (!lossless) {
-      Napi::Error::New(env, "BigInt value overflows int64_t").ThrowAsJavaScriptException();
-      return Napi::Number::New(env, SRT_ERROR);
-    }
-    result = srt_setsockflag(socketValue, (SRT_SOCKOPT) optName, &optValue, sizeof(int64_t));
-    if (result == SRT_ERROR) {
-      Napi::Error::New(env, srt_getlasterror_str()).ThrowAsJavaScriptException();
-      return Napi::Number::New(env, SRT_ERROR);
-    }
-  } else if (info[2].IsNumber()) {
-    Napi::Number value = info[2].As<Napi::Number>();
-    int32_t optName = option;
-    int optValue = value;
-    result = srt_setsockflag(socketValue, (SRT_SOCKOPT) optName, &optValue, sizeof(int));
-    if (result == SRT_ERROR) {
-      Napi::Error::New(env, srt_getlasterror_str()).ThrowAsJavaScriptException();
-      return Napi::Number::New(env, SRT_ERROR);
-    }
-  } else if (info[2].IsBoolean()) {
-    Napi::Boolean value = info[2].As<Napi::Boolean>();
-    int32_t optName = option;
-    bool optValue = value;
-    result = srt_setsockflag(socketValue, (SRT_SOCKOPT) optName, &optValue, sizeof(bool));
-    if (result == SRT_ERROR) {
-      Napi::Error::New(env, srt_getlasterror_str()).ThrowAsJavaScriptException();
-      return Napi::Number::New(env, SRT_ERROR);
-    }
-  } else if (info[2].IsString()) {
-      Napi::String value = info[2].As<Napi::String>();
-      int32_t optName = option;
-      std::string optValue = std::string(value);
-      result = srt_setsockflag(socketValue, (SRT_SOCKOPT) optName, optValue.c_str(), optValue.length());
-      if (result == SRT_ERROR) {
-        Napi::Error::New(env, srt_getlasterror_str()).ThrowAsJavaScriptException();
-        return Napi::Number::New(env, SRT_ERROR);
-      }
-  } else {
-    Napi::Error::New(env, "Unexpected argument type for srt_setsockflag").ThrowAsJavaScriptException();
+  SockOptValue value;
+  if (!SockOptValueFromJS(env, info[2], value)) {
+    return Napi::Number::New(env, SRT_ERROR);
+  }
+
+  int result = SetSockOptValue(socketValue, option, value);
+  if (result == SRT_ERROR) {
+    Napi::Error::New(env, srt_getlasterror_str()).ThrowAsJavaScriptException();
+    return Napi::Number::New(env, SRT_ERROR);
   }
   return Napi::Number::New(env, result);
 }
@@ -309,102 +573,18 @@ Napi::Value NodeSRT::GetSockOpt(const Napi::CallbackInfo& info) {
   Napi::Number option = info[1].As<Napi::Number>();
 
   Napi::Value empty;
-  Napi::Value returnVal;
-
-  int32_t optName = option;
-  int result = SRT_ERROR;
-
-  switch((SRT_SOCKOPT)optName) {
-    case SRTO_INPUTBW:
-    case SRTO_MAXBW:
-    case SRTO_MININPUTBW:
-    {
-      int64_t optValue = 0;
-      int optSize = sizeof(optValue);
-      result = srt_getsockflag(socketValue, (SRT_SOCKOPT)optName, (void *)&optValue, &optSize);
-      if (result == SRT_ERROR) {
-        Napi::TypeError::New(env, "Failed to get SRT bandwidth option").ThrowAsJavaScriptException();
-        return env.Undefined();
-      }
-      returnVal = Napi::BigInt::New(env, optValue);
-      break;
-    }
-    case SRTO_MSS:
-    case SRTO_CONNTIMEO:
-    case SRTO_EVENT:
-    case SRTO_FC:
-    case SRTO_IPTOS:
-    case SRTO_ISN:
-    case SRTO_IPTTL:
-    case SRTO_IPV6ONLY:
-    case SRTO_KMREFRESHRATE:
-    case SRTO_KMPREANNOUNCE:
-    case SRTO_KMSTATE:
-    case SRTO_LATENCY:
-    case SRTO_LOSSMAXTTL:
-    case SRTO_MINVERSION:
-    case SRTO_OHEADBW:
-    case SRTO_PAYLOADSIZE:
-    case SRTO_PBKEYLEN:
-    case SRTO_PEERIDLETIMEO:
-    case SRTO_PEERLATENCY:
-    case SRTO_PEERVERSION:
-    case SRTO_RCVBUF:
-    case SRTO_RCVDATA:
-    case SRTO_RCVLATENCY:
-    case SRTO_RCVTIMEO:
-    case SRTO_SNDBUF:
-    case SRTO_SNDDATA:
-    case SRTO_SNDDROPDELAY:
-    case SRTO_SNDTIMEO:
-    case SRTO_STATE:
-    case SRTO_ENFORCEDENCRYPTION:
-    case SRTO_TLPKTDROP:
-    case SRTO_TSBPDMODE:
-    case SRTO_UDP_RCVBUF:
-    case SRTO_UDP_SNDBUF:
-    case SRTO_VERSION:
-    {
-      int optValue;
-      int optSize = sizeof(optValue);
-      result = srt_getsockflag(socketValue, (SRT_SOCKOPT)optName, (void *)&optValue, &optSize);
-      returnVal = Napi::Value::From(env, optValue);
-      break;
-    }
-    case SRTO_RCVSYN:
-    case SRTO_MESSAGEAPI:
-    case SRTO_NAKREPORT:
-    case SRTO_RENDEZVOUS:
-    case SRTO_SENDER:
-    case SRTO_SNDSYN:
-    {
-      bool optValue;
-      int optSize = sizeof(optValue);
-      result = srt_getsockflag(socketValue, (SRT_SOCKOPT)optName, (void *)&optValue, &optSize);
-      returnVal = Napi::Value::From(env, optValue);
-      break;
-    }
-    case SRTO_PACKETFILTER:
-    case SRTO_PASSPHRASE:
-    case SRTO_STREAMID:
-    {
-      char optValue[512];
-      int optSize = sizeof(optValue);
-      result = srt_getsockflag(socketValue, (SRT_SOCKOPT)optName, (void *)&optValue, &optSize);
-
-      returnVal = Napi::Value::From(env, std::string(optValue));
-      break;
-    }
-    default:
-      Napi::Error::New(env, "SOCKOPT not implemented yet").ThrowAsJavaScriptException();
-      break;
-  }
 
+  SockOptValue value;
+  int result = GetSockOptValue(socketValue, option, value);
+  if (value.type == SockOptValue::NONE) {
+    Napi::Error::New(env, "SOCKOPT not implemented yet").ThrowAsJavaScriptException();
+    return empty;
+  }
   if (result == SRT_ERROR) {
     Napi::Error::New(env, srt_getlasterror_str()).ThrowAsJavaScriptException();
     return empty;
   }
-  return returnVal;
+  return SockOptValueToJS(env, value);
 }
 
 Napi::Value NodeSRT::GetSockState(const Napi::CallbackInfo& info) {
@@ -415,6 +595,58 @@ Napi::Value NodeSRT::GetSockState(const Napi::CallbackInfo& info) {
   return Napi::Number::New(env, srt_getsockstate(socketValue));
 }
 
+Napi::Value NodeSRT::CreateGroup(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  Napi::Number type = info[0].As<Napi::Number>();
+
+  SRTSOCKET group = srt_create_group((SRT_GROUP_TYPE)type.Int32Value());
+  if (group == SRT_INVALID_SOCK) {
+    string err(string("srt_create_group: ")
+      + string(srt_getlasterror_str()));
+    Napi::Error::New(env, err).ThrowAsJavaScriptException();
+    return Napi::Number::New(env, SRT_ERROR);
+  }
+  return Napi::Number::New(env, group);
+}
+
+Napi::Value NodeSRT::ConnectGroup(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  Napi::Number groupValue = info[0].As<Napi::Number>();
+  vector<SRT_SOCKGROUPCONFIG> members;
+  if (!GetGroupEndpointsArg(info, 1, members)) {
+    return Napi::Number::New(env, SRT_ERROR);
+  }
+
+  // the group stays open on failure, so that it can be connected again
+  int result = srt_connect_group(groupValue, members.data(), (int)members.size());
+  if (result == SRT_ERROR) {
+    string err(string("srt_connect_group: ")
+      + string(srt_getlasterror_str()));
+    Napi::Error::New(env, err).ThrowAsJavaScriptException();
+    return Napi::Number::New(env, SRT_ERROR);
+  }
+  return Napi::Number::New(env, result);
+}
+
+Napi::Value NodeSRT::GroupData(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  Napi::Number groupValue = info[0].As<Napi::Number>();
+  vector<SRT_SOCKGROUPDATA> members;
+  if (GetGroupData(groupValue, members) == SRT_ERROR) {
+    string err(string("srt_group_data: ")
+      + string(srt_getlasterror_str()));
+    Napi::Error::New(env, err).ThrowAsJavaScriptException();
+    return Napi::Number::New(env, SRT_ERROR);
+  }
+  return GroupDataToArray(env, members);
+}
+
 Napi::Value NodeSRT::EpollCreate(const Napi::CallbackInfo& info) {
   Napi::Env env = info.Env();
   Napi::HandleScope scope(env);
@@ -444,6 +676,90 @@ Napi::Value NodeSRT::EpollAddUsock(const Napi::CallbackInfo& info) {
   return Napi::Number::New(env, result);
 }
 
+Napi::Value NodeSRT::EpollUpdateUsock(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  Napi::Number epidValue = info[0].As<Napi::Number>();
+  Napi::Number socketValue = info[1].As<Napi::Number>();
+  Napi::Number eventsValue = info[2].As<Napi::Number>();
+
+  int events = eventsValue;
+  int result = srt_epoll_update_usock(epidValue, socketValue, &events);
+  if (result == SRT_ERROR) {
+    Napi::Error::New(env, srt_getlasterror_str()).ThrowAsJavaScriptException();
+    return Napi::Number::New(env, SRT_ERROR);
+  }
+  return Napi::Number::New(env, result);
+}
+
+Napi::Value NodeSRT::EpollRemoveUsock(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  Napi::Number epidValue = info[0].As<Napi::Number>();
+  Napi::Number socketValue = info[1].As<Napi::Number>();
+
+  int result = srt_epoll_remove_usock(epidValue, socketValue);
+  if (result == SRT_ERROR) {
+    Napi::Error::New(env, srt_getlasterror_str()).ThrowAsJavaScriptException();
+    return Napi::Number::New(env, SRT_ERROR);
+  }
+  return Napi::Number::New(env, result);
+}
+
+Napi::Value NodeSRT::EpollClearUsocks(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  Napi::Number epidValue = info[0].As<Napi::Number>();
+
+  int result = srt_epoll_clear_usocks(epidValue);
+  if (result == SRT_ERROR) {
+    Napi::Error::New(env, srt_getlasterror_str()).ThrowAsJavaScriptException();
+    return Napi::Number::New(env, SRT_ERROR);
+  }
+  return Napi::Number::New(env, result);
+}
+
+Napi::Value NodeSRT::EpollSet(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  Napi::Number epidValue = info[0].As<Napi::Number>();
+  Napi::Number flagsValue = info[1].As<Napi::Number>();
+
+  // returns the flags now set, -1 passed as flags only reads them
+  int32_t result = srt_epoll_set(epidValue, flagsValue.Int32Value());
+  if (result == SRT_ERROR && flagsValue.Int32Value() != -1) {
+    Napi::Error::New(env, srt_getlasterror_str()).ThrowAsJavaScriptException();
+    return Napi::Number::New(env, SRT_ERROR);
+  }
+  return Napi::Number::New(env, result);
+}
+
+Napi::Value NodeSRT::EpollRelease(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  Napi::Number epidValue = info[0].As<Napi::Number>();
+  int epid = epidValue;
+
+  // a pump must not wait on a released epoll
+  auto it = epollPumps.find(epid);
+  if (it != epollPumps.end()) {
+    it->second->Stop();
+    epollPumps.erase(it);
+  }
+
+  int result = srt_epoll_release(epid);
+  if (result == SRT_ERROR) {
+    Napi::Error::New(env, srt_getlasterror_str()).ThrowAsJavaScriptException();
+    return Napi::Number::New(env, SRT_ERROR);
+  }
+  return Napi::Number::New(env, result);
+}
+
 Napi::Value NodeSRT::EpollUWait(const Napi::CallbackInfo& info) {
   Napi::Env env = info.Env();
   Napi::HandleScope scope(env);
@@ -454,6 +770,15 @@ Napi::Value NodeSRT::EpollUWait(const Napi::CallbackInfo& info) {
   const int fdsSetSize = EPOLL_EVENTS_NUM_MAX;
   SRT_EPOLL_EVENT fdsSet[fdsSetSize];
   int n = srt_epoll_uwait(epidValue, fdsSet, fdsSetSize, msTimeOut);
+  if (n == SRT_ERROR) {
+    if (srt_getlasterror(nullptr) != SRT_ETIMEOUT) {
+      Napi::Error::New(env, srt_getlasterror_str()).ThrowAsJavaScriptException();
+      return Napi::Number::New(env, SRT_ERROR);
+    }
+    n = 0;
+  }
+  // more sockets may be ready than fit in the set, the rest is reported next time
+  n = min(n, fdsSetSize);
   Napi::Array events = Napi::Array::New(env, n);
   for(int i = 0; i < n; i++) {
     Napi::Object event = Napi::Object::New(env);
@@ -465,6 +790,71 @@ Napi::Value NodeSRT::EpollUWait(const Napi::CallbackInfo& info) {
   return events;
 }
 
+Napi::Value NodeSRT::EpollUWaitInto(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  Napi::Number epidValue = info[0].As<Napi::Number>();
+  Napi::Number msTimeOut = info[1].As<Napi::Number>();
+
+  Napi::Int32Array events;
+  if (!GetEpollEventsArg(info, 2, events)) {
+    return Napi::Number::New(env, SRT_ERROR);
+  }
+  int fdsSetSize = (int)(events.ElementLength() / 2);
+
+  // the pairs are laid out like SRT_EPOLL_EVENT, SRT writes them in place
+  int n = srt_epoll_uwait(epidValue, (SRT_EPOLL_EVENT *)events.Data(), fdsSetSize, msTimeOut.Int64Value());
+  if (n == SRT_ERROR) {
+    if (srt_getlasterror(nullptr) != SRT_ETIMEOUT) {
+      Napi::Error::New(env, srt_getlasterror_str()).ThrowAsJavaScriptException();
+      return Napi::Number::New(env, SRT_ERROR);
+    }
+    n = 0;
+  }
+  return Napi::Number::New(env, min(n, fdsSetSize));
+}
+
+Napi::Value NodeSRT::EpollWatch(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  Napi::Number epidValue = info[0].As<Napi::Number>();
+  int epid = epidValue;
+
+  if (!info[1].IsFunction()) {
+    Napi::TypeError::New(env, "Callback must be a function").ThrowAsJavaScriptException();
+    return Napi::Number::New(env, SRT_ERROR);
+  }
+  if (epollPumps.count(epid)) {
+    Napi::Error::New(env, "Epoll is already watched").ThrowAsJavaScriptException();
+    return Napi::Number::New(env, SRT_ERROR);
+  }
+
+  std::shared_ptr<EpollPump> pump = EpollPump::Start(env, epid, info[1].As<Napi::Function>());
+  if (!pump) {
+    return Napi::Number::New(env, SRT_ERROR);
+  }
+  epollPumps[epid] = pump;
+  return Napi::Number::New(env, 0);
+}
+
+Napi::Value NodeSRT::EpollUnwatch(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  Napi::Number epidValue = info[0].As<Napi::Number>();
+  int epid = epidValue;
+
+  auto it = epollPumps.find(epid);
+  if (it == epollPumps.end()) {
+    return Napi::Number::New(env, SRT_ERROR);
+  }
+  it->second->Stop();
+  epollPumps.erase(it);
+  return Napi::Number::New(env, 0);
+}
+
 Napi::Value NodeSRT::SetLogLevel(const Napi::CallbackInfo& info) {
   Napi::Env env = info.Env();
   Napi::HandleScope scope(env);
@@ -494,98 +884,39 @@ Napi::Value NodeSRT::Stats(const Napi::CallbackInfo& info) {
     return Napi::Number::New(env, SRT_ERROR);
 	}
 
-  Napi::Object obj = Napi::Object::New(env);
-
-  // global measurements
-  obj.Set("msTimeStamp", stats.msTimeStamp);
-  obj.Set("pktSentTotal", stats.pktSentTotal);
-  obj.Set("pktRecvTotal", stats.pktRecvTotal);
-  obj.Set("pktSndLossTotal", stats.pktSndLossTotal);
-  obj.Set("pktRcvLossTotal", stats.pktRcvLossTotal);
-  obj.Set("pktRetransTotal", stats.pktRetransTotal);
-  obj.Set("pktSentACKTotal", stats.pktSentACKTotal);
-  obj.Set("pktRecvACKTotal", stats.pktRecvACKTotal);
-  obj.Set("pktSentNAKTotal", stats.pktSentNAKTotal);
-  obj.Set("pktRecvNAKTotal", stats.usSndDurationTotal);
-  obj.Set("pktSndDropTotal", stats.pktSndDropTotal);
-  obj.Set("pktRcvDropTotal", stats.pktRcvDropTotal);
-  obj.Set("pktRcvUndecryptTotal", stats.pktRcvUndecryptTotal);
-  obj.Set("byteSentTotal", stats.byteSentTotal);
-  obj.Set("byteRecvTotal", stats.byteRecvTotal);
-  obj.Set("byteRcvLossTotal", stats.byteRcvLossTotal);
-  obj.Set("byteRetransTotal", stats.byteRetransTotal);
-  obj.Set("byteSndDropTotal", stats.byteSndDropTotal);
-  obj.Set("byteRcvDropTotal", stats.byteRcvDropTotal);
-  obj.Set("byteRcvUndecryptTotal", stats.byteRcvUndecryptTotal);
-
-  // local measurements
-  obj.Set("pktSent", stats.pktSent);
-  obj.Set("pktRecv", stats.pktRecv);
-  obj.Set("pktSndLoss", stats.pktSndLoss);
-  obj.Set("pktRcvLoss", stats.pktRcvLoss);
-  obj.Set("pktRetrans", stats.pktRetrans);
-  obj.Set("pktRcvRetrans", stats.pktRcvRetrans);
-  obj.Set("pktSentACK", stats.pktSentACK);
-  obj.Set("pktRecvACK", stats.pktRecvACK);
-  obj.Set("pktSentNAK", stats.pktSentNAK);
-  obj.Set("pktRecvNAK", stats.pktRecvNAK);
-  obj.Set("mbpsSendRate", stats.mbpsSendRate);
-  obj.Set("mbpsRecvRate", stats.mbpsRecvRate);
-  obj.Set("usSndDuration", stats.usSndDuration);
-  obj.Set("pktReorderDistance", stats.pktReorderDistance);
-  obj.Set("pktRcvAvgBelatedTime", stats.pktRcvAvgBelatedTime);
-  obj.Set("pktRcvBelated", stats.pktRcvBelated);
-  obj.Set("pktSndDrop", stats.pktSndDrop);
-  obj.Set("pktRcvDrop", stats.pktRcvDrop);
-  obj.Set("pktRcvUndecrypt", stats.pktRcvUndecrypt);
-  obj.Set("byteSent", stats.byteSent);
-  obj.Set("byteRecv", stats.byteRecv);
-  obj.Set("byteRcvLoss", stats.byteRcvLoss);
-  obj.Set("byteRetrans", stats.byteRetrans);
-  obj.Set("byteSndDrop", stats.byteSndDrop);
-  obj.Set("byteRcvDrop", stats.byteRcvDrop);
-  obj.Set("byteRcvUndecrypt", stats.byteRcvUndecrypt);
-
-  // instant measurements
-  obj.Set("usPktSndPeriod", stats.usPktSndPeriod);
-  obj.Set("pktFlowWindow", stats.pktFlowWindow);
-  obj.Set("pktCongestionWindow", stats.pktCongestionWindow);
-  obj.Set("pktFlightSize", stats.pktFlightSize);
-  obj.Set("msRTT", stats.msRTT);
-  obj.Set("mbpsBandwidth", stats.mbpsBandwidth);
-  obj.Set("byteAvailSndBuf", stats.byteAvailSndBuf);
-  obj.Set("byteAvailRcvBuf", stats.byteAvailRcvBuf);
-  obj.Set("mbpsMaxBW", stats.mbpsMaxBW);
-  obj.Set("byteMSS", stats.byteMSS);
-  obj.Set("pktSndBuf", stats.pktSndBuf);
-  obj.Set("byteSndBuf", stats.byteSndBuf);
-  obj.Set("msSndBuf", stats.msSndBuf);
-  obj.Set("msSndTsbPdDelay", stats.msSndTsbPdDelay);
-  obj.Set("pktRcvBuf", stats.pktRcvBuf);
-  obj.Set("byteRcvBuf", stats.byteRcvBuf);
-  obj.Set("msRcvBuf", stats.msRcvBuf);
-  obj.Set("msRcvTsbPdDelay", stats.msRcvTsbPdDelay);
-  obj.Set("pktSndFilterExtraTotal", stats.pktSndFilterExtraTotal);
-  obj.Set("pktRcvFilterExtraTotal", stats.pktRcvFilterExtraTotal);
-  obj.Set("pktRcvFilterSupplyTotal", stats.pktRcvFilterSupplyTotal);
-  obj.Set("pktRcvFilterLossTotal", stats.pktRcvFilterLossTotal);
-  obj.Set("pktSndFilterExtra", stats.pktSndFilterExtra);
-  obj.Set("pktRcvFilterExtra", stats.pktRcvFilterExtra);
-  obj.Set("pktRcvFilterSupply", stats.pktRcvFilterSupply);
-  obj.Set("pktRcvFilterLoss", stats.pktRcvFilterLoss);
-  obj.Set("pktReorderTolerance", stats.pktReorderTolerance);
-
-  // Total
-  obj.Set("pktSentUniqueTotal", stats.pktSentUniqueTotal);
-  obj.Set("pktRecvUniqueTotal", stats.pktRecvUniqueTotal);
-  obj.Set("byteSentUniqueTotal", stats.byteSentUniqueTotal);
-  obj.Set("byteRecvUniqueTotal", stats.byteRecvUniqueTotal);
-
-  // Local
-  obj.Set("pktSentUnique", stats.pktSentUnique);
-  obj.Set("pktRecvUnique", stats.pktRecvUnique);
-  obj.Set("byteSentUnique", stats.byteSentUnique);
-  obj.Set("byteRecvUnique", stats.byteRecvUnique);
-
-  return obj;
+  return StatsToObject(env, stats);
+}
+
+Napi::Value NodeSRT::StatsInto(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  vector<SRTSOCKET> sockets;
+  Napi::Float64Array rows;
+  if (!GetStatsIntoArgs(info, 0, sockets, rows)) {
+    return Napi::Number::New(env, SRT_ERROR);
+  }
+  bool clear = info.Length() > 2 && info[2].ToBoolean();
+
+  return Napi::Number::New(env, SampleStats(sockets, rows.Data(), clear));
+}
+
+Napi::Value NodeSRT::SetBufferPoolSize(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  Napi::Number maxBlocks = info[0].As<Napi::Number>();
+  if (maxBlocks.Int64Value() < 0) {
+    Napi::Error::New(env, "Buffer pool size can't be negative").ThrowAsJavaScriptException();
+    return Napi::Number::New(env, SRT_ERROR);
+  }
+  BufferPool::Shared().SetMaxBlocks((size_t)maxBlocks.Int64Value());
+  return Napi::Number::New(env, 0);
+}
+
+Napi::Value NodeSRT::GetBufferPoolStats(const Napi::CallbackInfo& info) {
+  Napi::Env env = info.Env();
+  Napi::HandleScope scope(env);
+
+  return BufferPoolStatsToObject(env, BufferPool::Shared().GetStats());
 }
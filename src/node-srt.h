@@ -1,5 +1,10 @@
 #include <napi.h>
 
+#include <map>
+#include <memory>
+
+#include "epoll-pump.h"
+
 class NodeSRT : public Napi::ObjectWrap<NodeSRT> {
   public:
     static Napi::Object Init(Napi::Env env, Napi::Object exports);
@@ -12,19 +17,46 @@ class NodeSRT : public Napi::ObjectWrap<NodeSRT> {
     Napi::Value Bind(const Napi::CallbackInfo& info);
     Napi::Value Listen(const Napi::CallbackInfo& info);
     Napi::Value Connect(const Napi::CallbackInfo& info);
+    Napi::Value StartConnect(const Napi::CallbackInfo& info);
     Napi::Value Accept(const Napi::CallbackInfo& info);
+    Napi::Value AcceptMany(const Napi::CallbackInfo& info);
+    Napi::Value SetStreamIdFilter(const Napi::CallbackInfo& info);
+    Napi::Value GetStreamIdFilterStats(const Napi::CallbackInfo& info);
     Napi::Value Close(const Napi::CallbackInfo& info);
     Napi::Value Read(const Napi::CallbackInfo& info);
+    Napi::Value ReadBatch(const Napi::CallbackInfo& info);
+    Napi::Value ReadInto(const Napi::CallbackInfo& info);
     Napi::Value Write(const Napi::CallbackInfo& info);
+    Napi::Value WriteMany(const Napi::CallbackInfo& info);
+    Napi::Value SendFile(const Napi::CallbackInfo& info);
+    Napi::Value RecvFile(const Napi::CallbackInfo& info);
     Napi::Value SetSockOpt(const Napi::CallbackInfo& info);
     Napi::Value GetSockOpt(const Napi::CallbackInfo& info);
     Napi::Value GetSockState(const Napi::CallbackInfo& info);
 
+    Napi::Value CreateGroup(const Napi::CallbackInfo& info);
+    Napi::Value ConnectGroup(const Napi::CallbackInfo& info);
+    Napi::Value GroupData(const Napi::CallbackInfo& info);
+
     Napi::Value EpollCreate(const Napi::CallbackInfo& info);
     Napi::Value EpollAddUsock(const Napi::CallbackInfo& info);
+    Napi::Value EpollUpdateUsock(const Napi::CallbackInfo& info);
+    Napi::Value EpollRemoveUsock(const Napi::CallbackInfo& info);
+    Napi::Value EpollClearUsocks(const Napi::CallbackInfo& info);
+    Napi::Value EpollSet(const Napi::CallbackInfo& info);
+    Napi::Value EpollRelease(const Napi::CallbackInfo& info);
     Napi::Value EpollUWait(const Napi::CallbackInfo& info);
+    Napi::Value EpollUWaitInto(const Napi::CallbackInfo& info);
+    Napi::Value EpollWatch(const Napi::CallbackInfo& info);
+    Napi::Value EpollUnwatch(const Napi::CallbackInfo& info);
 
     Napi::Value SetLogLevel(const Napi::CallbackInfo& info);
 
     Napi::Value Stats(const Napi::CallbackInfo& info);
+    Napi::Value StatsInto(const Napi::CallbackInfo& info);
+
+    Napi::Value SetBufferPoolSize(const Napi::CallbackInfo& info);
+    Napi::Value GetBufferPoolStats(const Napi::CallbackInfo& info);
+
+    std::map<int, std::shared_ptr<EpollPump>> epollPumps;
 };
@@ -0,0 +1,180 @@
+#include "relay.h"
+
+#include <algorithm>
+#include <chrono>
+#include <utility>
+
+#include "srt-io.h"
+
+using namespace std;
+
+// how long the thread waits before it looks at `running_` again
+#define RELAY_WAIT_MS 100
+#define RELAY_EVENTS_MAX 64
+#define RELAY_BATCH_MESSAGES 64
+
+Relay::Relay()
+  : epid_(srt_epoll_create()),
+    running_(true),
+    buffer_(RELAY_BATCH_MESSAGES * SRT_LIVE_MAX_PLSIZE) {
+  // wait out the timeout rather than fail while there is no route
+  srt_epoll_set(epid_, SRT_EPOLL_ENABLE_EMPTY);
+  thread_ = thread(&Relay::Run, this);
+}
+
+Relay::~Relay() {
+  Stop();
+  srt_epoll_release(epid_);
+}
+
+void Relay::Stop() {
+  running_ = false;
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+}
+
+bool Relay::AddRoute(SRTSOCKET source, const vector<SRTSOCKET>& destinations) {
+  lock_guard<mutex> lock(mutex_);
+  auto it = routes_.find(source);
+  bool added = it == routes_.end();
+  if (added) {
+    int events = SRT_EPOLL_IN | SRT_EPOLL_ERR;
+    if (srt_epoll_add_usock(epid_, source, &events) == SRT_ERROR) {
+      return false;
+    }
+  }
+
+  // a blocking send would hold the relay thread, and with it every route and the lock.
+  // Destinations already on the route were made non-blocking when they were added.
+  vector<pair<SRTSOCKET, bool>> changed;
+  bool failed = false;
+  for (SRTSOCKET socket : destinations) {
+    bool known = !added && any_of(it->second.destinations.begin(), it->second.destinations.end(),
+      [socket](const Destination& destination) { return destination.socket == socket; });
+    bool listed = any_of(changed.begin(), changed.end(),
+      [socket](const pair<SRTSOCKET, bool>& entry) { return entry.first == socket; });
+    if (known || listed) {
+      continue;
+    }
+    bool sndsyn = true;
+    int size = sizeof(sndsyn);
+    if (srt_getsockflag(socket, SRTO_SNDSYN, &sndsyn, &size) == SRT_ERROR) {
+      failed = true;
+      break;
+    }
+    bool nonBlocking = false;
+    if (srt_setsockflag(socket, SRTO_SNDSYN, &nonBlocking, sizeof(nonBlocking)) == SRT_ERROR) {
+      failed = true;
+      break;
+    }
+    changed.emplace_back(socket, sndsyn);
+  }
+
+  if (failed) {
+    // successful calls leave the error of the failed one for the caller
+    for (const pair<SRTSOCKET, bool>& entry : changed) {
+      bool sndsyn = entry.second;
+      srt_setsockflag(entry.first, SRTO_SNDSYN, &sndsyn, sizeof(sndsyn));
+    }
+    if (added) {
+      srt_epoll_remove_usock(epid_, source);
+    }
+    return false;
+  }
+
+  if (added) {
+    it = routes_.emplace(source, Route()).first;
+  }
+  for (const pair<SRTSOCKET, bool>& entry : changed) {
+    it->second.destinations.push_back(Destination{entry.first, Counters()});
+  }
+  return true;
+}
+
+bool Relay::RemoveRoute(SRTSOCKET source) {
+  lock_guard<mutex> lock(mutex_);
+  auto it = routes_.find(source);
+  if (it == routes_.end()) {
+    return false;
+  }
+  if (!it->second.broken) {
+    srt_epoll_remove_usock(epid_, source);
+  }
+  routes_.erase(it);
+  return true;
+}
+
+bool Relay::RemoveDestination(SRTSOCKET source, SRTSOCKET destination) {
+  lock_guard<mutex> lock(mutex_);
+  auto it = routes_.find(source);
+  if (it == routes_.end()) {
+    return false;
+  }
+  vector<Destination>& current = it->second.destinations;
+  auto found = find_if(current.begin(), current.end(),
+    [destination](const Destination& entry) { return entry.socket == destination; });
+  if (found == current.end()) {
+    return false;
+  }
+  current.erase(found);
+  return true;
+}
+
+bool Relay::GetRoute(SRTSOCKET source, Route& route) {
+  lock_guard<mutex> lock(mutex_);
+  auto it = routes_.find(source);
+  if (it == routes_.end()) {
+    return false;
+  }
+  route = it->second;
+  return true;
+}
+
+void Relay::Run() {
+  vector<SRT_EPOLL_EVENT> events(RELAY_EVENTS_MAX);
+  while (running_) {
+    int n = srt_epoll_uwait(epid_, events.data(), (int)events.size(), RELAY_WAIT_MS);
+    if (n <= 0) {
+      if (n == SRT_ERROR && srt_getlasterror(nullptr) != SRT_ETIMEOUT) {
+        this_thread::sleep_for(chrono::milliseconds(RELAY_WAIT_MS));
+      }
+      continue;
+    }
+    n = min(n, (int)events.size());
+
+    lock_guard<mutex> lock(mutex_);
+    for (int i = 0; i < n; i++) {
+      auto it = routes_.find(events[i].fd);
+      // removed while we were waiting
+      if (it == routes_.end() || it->second.broken) {
+        continue;
+      }
+      Forward(it->first, it->second);
+    }
+  }
+}
+
+void Relay::Forward(SRTSOCKET source, Route& route) {
+  int count = RecvBatch(source, buffer_.data(), (int)buffer_.size(), RELAY_BATCH_MESSAGES, offsets_);
+  if (count == SRT_ERROR) {
+    route.broken = true;
+    srt_epoll_remove_usock(epid_, source);
+    return;
+  }
+  for (int i = 0; i < count; i++) {
+    const char* message = buffer_.data() + offsets_[i];
+    int length = (int)(offsets_[i + 1] - offsets_[i]);
+    route.counters.packets++;
+    route.counters.bytes += length;
+    for (Destination& destination : route.destinations) {
+      if (srt_sendmsg2(destination.socket, message, length, nullptr) == SRT_ERROR) {
+        destination.counters.drops++;
+        route.counters.drops++;
+        continue;
+      }
+      destination.counters.packets++;
+      destination.counters.bytes += length;
+    }
+  }
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#if defined(_WIN32)
+#include <srt.h>
+#else
+#include <srt/srt.h>
+#endif
+
+/**
+ * Forwards every message received on a source socket, unchanged,
+ * to each of its destination sockets, on its own thread.
+ *
+ * Sources are waited on with one epoll and drained in batches (see `RecvBatch`).
+ * Destinations are made non-blocking. A message a destination doesn't take
+ * (full send buffer, broken connection) is counted as a drop rather than retried,
+ * so one slow destination never holds back the others.
+ */
+class Relay {
+  public:
+    struct Counters {
+      uint64_t packets = 0;
+      uint64_t bytes = 0;
+      uint64_t drops = 0;
+    };
+
+    struct Destination {
+      SRTSOCKET socket;
+      Counters counters;
+    };
+
+    struct Route {
+      Counters counters;        // received from the source, drops summed over destinations
+      bool broken = false;      // the source failed, the route stays until removed
+      std::vector<Destination> destinations;
+    };
+
+    Relay();
+    ~Relay();
+
+    /**
+     * Starts forwarding from `source`, or adds destinations to its route.
+     * New destinations are made non-blocking once the route can be made.
+     * Returns false, with the route and the destination flags left as they were,
+     * if the source can't be waited on or a destination can't be made non-blocking
+     * (srt_getlasterror tells why).
+     */
+    bool AddRoute(SRTSOCKET source, const std::vector<SRTSOCKET>& destinations);
+
+    bool RemoveRoute(SRTSOCKET source);
+    bool RemoveDestination(SRTSOCKET source, SRTSOCKET destination);
+
+    /**
+     * Copies the counters of a route, returns false if there is none from `source`.
+     */
+    bool GetRoute(SRTSOCKET source, Route& route);
+
+    void Stop();
+
+  private:
+    void Run();
+    void Forward(SRTSOCKET source, Route& route);
+
+    int epid_;
+    std::mutex mutex_;
+    std::atomic<bool> running_;
+    std::map<SRTSOCKET, Route> routes_;
+    std::vector<char> buffer_;
+    std::vector<uint32_t> offsets_;
+    std::thread thread_;
+};
@@ -0,0 +1,218 @@
+#include "send-scheduler.h"
+
+#include <algorithm>
+#include <cstring>
+
+using namespace std;
+
+// the thread stops sleeping this long before a message is due, and spins
+#define SCHEDULER_SPIN_US 100
+// how long a socket with a full send buffer waits before it is tried again
+#define SCHEDULER_RETRY_US 1000
+// messages sent to one socket before the others get their turn
+#define SCHEDULER_MAX_BURST_MESSAGES 64
+
+SendScheduler::SendScheduler(int64_t lateThresholdUs, DrainCallback onDrain)
+  : lateThresholdUs_(lateThresholdUs),
+    onDrain_(onDrain),
+    running_(true) {
+  thread_ = thread(&SendScheduler::Run, this);
+}
+
+SendScheduler::~SendScheduler() {
+  Stop();
+}
+
+void SendScheduler::Stop() {
+  {
+    lock_guard<mutex> lock(mutex_);
+    running_ = false;
+  }
+  cv_.notify_all();
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+}
+
+bool SendScheduler::Configure(SRTSOCKET socket, double bitsPerSecond, size_t burstBytes, size_t maxQueueBytes) {
+  bool sndsyn = false;
+  if (srt_setsockflag(socket, SRTO_SNDSYN, &sndsyn, sizeof(sndsyn)) == SRT_ERROR) {
+    return false;
+  }
+  {
+    lock_guard<mutex> lock(mutex_);
+    Clock::time_point now = Clock::now();
+    bool added = queues_.count(socket) == 0;
+    Queue& queue = queues_[socket];
+    if (!added) {
+      Refill(queue, now);
+    }
+    queue.bytesPerUs = bitsPerSecond / 8 / 1000000;
+    queue.burst = (double)max(burstBytes, (size_t)SRT_LIVE_MAX_PLSIZE);
+    queue.maxQueueBytes = maxQueueBytes;
+    queue.tokens = added ? queue.burst : min(queue.tokens, queue.burst);
+    queue.refilled = now;
+    queue.hasDue = false;
+  }
+  cv_.notify_all();
+  return true;
+}
+
+size_t SendScheduler::Enqueue(SRTSOCKET socket, const char* data, size_t length, int payloadSize) {
+  if (length == 0) {
+    return 0;
+  }
+  {
+    lock_guard<mutex> lock(mutex_);
+    auto it = queues_.find(socket);
+    if (it == queues_.end() || it->second.metrics.broken) {
+      return 0;
+    }
+    Queue& queue = it->second;
+    if (queue.metrics.queuedBytes + length > queue.maxQueueBytes) {
+      return 0;
+    }
+    if (payloadSize <= 0) {
+      payloadSize = SRT_LIVE_DEF_PLSIZE;
+    }
+    queue.chunks.push_back(Chunk{vector<char>(data, data + length), 0, payloadSize});
+    queue.metrics.queuedBytes += length;
+    queue.metrics.queuedMessages += (length + payloadSize - 1) / payloadSize;
+  }
+  cv_.notify_all();
+  return length;
+}
+
+bool SendScheduler::WatchDrain(SRTSOCKET socket, uint64_t queuedBytes) {
+  lock_guard<mutex> lock(mutex_);
+  auto it = queues_.find(socket);
+  if (!running_ || it == queues_.end()) {
+    return false;
+  }
+  Queue& queue = it->second;
+  if (queue.metrics.broken || queue.metrics.queuedBytes <= queuedBytes) {
+    return false;
+  }
+  queue.drainBytes = queue.watchDrain ? min(queue.drainBytes, queuedBytes) : queuedBytes;
+  queue.watchDrain = true;
+  return true;
+}
+
+void SendScheduler::NotifyDrain(SRTSOCKET socket, Queue& queue) {
+  queue.watchDrain = false;
+  if (onDrain_) {
+    onDrain_(socket);
+  }
+}
+
+bool SendScheduler::Remove(SRTSOCKET socket) {
+  lock_guard<mutex> lock(mutex_);
+  return queues_.erase(socket) > 0;
+}
+
+bool SendScheduler::GetMetrics(SRTSOCKET socket, Metrics& metrics) {
+  lock_guard<mutex> lock(mutex_);
+  auto it = queues_.find(socket);
+  if (it == queues_.end()) {
+    return false;
+  }
+  metrics = it->second.metrics;
+  return true;
+}
+
+void SendScheduler::Refill(Queue& queue, Clock::time_point now) {
+  double elapsedUs = chrono::duration<double, micro>(now - queue.refilled).count();
+  if (elapsedUs > 0) {
+    queue.tokens = min(queue.burst, queue.tokens + elapsedUs * queue.bytesPerUs);
+    queue.refilled = now;
+  }
+}
+
+void SendScheduler::SetDue(Queue& queue, Clock::time_point now) {
+  const Chunk& chunk = queue.chunks.front();
+  double size = (double)min((size_t)chunk.payloadSize, chunk.data.size() - chunk.sent);
+  Refill(queue, now);
+  queue.due = now;
+  if (queue.tokens < size && queue.bytesPerUs > 0) {
+    queue.due += chrono::microseconds((int64_t)((size - queue.tokens) / queue.bytesPerUs) + 1);
+  }
+  queue.retry = queue.due;
+  queue.hasDue = true;
+}
+
+bool SendScheduler::Send(SRTSOCKET socket, Queue& queue, Clock::time_point now) {
+  Chunk& chunk = queue.chunks.front();
+  int size = (int)min((size_t)chunk.payloadSize, chunk.data.size() - chunk.sent);
+  if (srt_sendmsg2(socket, chunk.data.data() + chunk.sent, size, nullptr) == SRT_ERROR) {
+    if (srt_getlasterror(nullptr) == SRT_EASYNCSND) {
+      queue.retry = now + chrono::microseconds(SCHEDULER_RETRY_US);
+      return false;
+    }
+    queue.metrics.broken = true;
+    queue.metrics.queuedBytes = 0;
+    queue.metrics.queuedMessages = 0;
+    queue.chunks.clear();
+    if (queue.watchDrain) {
+      NotifyDrain(socket, queue);
+    }
+    return false;
+  }
+
+  double lateUs = chrono::duration<double, micro>(now - queue.due).count();
+  Metrics& metrics = queue.metrics;
+  metrics.sentBytes += size;
+  metrics.sentMessages++;
+  metrics.queuedBytes -= size;
+  metrics.queuedMessages--;
+  if (lateUs > lateThresholdUs_) {
+    metrics.lateSends++;
+  }
+  metrics.maxLateUs = max(metrics.maxLateUs, lateUs);
+  queue.lateSumUs += lateUs;
+  metrics.meanLateUs = queue.lateSumUs / metrics.sentMessages;
+  if (queue.watchDrain && metrics.queuedBytes <= queue.drainBytes) {
+    NotifyDrain(socket, queue);
+  }
+
+  Refill(queue, now);
+  queue.tokens -= size;
+  chunk.sent += size;
+  if (chunk.sent == chunk.data.size()) {
+    queue.chunks.pop_front();
+  }
+  queue.hasDue = false;
+  return true;
+}
+
+void SendScheduler::Run() {
+  unique_lock<mutex> lock(mutex_);
+  while (running_) {
+    Clock::time_point now = Clock::now();
+    Clock::time_point next = Clock::time_point::max();
+    for (auto& entry : queues_) {
+      Queue& queue = entry.second;
+      for (int i = 0; i < SCHEDULER_MAX_BURST_MESSAGES && !queue.chunks.empty(); i++) {
+        if (!queue.hasDue) {
+          SetDue(queue, now);
+        }
+        if (queue.retry > now || !Send(entry.first, queue, now)) {
+          break;
+        }
+      }
+      if (!queue.chunks.empty()) {
+        next = min(next, queue.hasDue ? queue.retry : now);
+      }
+    }
+
+    if (next == Clock::time_point::max()) {
+      cv_.wait(lock);
+    } else if (next - now > chrono::microseconds(SCHEDULER_SPIN_US)) {
+      cv_.wait_until(lock, next - chrono::microseconds(SCHEDULER_SPIN_US));
+    } else if (next > now) {
+      // too close to sleep precisely, let JS calls in while spinning
+      lock.unlock();
+      this_thread::yield();
+      lock.lock();
+    }
+  }
+}
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#if defined(_WIN32)
+#include <srt.h>
+#else
+#include <srt/srt.h>
+#endif
+
+/**
+ * Paces queued messages out to their sockets from its own thread,
+ * with a token bucket per socket (target bitrate and burst size).
+ *
+ * The thread sleeps until the next message is due and spins for the last
+ * few microseconds, so the pacing doesn't depend on the event loop or on timers.
+ * Sockets are made non-blocking: a full send buffer delays its socket only.
+ */
+class SendScheduler {
+  public:
+    typedef std::chrono::steady_clock Clock;
+
+    struct Metrics {
+      uint64_t queuedBytes = 0;
+      uint64_t queuedMessages = 0;
+      uint64_t sentBytes = 0;
+      uint64_t sentMessages = 0;
+      uint64_t lateSends = 0;       // sent later than the late threshold after they were due
+      double maxLateUs = 0;
+      double meanLateUs = 0;
+      bool broken = false;          // a send failed, the queue was dropped
+    };
+
+    // called on the scheduler thread, with its lock held
+    typedef std::function<void(SRTSOCKET)> DrainCallback;
+
+    SendScheduler(int64_t lateThresholdUs, DrainCallback onDrain = nullptr);
+    ~SendScheduler();
+
+    /**
+     * Sets (or changes) the bucket of a socket.
+     * Returns false if the socket can't be made non-blocking (srt_getlasterror tells why).
+     */
+    bool Configure(SRTSOCKET socket, double bitsPerSecond, size_t burstBytes, size_t maxQueueBytes);
+
+    /**
+     * Queues a copy of `data`, to be sent as messages of `payloadSize` bytes (the last one may be shorter).
+     * Returns the bytes queued: 0 if the queue is full (or the socket wasn't configured or is broken).
+     */
+    size_t Enqueue(SRTSOCKET socket, const char* data, size_t length, int payloadSize);
+
+    /**
+     * Asks for `onDrain(socket)` once the queue of the socket holds at most `queuedBytes`
+     * (or broke). While already asked for, the lowest threshold is kept.
+     * Returns false, and nothing is called, if the queue already does, or the socket
+     * isn't configured, or the scheduler was stopped.
+     */
+    bool WatchDrain(SRTSOCKET socket, uint64_t queuedBytes);
+
+    bool Remove(SRTSOCKET socket);
+
+    bool GetMetrics(SRTSOCKET socket, Metrics& metrics);
+
+    void Stop();
+
+  private:
+    struct Chunk {
+      std::vector<char> data;
+      size_t sent;
+      int payloadSize;
+    };
+
+    struct Queue {
+      double bytesPerUs = 0;
+      double burst = 0;
+      double tokens = 0;
+      size_t maxQueueBytes = 0;
+      Clock::time_point refilled;
+      bool hasDue = false;
+      Clock::time_point due;        // when the bucket allows the next message
+      Clock::time_point retry;      // after a full send buffer
+      std::deque<Chunk> chunks;
+      Metrics metrics;
+      double lateSumUs = 0;
+      bool watchDrain = false;
+      uint64_t drainBytes = 0;
+    };
+
+    void Run();
+    void Refill(Queue& queue, Clock::time_point now);
+    void SetDue(Queue& queue, Clock::time_point now);
+    bool Send(SRTSOCKET socket, Queue& queue, Clock::time_point now);
+    void NotifyDrain(SRTSOCKET socket, Queue& queue);
+
+    const int64_t lateThresholdUs_;
+    const DrainCallback onDrain_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    bool running_;
+    std::map<SRTSOCKET, Queue> queues_;
+    std::thread thread_;
+};
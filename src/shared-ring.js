@@ -0,0 +1,400 @@
+/**
+ * Lock-free single-producer single-consumer ring of variable length records
+ * in a SharedArrayBuffer, and the encoding of call arguments and results into it.
+ *
+ * Used by the `shared-ring` transport of AsyncSRT: one ring carries the calls
+ * (with their payloads) to the worker, the other one carries the results back.
+ * Payloads are copied straight into and out of the ring,
+ * the buffers of the caller are never cloned or detached.
+ */
+
+// Int32 header slots
+const HEAD = 0; // byte offset of the next record to read, written by the consumer only
+const TAIL = 1; // byte offset of the next record to write, written by the producer only
+const DATA_SEQ = 2; // bumped by the producer on every publish, waited on by the consumer
+const SPACE_SEQ = 3; // bumped by the consumer on every release, waited on by the producer
+const HEADER_BYTES = 16;
+
+const RECORD_HEADER_BYTES = 4;
+const WRAP_MARKER = 0xFFFFFFFF;
+
+const DEFAULT_RING_BYTES = 4 * 1024 * 1024;
+
+// call that makes the worker leave its loop
+const STOP_METHOD = '__stop';
+
+function align4(n) {
+  return (n + 3) & ~3;
+}
+
+class SPSCRing {
+
+  /**
+   * @param {number} byteLength capacity of the ring (rounded up to 4 bytes)
+   * @returns {SharedArrayBuffer}
+   */
+  static allocate(byteLength = DEFAULT_RING_BYTES) {
+    return new SharedArrayBuffer(HEADER_BYTES + align4(byteLength));
+  }
+
+  /**
+   * Each side of the ring creates its own instance over the same memory,
+   * the producer only calls `write`/`publish`, the consumer only `read`.
+   *
+   * @param {SharedArrayBuffer} sab
+   */
+  constructor(sab) {
+    this._header = new Int32Array(sab, 0, HEADER_BYTES / 4);
+    this._buf = Buffer.from(sab, HEADER_BYTES);
+    this.capacity = this._buf.byteLength;
+    // producer side: end of the records written but not yet published
+    this._pendingTail = undefined;
+  }
+
+  /**
+   * Largest record payload that is sure to fit once the ring has drained,
+   * wherever the read position is at that moment.
+   *
+   * @returns {number}
+   */
+  get maxRecordBytes() {
+    // a record never covers the wrap, and one slot stays free so that head === tail means empty
+    return ((this.capacity >> 1) & ~3) - RECORD_HEADER_BYTES - 4;
+  }
+
+  /**
+   * @returns {number} to pass to `waitForData`, read before checking the ring
+   */
+  dataSequence() {
+    return Atomics.load(this._header, DATA_SEQ);
+  }
+
+  /**
+   * @returns {number} to pass to `waitForSpace`, read before trying to write
+   */
+  spaceSequence() {
+    return Atomics.load(this._header, SPACE_SEQ);
+  }
+
+  /**
+   * Writes one record of `length` bytes, filled in by `fill(buf, offset)`.
+   * The record is not visible to the consumer until `publish`.
+   *
+   * @param {number} length
+   * @param {Function} fill
+   * @returns {boolean} false when there is not enough contiguous room right now
+   */
+  write(length, fill) {
+    const need = align4(RECORD_HEADER_BYTES + length);
+    const head = Atomics.load(this._header, HEAD);
+    let tail = this._pendingTail === undefined ? Atomics.load(this._header, TAIL) : this._pendingTail;
+    if (tail >= head) {
+      // the record may not end on `head` at the wrap, that would read as empty
+      if (need > this.capacity - tail - (head === 0 ? 4 : 0)) {
+        if (need >= head) return false;
+        this._buf.writeUInt32LE(WRAP_MARKER, tail);
+        tail = 0;
+      }
+    } else if (tail + need >= head) {
+      return false;
+    }
+    this._buf.writeUInt32LE(length, tail);
+    fill(this._buf, tail + RECORD_HEADER_BYTES);
+    this._pendingTail = (tail + need) % this.capacity;
+    return true;
+  }
+
+  /**
+   * Makes the records written so far visible and wakes the consumer.
+   */
+  publish() {
+    if (this._pendingTail === undefined) return;
+    Atomics.store(this._header, TAIL, this._pendingTail);
+    this._pendingTail = undefined;
+    Atomics.add(this._header, DATA_SEQ, 1);
+    Atomics.notify(this._header, DATA_SEQ);
+  }
+
+  /**
+   * Reads the next record with `parse(buf, offset, length)`, the bytes are only
+   * valid during that call. Its room is released right after.
+   *
+   * @param {Function} parse
+   * @returns {any} what `parse` returned, undefined when the ring is empty
+   */
+  read(parse) {
+    let head = Atomics.load(this._header, HEAD);
+    if (head === Atomics.load(this._header, TAIL)) return undefined;
+    let length = this._buf.readUInt32LE(head);
+    if (length === WRAP_MARKER) {
+      head = 0;
+      length = this._buf.readUInt32LE(0);
+    }
+    const value = parse(this._buf, head + RECORD_HEADER_BYTES, length);
+    Atomics.store(this._header, HEAD, (head + align4(RECORD_HEADER_BYTES + length)) % this.capacity);
+    Atomics.add(this._header, SPACE_SEQ, 1);
+    Atomics.notify(this._header, SPACE_SEQ);
+    return value;
+  }
+
+  /**
+   * Blocks until something was published after `sequence` was read (worker side).
+   *
+   * @param {number} sequence
+   * @param {number} timeoutMs
+   */
+  waitForData(sequence, timeoutMs) {
+    Atomics.wait(this._header, DATA_SEQ, sequence, timeoutMs);
+  }
+
+  /**
+   * Resolves when something was published after `sequence` was read (main thread side).
+   *
+   * @param {number} sequence
+   * @returns {Promise<string> | null} null when the sequence has moved on already
+   */
+  waitForDataAsync(sequence) {
+    const wait = Atomics.waitAsync(this._header, DATA_SEQ, sequence);
+    return wait.async ? wait.value : null;
+  }
+
+  /**
+   * Blocks until room was released after `sequence` was read.
+   *
+   * @param {number} sequence
+   * @param {number} timeoutMs
+   */
+  waitForSpace(sequence, timeoutMs) {
+    Atomics.wait(this._header, SPACE_SEQ, sequence, timeoutMs);
+  }
+
+  /**
+   * Wakes a consumer waiting for data without publishing anything.
+   */
+  wake() {
+    Atomics.add(this._header, DATA_SEQ, 1);
+    Atomics.notify(this._header, DATA_SEQ);
+  }
+}
+
+// value tags of the record encoding
+const T_UNDEFINED = 0;
+const T_NULL = 1;
+const T_FALSE = 2;
+const T_TRUE = 3;
+const T_NUMBER = 4;
+const T_STRING = 5;
+const T_BYTES = 6;
+const T_INT32_ARRAY = 7;
+const T_UINT32_ARRAY = 8;
+const T_FLOAT64_ARRAY = 9;
+const T_ARRAY = 10;
+const T_OBJECT = 11;
+
+function typedArrayTag(value) {
+  if (value instanceof Uint8Array) return T_BYTES;
+  if (value instanceof Int32Array) return T_INT32_ARRAY;
+  if (value instanceof Uint32Array) return T_UINT32_ARRAY;
+  if (value instanceof Float64Array) return T_FLOAT64_ARRAY;
+  return -1;
+}
+
+/**
+ * Bytes needed to encode `value`: undefined, null, booleans, numbers, strings,
+ * Buffer/Uint8Array, Int32Array, Uint32Array, Float64Array and arrays and plain objects of those.
+ *
+ * @param {any} value
+ * @returns {number}
+ */
+function encodedSize(value) {
+  switch (typeof value) {
+  case 'undefined':
+  case 'boolean':
+    return 1;
+  case 'number':
+    return 9;
+  case 'string':
+    return 5 + Buffer.byteLength(value);
+  case 'object':
+    break;
+  default:
+    throw new TypeError(`Can't encode a ${typeof value} into a shared ring`);
+  }
+  if (value === null) return 1;
+  if (ArrayBuffer.isView(value)) {
+    if (typedArrayTag(value) < 0) {
+      throw new TypeError(`Can't encode a ${value.constructor.name} into a shared ring`);
+    }
+    return 5 + value.byteLength;
+  }
+  let size = 5;
+  if (Array.isArray(value)) {
+    for (let i = 0; i < value.length; i++) {
+      size += encodedSize(value[i]);
+    }
+    return size;
+  }
+  const keys = Object.keys(value);
+  for (let i = 0; i < keys.length; i++) {
+    size += encodedSize(keys[i]) + encodedSize(value[keys[i]]);
+  }
+  return size;
+}
+
+/**
+ * Encodes `value` at `offset`, room for `encodedSize(value)` bytes must be there.
+ *
+ * @param {Buffer} buf
+ * @param {number} offset
+ * @param {any} value
+ * @returns {number} offset after the value
+ */
+function encodeInto(buf, offset, value) {
+  switch (typeof value) {
+  case 'undefined':
+    buf[offset] = T_UNDEFINED;
+    return offset + 1;
+  case 'boolean':
+    buf[offset] = value ? T_TRUE : T_FALSE;
+    return offset + 1;
+  case 'number':
+    buf[offset] = T_NUMBER;
+    buf.writeDoubleLE(value, offset + 1);
+    return offset + 9;
+  case 'string': {
+    buf[offset] = T_STRING;
+    const length = buf.write(value, offset + 5);
+    buf.writeUInt32LE(length, offset + 1);
+    return offset + 5 + length;
+  }
+  default:
+    break;
+  }
+  if (value === null) {
+    buf[offset] = T_NULL;
+    return offset + 1;
+  }
+  if (ArrayBuffer.isView(value)) {
+    buf[offset] = typedArrayTag(value);
+    buf.writeUInt32LE(value.byteLength, offset + 1);
+    buf.set(new Uint8Array(value.buffer, value.byteOffset, value.byteLength), offset + 5);
+    return offset + 5 + value.byteLength;
+  }
+  if (Array.isArray(value)) {
+    buf[offset] = T_ARRAY;
+    buf.writeUInt32LE(value.length, offset + 1);
+    offset += 5;
+    for (let i = 0; i < value.length; i++) {
+      offset = encodeInto(buf, offset, value[i]);
+    }
+    return offset;
+  }
+  const keys = Object.keys(value);
+  buf[offset] = T_OBJECT;
+  buf.writeUInt32LE(keys.length, offset + 1);
+  offset += 5;
+  for (let i = 0; i < keys.length; i++) {
+    offset = encodeInto(buf, offset, keys[i]);
+    offset = encodeInto(buf, offset, value[keys[i]]);
+  }
+  return offset;
+}
+
+/**
+ * Decodes a value encoded by `encodeInto`. Byte arrays are copied out of the ring
+ * into memory of their own (a Buffer for Uint8Array).
+ *
+ * @param {Buffer} buf
+ * @param {number} offset
+ * @returns {Array} [value, offset after the value]
+ */
+function decodeFrom(buf, offset) {
+  const tag = buf[offset];
+  switch (tag) {
+  case T_UNDEFINED:
+    return [undefined, offset + 1];
+  case T_NULL:
+    return [null, offset + 1];
+  case T_FALSE:
+    return [false, offset + 1];
+  case T_TRUE:
+    return [true, offset + 1];
+  case T_NUMBER:
+    return [buf.readDoubleLE(offset + 1), offset + 9];
+  case T_STRING: {
+    const end = offset + 5 + buf.readUInt32LE(offset + 1);
+    return [buf.toString('utf8', offset + 5, end), end];
+  }
+  case T_BYTES:
+  case T_INT32_ARRAY:
+  case T_UINT32_ARRAY:
+  case T_FLOAT64_ARRAY: {
+    const byteLength = buf.readUInt32LE(offset + 1);
+    const start = offset + 5;
+    const bytes = Buffer.allocUnsafeSlow(byteLength);
+    buf.copy(bytes, 0, start, start + byteLength);
+    let value = bytes;
+    if (tag === T_INT32_ARRAY) value = new Int32Array(bytes.buffer, 0, byteLength / 4);
+    else if (tag === T_UINT32_ARRAY) value = new Uint32Array(bytes.buffer, 0, byteLength / 4);
+    else if (tag === T_FLOAT64_ARRAY) value = new Float64Array(bytes.buffer, 0, byteLength / 8);
+    return [value, start + byteLength];
+  }
+  case T_ARRAY: {
+    const length = buf.readUInt32LE(offset + 1);
+    const value = new Array(length);
+    offset += 5;
+    for (let i = 0; i < length; i++) {
+      [value[i], offset] = decodeFrom(buf, offset);
+    }
+    return [value, offset];
+  }
+  case T_OBJECT: {
+    const count = buf.readUInt32LE(offset + 1);
+    const value = {};
+    offset += 5;
+    for (let i = 0; i < count; i++) {
+      let key;
+      [key, offset] = decodeFrom(buf, offset);
+      [value[key], offset] = decodeFrom(buf, offset);
+    }
+    return [value, offset];
+  }
+  default:
+    throw new Error(`Corrupt shared ring record: unknown tag ${tag} at ${offset}`);
+  }
+}
+
+/**
+ * Encodes `value` as one record, when it fits.
+ *
+ * @param {SPSCRing} ring
+ * @param {any} value
+ * @param {number} size encodedSize(value)
+ * @returns {boolean} false when there is no room right now
+ */
+function writeValue(ring, value, size) {
+  return ring.write(size, (buf, offset) => encodeInto(buf, offset, value));
+}
+
+function parseValue(buf, offset) {
+  return decodeFrom(buf, offset)[0];
+}
+
+/**
+ * @param {SPSCRing} ring
+ * @returns {any} the value of the next record, undefined when the ring is empty
+ */
+function readValue(ring) {
+  return ring.read(parseValue);
+}
+
+module.exports = {
+  SPSCRing,
+  DEFAULT_RING_BYTES,
+  STOP_METHOD,
+  encodedSize,
+  encodeInto,
+  decodeFrom,
+  writeValue,
+  readValue
+};
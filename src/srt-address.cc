@@ -0,0 +1,49 @@
+#include "srt-address.h"
+
+#include <cstring>
+
+#if defined(_WIN32)
+#include <ws2tcpip.h>
+#endif
+
+using namespace std;
+
+bool ToSockAddr(const string& host, int port, sockaddr_storage& addr, int& addrLen) {
+  memset(&addr, 0, sizeof(addr));
+
+  sockaddr_in* addr4 = (sockaddr_in *)&addr;
+  if (inet_pton(AF_INET, host.c_str(), &addr4->sin_addr) == 1) {
+    addr4->sin_family = AF_INET;
+    addr4->sin_port = htons((uint16_t)port);
+    addrLen = sizeof(sockaddr_in);
+    return true;
+  }
+
+  sockaddr_in6* addr6 = (sockaddr_in6 *)&addr;
+  if (inet_pton(AF_INET6, host.c_str(), &addr6->sin6_addr) == 1) {
+    addr6->sin6_family = AF_INET6;
+    addr6->sin6_port = htons((uint16_t)port);
+    addrLen = sizeof(sockaddr_in6);
+    return true;
+  }
+  return false;
+}
+
+string SockAddrHost(const sockaddr_storage& addr) {
+  char host[INET6_ADDRSTRLEN] = "";
+  if (addr.ss_family == AF_INET) {
+    inet_ntop(AF_INET, &((const sockaddr_in *)&addr)->sin_addr, host, sizeof(host));
+  } else if (addr.ss_family == AF_INET6) {
+    inet_ntop(AF_INET6, &((const sockaddr_in6 *)&addr)->sin6_addr, host, sizeof(host));
+  }
+  return host;
+}
+
+int SockAddrPort(const sockaddr_storage& addr) {
+  if (addr.ss_family == AF_INET) {
+    return ntohs(((const sockaddr_in *)&addr)->sin_port);
+  } else if (addr.ss_family == AF_INET6) {
+    return ntohs(((const sockaddr_in6 *)&addr)->sin6_port);
+  }
+  return 0;
+}
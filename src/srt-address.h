@@ -0,0 +1,25 @@
+#pragma once
+
+#include <string>
+
+#if defined(_WIN32)
+#include <srt.h>
+#else
+#include <srt/srt.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#endif
+
+/**
+ * Fills `addr` from a numeric IPv4 or IPv6 host and a port.
+ * `addrLen` gets the size of the filled in sockaddr.
+ * Returns false if `host` is neither.
+ */
+bool ToSockAddr(const std::string& host, int port, sockaddr_storage& addr, int& addrLen);
+
+/**
+ * Numeric host of an IPv4 or IPv6 address, empty for other families.
+ */
+std::string SockAddrHost(const sockaddr_storage& addr);
+
+int SockAddrPort(const sockaddr_storage& addr);
@@ -56,7 +56,10 @@ export enum SRTSockOpt {
   SRTO_ENFORCEDENCRYPTION,  // Connection to be rejected or quickly broken when one side encryption set or bad password
   SRTO_IPV6ONLY,            // IPV6_V6ONLY mode
   SRTO_PEERIDLETIMEO,       // Peer-idle timeout (max time of silence heard from peer) in [ms]
-  // (some space left)
+  SRTO_BINDTODEVICE,        // Forward the SOCK_BINDTODEVICE option on socket (pass packets only from that device)
+  SRTO_GROUPCONNECT,        // Set on a listener to allow group connection (ENABLE_BONDING)
+  SRTO_GROUPMINSTABLETIMEO, // Minimum Link Stability timeout (backup mode) in milliseconds (ENABLE_BONDING)
+  SRTO_GROUPTYPE,           // Group type to which an accepted socket is about to be added, available in the handshake (ENABLE_BONDING)
   SRTO_PACKETFILTER = 60          // Add and configure a packet filter
 }
 
@@ -83,6 +86,19 @@ export enum SRTSockStatus {
   SRTS_NONEXIST
 }
 
+export enum SRTGroupType {
+  SRT_GTYPE_UNDEFINED,
+  SRT_GTYPE_BROADCAST,
+  SRT_GTYPE_BACKUP
+}
+
+export enum SRTGroupMemberStatus {
+  SRT_GST_PENDING,  // The socket is created correctly, but not yet ready for getting data.
+  SRT_GST_IDLE,     // The socket is ready to be activated
+  SRT_GST_RUNNING,  // The socket was already activated and is in use
+  SRT_GST_BROKEN    // The last operation broke the socket, it should be closed.
+}
+
 export enum SRTResult {
   SRT_ERROR = -1,
   SRT_OK = 0
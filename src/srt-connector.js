@@ -0,0 +1,153 @@
+const { SRT } = require('../build/Release/node_srt.node');
+const debug = require('debug')('srt-connector');
+
+/**
+ * Connects many caller sockets concurrently without blocking any thread on a handshake.
+ *
+ * Each connect is started non-blocking (`SRT#startConnect`) and its socket waits
+ * on one shared epoll for `EPOLL_OUT` (connected) or `EPOLL_ERR` (failed),
+ * reported by the native epoll event pump. All calls are non-blocking,
+ * so they are made on the main thread.
+ *
+ * A peer that doesn't answer fails after `SRTO_CONNTIMEO` (default: 3 seconds).
+ * If the epoll wait itself fails, every connect in progress is rejected with that error.
+ */
+class SRTConnector {
+  constructor() {
+    this._srt = new SRT();
+    this._epid = null;
+    /**
+     * @type {Map<number, {host: string, port: number, blocking: boolean, resolve: Function, reject: Function}>}
+     */
+    this._pending = new Map();
+  }
+
+  /**
+   * Connects in progress.
+   *
+   * @returns {number}
+   */
+  get pending() {
+    return this._pending.size;
+  }
+
+  /**
+   * Creates a socket, sets `options` on it and connects it to `host` (IPv4 or IPv6).
+   *
+   * Connected sockets are made blocking for receiving again, unless `options`
+   * sets `SRTO_RCVSYN`. A socket that fails to connect is closed.
+   *
+   * @param {string} host
+   * @param {number} port
+   * @param {Object<number, SRTSockOptValue>} options optional, e.g `{ [SRT.SRTO_STREAMID]: 'live/a' }`
+   * @param {boolean} sender optional, see `SRT#createSocket`
+   * @returns {Promise<number>} the connected socket
+   */
+  connect(host, port, options = {}, sender = false) {
+    if (this._epid === null) {
+      this._epid = this._srt.epollCreate();
+      this._srt.epollWatch(this._epid, this._onEpollEvents.bind(this));
+    }
+    return new Promise((resolve, reject) => {
+      let socket = SRT.INVALID_SOCK;
+      let started = false;
+      try {
+        socket = this._srt.createSocket(sender);
+        Object.keys(options).forEach((option) => {
+          this._srt.setSockOpt(socket, Number(option), options[option]);
+        });
+        const blocking = options[SRT.SRTO_RCVSYN] === undefined ? true : options[SRT.SRTO_RCVSYN];
+        this._pending.set(socket, { host, port, blocking, resolve, reject });
+        this._srt.epollAddUsock(this._epid, socket, SRT.EPOLL_OUT | SRT.EPOLL_ERR);
+        started = true;
+        this._srt.startConnect(socket, host, port);
+      } catch (err) {
+        this._pending.delete(socket);
+        // startConnect closes the socket itself when it fails
+        if (socket !== SRT.INVALID_SOCK && !started) {
+          this._srt.close(socket);
+        }
+        reject(err);
+      }
+    });
+  }
+
+  /**
+   * Stops the event pump. Connects still in progress are rejected and their sockets closed.
+   */
+  dispose() {
+    if (this._epid !== null) {
+      this._srt.epollUnwatch(this._epid);
+      this._srt.epollRelease(this._epid);
+      this._epid = null;
+    }
+    this._pending.forEach(({ host, port, reject }, socket) => {
+      this._srt.close(socket);
+      reject(new Error(`SRTConnector: disposed while connecting to ${host}:${port}`));
+    });
+    this._pending.clear();
+  }
+
+  /**
+   * @private
+   * @param {SRTEpollEvent[] | null} events
+   * @param {string} err
+   */
+  _onEpollEvents(events, err) {
+    if (err) {
+      debug("Epoll wait failed:", err);
+      this._failPending(err);
+      return;
+    }
+    events.forEach(({ socket }) => {
+      const connect = this._pending.get(socket);
+      if (!connect) {
+        return;
+      }
+      const status = this._srt.getSockState(socket);
+      if (status === SRT.SRTS_CONNECTING) {
+        return;
+      }
+      this._pending.delete(socket);
+      this._srt.epollRemoveUsock(this._epid, socket);
+      if (status === SRT.SRTS_CONNECTED) {
+        if (connect.blocking) {
+          this._srt.setSockOpt(socket, SRT.SRTO_RCVSYN, true);
+        }
+        debug("Connected socket:", socket, "to:", connect.host, connect.port);
+        connect.resolve(socket);
+      } else {
+        this._srt.close(socket);
+        connect.reject(new Error(`SRTConnector: connecting to ${connect.host}:${connect.port} failed (socket status ${status})`));
+      }
+    });
+  }
+
+  /**
+   * The pump stopped with `err`: every connect in progress is rejected
+   * and its socket closed, the epoll is released (the next connect creates a new one).
+   *
+   * @private
+   * @param {string} err
+   */
+  _failPending(err) {
+    const epid = this._epid;
+    this._epid = null;
+    const pending = Array.from(this._pending.entries());
+    this._pending.clear();
+    pending.forEach(([socket, { host, port, reject }]) => {
+      try {
+        this._srt.epollRemoveUsock(epid, socket);
+        this._srt.close(socket);
+      } catch (closeErr) {
+        // closed meanwhile, which took it off the epoll already
+      }
+      reject(new Error(`SRTConnector: connecting to ${host}:${port} failed, epoll wait failed: ${err}`));
+    });
+    this._srt.epollRelease(epid);
+  }
+}
+
+module.exports = {
+  SRTConnector
+};
@@ -71,3 +71,27 @@
   ENUM(SRTS_CLOSING, 7), \
   ENUM(SRTS_CLOSED, 8), \
   ENUM(SRTS_NONEXIST, 9)
+
+#define TRANSTYPES \
+  ENUM(SRTT_LIVE, SRTT_LIVE), \
+  ENUM(SRTT_FILE, SRTT_FILE)
+
+#define GROUP_TYPES \
+  ENUM(SRT_GTYPE_BROADCAST, SRT_GTYPE_BROADCAST), \
+  ENUM(SRT_GTYPE_BACKUP, SRT_GTYPE_BACKUP)
+
+#define GROUP_MEMBER_STATUS \
+  ENUM(SRT_GST_PENDING, SRT_GST_PENDING), \
+  ENUM(SRT_GST_IDLE, SRT_GST_IDLE), \
+  ENUM(SRT_GST_RUNNING, SRT_GST_RUNNING), \
+  ENUM(SRT_GST_BROKEN, SRT_GST_BROKEN)
+
+#define MSGCTRL_FIELDS \
+  ENUM(MSGCTRL_FLAGS, MSGCTRL_FLAGS), \
+  ENUM(MSGCTRL_TTL, MSGCTRL_TTL), \
+  ENUM(MSGCTRL_INORDER, MSGCTRL_INORDER), \
+  ENUM(MSGCTRL_BOUNDARY, MSGCTRL_BOUNDARY), \
+  ENUM(MSGCTRL_SRCTIME, MSGCTRL_SRCTIME), \
+  ENUM(MSGCTRL_PKTSEQ, MSGCTRL_PKTSEQ), \
+  ENUM(MSGCTRL_NO, MSGCTRL_NO), \
+  ENUM(MSGCTRL_LENGTH, MSGCTRL_LENGTH)
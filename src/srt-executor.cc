@@ -0,0 +1,181 @@
+#include "srt-executor.h"
+
+#include <thread>
+
+SRTExecutor::SRTExecutor(Napi::Env env, size_t numThreads)
+  : lanes_(std::make_shared<Lanes>()),
+    nextLane_(0),
+    shutdown_(false) {
+  if (numThreads == 0) {
+    numThreads = 1;
+  }
+  for (size_t i = 0; i < numThreads; i++) {
+    lanes_->lanes.emplace_back(new Lane());
+  }
+
+  // results are delivered through the native callback only
+  Napi::Function noop = Napi::Function::New(env, [](const Napi::CallbackInfo& info) {});
+  lanes_->tsfn = Napi::ThreadSafeFunction::New(env, noop, "SRTExecutor", 0, numThreads,
+    new std::shared_ptr<Lanes>(lanes_), Finalize);
+  // only keep the process alive while there is work pending
+  lanes_->tsfn.Unref(env);
+
+  for (size_t i = 0; i < numThreads; i++) {
+    std::thread(Run, lanes_, i).detach();
+  }
+}
+
+SRTExecutor::~SRTExecutor() {
+  // jobs still running may complete after us
+  lanes_->timingCallback = nullptr;
+}
+
+int64_t SRTExecutor::NowNs() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void SRTExecutor::SetTimingCallback(Napi::Function callback) {
+  if (callback.IsEmpty()) {
+    timingCallback_.Reset();
+    lanes_->timingCallback = nullptr;
+    return;
+  }
+  timingCallback_ = Napi::Persistent(callback);
+  lanes_->timingCallback = &timingCallback_;
+}
+
+Napi::Promise SRTExecutor::Submit(Napi::Env env, int key, SRTAsyncJob* job) {
+  Napi::Promise promise = job->deferred.Promise();
+  if (shutdown_) {
+    job->deferred.Reject(Napi::Error::New(env, "SRT executor was shut down").Value());
+    delete job;
+    return promise;
+  }
+
+  const size_t numLanes = lanes_->lanes.size();
+  size_t index = key == NO_KEY ? nextLane_++ % numLanes : (size_t) (uint32_t) key % numLanes;
+
+  job->lanes = lanes_.get();
+  if (lanes_->timingCallback != nullptr) {
+    job->submittedNs = NowNs();
+  }
+  if (lanes_->pending++ == 0) {
+    lanes_->tsfn.Ref(env);
+  }
+
+  Lane& lane = *lanes_->lanes[index];
+  {
+    std::lock_guard<std::mutex> lock(lane.mutex);
+    lane.jobs.push_back(job);
+  }
+  lane.cv.notify_one();
+  return promise;
+}
+
+size_t SRTExecutor::Shutdown(Napi::Env env) {
+  if (shutdown_) {
+    return 0;
+  }
+  shutdown_ = true;
+
+  Napi::HandleScope scope(env);
+  size_t dropped = 0;
+  for (auto& lane : lanes_->lanes) {
+    std::deque<SRTAsyncJob*> jobs;
+    {
+      std::lock_guard<std::mutex> lock(lane->mutex);
+      lane->stopping = true;
+      jobs.swap(lane->jobs);
+    }
+    lane->cv.notify_all();
+    // settled like calls submitted after the shutdown, so nobody awaits them forever
+    for (SRTAsyncJob* job : jobs) {
+      job->deferred.Reject(Napi::Error::New(env, "SRT executor was shut down").Value());
+      delete job;
+      dropped++;
+    }
+  }
+
+  lanes_->pending -= dropped;
+  if (dropped > 0 && lanes_->pending == 0) {
+    lanes_->tsfn.Unref(env);
+  }
+  return dropped;
+}
+
+void SRTExecutor::Run(std::shared_ptr<Lanes> lanes, size_t index) {
+  Lane& lane = *lanes->lanes[index];
+  while (true) {
+    SRTAsyncJob* job;
+    {
+      std::unique_lock<std::mutex> lock(lane.mutex);
+      lane.cv.wait(lock, [&lane] { return !lane.jobs.empty() || lane.stopping; });
+      if (lane.stopping) {
+        break;
+      }
+      job = lane.jobs.front();
+      lane.jobs.pop_front();
+    }
+
+    // the SRT error state is per thread and not reset by successful calls
+    srt_clearlasterror();
+    if (job->submittedNs != 0) {
+      job->startedNs = NowNs();
+    }
+    job->result = job->execute();
+    if (job->submittedNs != 0) {
+      job->finishedNs = NowNs();
+    }
+    if (job->result == SRT_ERROR) {
+      job->errorCode = srt_getlasterror(nullptr);
+      job->errorMessage = srt_getlasterror_str();
+    }
+
+    if (lanes->tsfn.NonBlockingCall(job, CallJs) != napi_ok) {
+      // environment is going away, the job can't be settled anymore
+      break;
+    }
+  }
+  lanes->tsfn.Release();
+}
+
+void SRTExecutor::CallJs(Napi::Env env, Napi::Function callback, SRTAsyncJob* job) {
+  if (env == nullptr) {
+    return;
+  }
+
+  Lanes* lanes = static_cast<Lanes*>(job->lanes);
+  if (--lanes->pending == 0) {
+    lanes->tsfn.Unref(env);
+  }
+
+  if (job->submittedNs != 0 && lanes->timingCallback != nullptr) {
+    lanes->timingCallback->Call({
+      job->deferred.Promise(),
+      Napi::Number::New(env, (job->startedNs - job->submittedNs) / 1000.0),
+      Napi::Number::New(env, (job->finishedNs - job->startedNs) / 1000.0)
+    });
+    if (env.IsExceptionPending()) {
+      env.GetAndClearPendingException();
+    }
+  }
+
+  if (job->errorCode != SRT_SUCCESS && job->errorCode != job->toleratedError) {
+    job->deferred.Reject(Napi::Error::New(env, job->errorMessage).Value());
+  } else {
+    Napi::Value value = job->complete
+      ? job->complete(env, job->result)
+      : Napi::Number::New(env, job->result);
+    if (env.IsExceptionPending()) {
+      job->deferred.Reject(env.GetAndClearPendingException().Value());
+    } else {
+      job->deferred.Resolve(value);
+    }
+  }
+  delete job;
+}
+
+void SRTExecutor::Finalize(Napi::Env env, std::shared_ptr<Lanes>* context) {
+  delete context;
+}
@@ -0,0 +1,122 @@
+#pragma once
+
+#include <napi.h>
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#if defined(_WIN32)
+#include <srt.h>
+#else
+#include <srt/srt.h>
+#endif
+
+/**
+ * One SRT call run off the main thread.
+ *
+ * `execute` runs on an executor thread and may only use the SRT API.
+ * If it returns SRT_ERROR, the SRT error of that thread is recorded and
+ * the promise gets rejected, unless the code is `toleratedError`
+ * (e.g SRT_EASYNCRCV for reads), in which case `complete` still runs.
+ * `complete` runs on the main thread and turns the result into a JS value.
+ */
+struct SRTAsyncJob {
+  SRTAsyncJob(Napi::Env env) : deferred(Napi::Promise::Deferred::New(env)) {}
+
+  std::function<int()> execute;
+  std::function<Napi::Value(Napi::Env, int)> complete;
+  int toleratedError = SRT_SUCCESS;
+
+  int result = 0;
+  int errorCode = SRT_SUCCESS;
+  std::string errorMessage;
+
+  Napi::Promise::Deferred deferred;
+
+  // set by the executor the job was submitted to
+  void* lanes = nullptr;
+
+  // steady clock times in ns, only taken while a timing callback is set
+  int64_t submittedNs = 0;
+  int64_t startedNs = 0;
+  int64_t finishedNs = 0;
+};
+
+/**
+ * A fixed set of threads running SRTAsyncJobs.
+ *
+ * Jobs are queued on the thread selected by their key (usually the socket),
+ * so calls on one socket keep their order while different sockets
+ * don't wait for each other. Results are passed back to the main thread
+ * through a single thread-safe function.
+ */
+class SRTExecutor {
+  public:
+    static const int NO_KEY = -1;
+
+    SRTExecutor(Napi::Env env, size_t numThreads);
+    ~SRTExecutor();
+
+    /**
+     * Takes ownership of the job and returns the promise it will settle.
+     */
+    Napi::Promise Submit(Napi::Env env, int key, SRTAsyncJob* job);
+
+    /**
+     * Lets threads exit once their current job is done. Queued jobs are dropped,
+     * their promises rejected as those of jobs submitted afterwards.
+     * @returns number of dropped jobs
+     */
+    size_t Shutdown(Napi::Env env);
+
+    size_t NumThreads() const { return lanes_->lanes.size(); }
+
+    /**
+     * Jobs submitted and not settled yet (main thread only).
+     */
+    size_t Pending() const { return lanes_->pending; }
+
+    bool IsShutdown() const { return shutdown_; }
+
+    /**
+     * While set, every job is timed and `callback(promise, queuedUs, executeUs)`
+     * is called on the main thread right before its promise settles.
+     * Pass an empty function to stop timing.
+     */
+    void SetTimingCallback(Napi::Function callback);
+
+  private:
+    struct Lane {
+      std::mutex mutex;
+      std::condition_variable cv;
+      std::deque<SRTAsyncJob*> jobs;
+      bool stopping = false;
+    };
+
+    struct Lanes {
+      std::vector<std::unique_ptr<Lane>> lanes;
+      Napi::ThreadSafeFunction tsfn;
+      // only accessed on the main thread
+      size_t pending = 0;
+      // owned by the executor, reset when it goes away
+      Napi::FunctionReference* timingCallback = nullptr;
+    };
+
+    static int64_t NowNs();
+
+    static void Run(std::shared_ptr<Lanes> lanes, size_t index);
+    static void CallJs(Napi::Env env, Napi::Function callback, SRTAsyncJob* job);
+    static void Finalize(Napi::Env env, std::shared_ptr<Lanes>* context);
+
+    std::shared_ptr<Lanes> lanes_;
+    Napi::FunctionReference timingCallback_;
+    size_t nextLane_;
+    bool shutdown_;
+};
@@ -0,0 +1,96 @@
+const EventEmitter = require('events');
+const fs = require('fs');
+
+const { SRT } = require('../build/Release/node_srt.node');
+
+const DEFAULT_FILE_RANGE_SIZE = 64 * 1024 * 1024;
+const DEFAULT_FILE_BLOCK_SIZE = 1024 * 1024;
+
+/**
+ * Moves a file over a connected SRT socket using the file transfer type (`SRT.SRTT_FILE`),
+ * both sides setting `SRTO_TRANSTYPE` before connecting.
+ *
+ * The file goes in ranges of `rangeSize` bytes, each one a single native call
+ * off the main thread (`AsyncSRT#sendFile` / `AsyncSRT#recvFile`),
+ * so JS only runs once per range. A 'progress' event is emitted after every range.
+ *
+ * When a transfer fails, the returned Promise rejects with an Error whose `offset`
+ * is where the file should be resumed from (on a new connection) by passing it as `offset`.
+ * Both sides must agree on the offset and size, e.g through the stream id.
+ * The receiver's offset is exact, the sender's is the start of the range that failed.
+ */
+class SRTFileTransfer extends EventEmitter {
+  /**
+   * @param {AsyncSRT} asyncSrt
+   * @param {number} socket
+   * @param {number} rangeSize default: 64 MiB
+   * @param {number} blockSize default: 1 MiB
+   */
+  constructor(asyncSrt, socket, rangeSize = DEFAULT_FILE_RANGE_SIZE, blockSize = DEFAULT_FILE_BLOCK_SIZE) {
+    super();
+    this.asyncSrt = asyncSrt;
+    this.socket = socket;
+    this.rangeSize = rangeSize;
+    this.blockSize = blockSize;
+  }
+
+  /**
+   * Sends the file at `path` from `offset`, `size` bytes (default: up to the end of the file).
+   *
+   * @param {string} path
+   * @param {number} offset default: 0
+   * @param {number} size
+   * @returns {Promise<number>} Offset after the last byte sent
+   */
+  async send(path, offset = 0, size = undefined) {
+    if (size === undefined) {
+      size = (await fs.promises.stat(path)).size - offset;
+    }
+    return this._transfer('sendFile', path, offset, size);
+  }
+
+  /**
+   * Receives `size` bytes into the file at `path` from `offset`.
+   * Bytes of the file before `offset` are kept.
+   *
+   * @param {string} path
+   * @param {number} offset
+   * @param {number} size
+   * @returns {Promise<number>} Offset after the last byte received
+   */
+  async receive(path, offset, size) {
+    return this._transfer('recvFile', path, offset, size);
+  }
+
+  /**
+   * @private
+   */
+  async _transfer(method, path, offset, size) {
+    const end = offset + size;
+    let position = offset;
+    while (position < end) {
+      const length = Math.min(this.rangeSize, end - position);
+      const bytes = await this.asyncSrt[method](this.socket, path, position, length, this.blockSize);
+      if (bytes === SRT.ERROR || bytes === 0) {
+        const err = new Error(`SRTFileTransfer: ${method} failed at offset ${position} of ${path}`);
+        err.offset = position;
+        throw err;
+      }
+      position += bytes;
+      this.emit('progress', { offset: position, bytes: position - offset, size });
+      if (bytes < length) {
+        // the connection broke within the range
+        const err = new Error(`SRTFileTransfer: ${method} stopped at offset ${position} of ${path}`);
+        err.offset = position;
+        throw err;
+      }
+    }
+    return position;
+  }
+}
+
+module.exports = {
+  DEFAULT_FILE_RANGE_SIZE,
+  DEFAULT_FILE_BLOCK_SIZE,
+  SRTFileTransfer
+};
@@ -0,0 +1,86 @@
+#include "srt-group.h"
+#include "srt-address.h"
+
+#include <string>
+
+using namespace std;
+
+// grown on demand when a group has more members
+#define GROUP_DATA_DEF_SIZE 8
+
+bool GetGroupEndpointsArg(const Napi::CallbackInfo& info, size_t index, vector<SRT_SOCKGROUPCONFIG>& members) {
+  Napi::Env env = info.Env();
+  if (info.Length() <= index || !info[index].IsArray() || info[index].As<Napi::Array>().Length() == 0) {
+    Napi::TypeError::New(env, "Expected a non-empty array of { host, port } endpoints").ThrowAsJavaScriptException();
+    return false;
+  }
+  Napi::Array endpoints = info[index].As<Napi::Array>();
+  for (uint32_t i = 0; i < endpoints.Length(); i++) {
+    Napi::Value value = endpoints.Get(i);
+    if (!value.IsObject()) {
+      Napi::TypeError::New(env, "Endpoint is not an object").ThrowAsJavaScriptException();
+      return false;
+    }
+    Napi::Object endpoint = value.As<Napi::Object>();
+    Napi::Value host = endpoint.Get("host");
+    Napi::Value port = endpoint.Get("port");
+    if (!host.IsString() || !port.IsNumber()) {
+      Napi::TypeError::New(env, "Endpoint needs a host string and a port number").ThrowAsJavaScriptException();
+      return false;
+    }
+
+    sockaddr_storage addr;
+    int addrLen;
+    if (!ToSockAddr(host.As<Napi::String>(), port.As<Napi::Number>().Int32Value(), addr, addrLen)) {
+      Napi::Error::New(env, "Invalid endpoint host: " + host.As<Napi::String>().Utf8Value()).ThrowAsJavaScriptException();
+      return false;
+    }
+    SRT_SOCKGROUPCONFIG member = srt_prepare_endpoint(nullptr, (const sockaddr *)&addr, addrLen);
+    Napi::Value weight = endpoint.Get("weight");
+    if (weight.IsNumber()) {
+      member.weight = (uint16_t)weight.As<Napi::Number>().Uint32Value();
+    }
+    Napi::Value token = endpoint.Get("token");
+    if (token.IsNumber()) {
+      member.token = token.As<Napi::Number>().Int32Value();
+    }
+    members.push_back(member);
+  }
+  return true;
+}
+
+int GetGroupData(SRTSOCKET group, vector<SRT_SOCKGROUPDATA>& members) {
+  members.resize(GROUP_DATA_DEF_SIZE);
+  for (;;) {
+    size_t size = members.size();
+    if (srt_group_data(group, members.data(), &size) != SRT_ERROR) {
+      members.resize(size);
+      return (int)size;
+    }
+    // on SRT_ELARGEMSG, size is the number of members
+    if (srt_getlasterror(nullptr) != SRT_ELARGEMSG || size <= members.size()) {
+      members.clear();
+      return SRT_ERROR;
+    }
+    srt_clearlasterror();
+    members.resize(size);
+  }
+}
+
+Napi::Array GroupDataToArray(Napi::Env env, const vector<SRT_SOCKGROUPDATA>& members) {
+  Napi::Array array = Napi::Array::New(env, members.size());
+  for (size_t i = 0; i < members.size(); i++) {
+    const SRT_SOCKGROUPDATA& data = members[i];
+    Napi::Object member = Napi::Object::New(env);
+    member.Set("socket", Napi::Number::New(env, data.id));
+    member.Set("host", Napi::String::New(env, SockAddrHost(data.peeraddr)));
+    member.Set("port", Napi::Number::New(env, SockAddrPort(data.peeraddr)));
+    member.Set("state", Napi::Number::New(env, data.sockstate));
+    member.Set("status", Napi::Number::New(env, data.memberstate));
+    member.Set("weight", Napi::Number::New(env, data.weight));
+    member.Set("result", Napi::Number::New(env, data.result));
+    member.Set("token", Napi::Number::New(env, data.token));
+    array.Set((uint32_t)i, member);
+  }
+  return array;
+}
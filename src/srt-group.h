@@ -0,0 +1,28 @@
+#pragma once
+
+#include <napi.h>
+
+#include <vector>
+
+#if defined(_WIN32)
+#include <srt.h>
+#else
+#include <srt/srt.h>
+#endif
+
+/**
+ * Reads the array of `{ host, port, weight?, token? }` endpoints of `connectGroup` at `index`.
+ * Returns false (with a JS exception pending) if it isn't a non-empty array of such objects.
+ */
+bool GetGroupEndpointsArg(const Napi::CallbackInfo& info, size_t index, std::vector<SRT_SOCKGROUPCONFIG>& members);
+
+/**
+ * Fills `members` with the current state of every member of `group`.
+ * Returns the number of members, or SRT_ERROR.
+ */
+int GetGroupData(SRTSOCKET group, std::vector<SRT_SOCKGROUPDATA>& members);
+
+/**
+ * Returns `[{ socket, host, port, state, status, weight, result, token }, ...]`.
+ */
+Napi::Array GroupDataToArray(Napi::Env env, const std::vector<SRT_SOCKGROUPDATA>& members);
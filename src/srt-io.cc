@@ -0,0 +1,426 @@
+#include "srt-io.h"
+#include "srt-address.h"
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <algorithm>
+
+using namespace std;
+
+bool GetMsgCtrlArg(const Napi::CallbackInfo& info, size_t index, Napi::Float64Array& array) {
+  if (info.Length() <= index || info[index].IsUndefined() || info[index].IsNull()) {
+    return true;
+  }
+  if (!info[index].IsTypedArray()
+    || info[index].As<Napi::TypedArray>().TypedArrayType() != napi_float64_array
+    || info[index].As<Napi::TypedArray>().ElementLength() < MSGCTRL_LENGTH) {
+    Napi::TypeError::New(info.Env(), "msgctrl must be a Float64Array of SRT.MSGCTRL_LENGTH values").ThrowAsJavaScriptException();
+    return false;
+  }
+  array = info[index].As<Napi::Float64Array>();
+  return true;
+}
+
+static_assert(sizeof(SRT_EPOLL_EVENT) == 2 * sizeof(int32_t), "SRT_EPOLL_EVENT must be a pair of int32");
+
+bool GetEpollEventsArg(const Napi::CallbackInfo& info, size_t index, Napi::Int32Array& array) {
+  if (!info[index].IsTypedArray()
+    || info[index].As<Napi::TypedArray>().TypedArrayType() != napi_int32_array
+    || info[index].As<Napi::TypedArray>().ElementLength() < 2) {
+    Napi::TypeError::New(info.Env(), "Events must be an Int32Array of (socket, events) pairs").ThrowAsJavaScriptException();
+    return false;
+  }
+  array = info[index].As<Napi::Int32Array>();
+  return true;
+}
+
+void MsgCtrlFromArray(const double* values, SRT_MSGCTRL& mctrl) {
+  srt_msgctrl_init(&mctrl);
+  mctrl.flags = (int)values[MSGCTRL_FLAGS];
+  mctrl.msgttl = (int)values[MSGCTRL_TTL];
+  mctrl.inorder = (int)values[MSGCTRL_INORDER];
+  mctrl.boundary = (int)values[MSGCTRL_BOUNDARY];
+  mctrl.srctime = (int64_t)values[MSGCTRL_SRCTIME];
+  mctrl.pktseq = (int32_t)values[MSGCTRL_PKTSEQ];
+  mctrl.msgno = (int32_t)values[MSGCTRL_NO];
+}
+
+void MsgCtrlToArray(const SRT_MSGCTRL& mctrl, double* values) {
+  values[MSGCTRL_FLAGS] = mctrl.flags;
+  values[MSGCTRL_TTL] = mctrl.msgttl;
+  values[MSGCTRL_INORDER] = mctrl.inorder;
+  values[MSGCTRL_BOUNDARY] = mctrl.boundary;
+  values[MSGCTRL_SRCTIME] = (double)mctrl.srctime;
+  values[MSGCTRL_PKTSEQ] = mctrl.pktseq;
+  values[MSGCTRL_NO] = mctrl.msgno;
+}
+
+static bool IsBlockingReceiver(SRTSOCKET socket) {
+  bool blocking = true;
+  int size = sizeof(blocking);
+  srt_getsockflag(socket, SRTO_RCVSYN, &blocking, &size);
+  return blocking;
+}
+
+static bool IsReadable(SRTSOCKET socket) {
+  int32_t events = 0;
+  int size = sizeof(events);
+  if (srt_getsockflag(socket, SRTO_EVENT, &events, &size) == SRT_ERROR) {
+    return false;
+  }
+  return (events & SRT_EPOLL_IN) != 0;
+}
+
+int RecvBatch(SRTSOCKET socket, char* data, int maxBytes, int maxMessages, vector<uint32_t>& offsets) {
+  offsets.assign(1, 0);
+
+  // a blocking receive would wait for the next message once the queue is drained,
+  // so on such sockets we only go on while SRT reports more data pending
+  bool blocking = IsBlockingReceiver(socket);
+  int used = 0;
+  int count = 0;
+  while (count < maxMessages) {
+    int space = maxBytes - used;
+    if (count > 0) {
+      if (space < SRT_LIVE_MAX_PLSIZE) {
+        break;
+      }
+      if (blocking && !IsReadable(socket)) {
+        break;
+      }
+    }
+    if (space <= 0) {
+      break;
+    }
+    int nb = srt_recvmsg(socket, data + used, space);
+    if (nb == SRT_ERROR) {
+      if (count > 0) {
+        break;
+      }
+      if (srt_getlasterror(nullptr) == SRT_EASYNCRCV) {
+        srt_clearlasterror();
+        return 0;
+      }
+      return SRT_ERROR;
+    }
+    used += nb;
+    offsets.push_back((uint32_t)used);
+    count++;
+  }
+  return count;
+}
+
+int SendMany(SRTSOCKET socket, const char* data, int length, int payloadSize) {
+  if (payloadSize <= 0) {
+    payloadSize = SRT_LIVE_DEF_PLSIZE;
+  }
+  int sent = 0;
+  while (sent < length) {
+    int size = min(payloadSize, length - sent);
+    int nb = srt_sendmsg2(socket, data + sent, size, nullptr);
+    if (nb == SRT_ERROR) {
+      if (sent > 0) {
+        break;
+      }
+      if (srt_getlasterror(nullptr) == SRT_EASYNCSND) {
+        srt_clearlasterror();
+        return 0;
+      }
+      return SRT_ERROR;
+    }
+    sent += nb;
+  }
+  return sent;
+}
+
+static bool IsUint8Array(const Napi::Value& value) {
+  return value.IsTypedArray() && value.As<Napi::TypedArray>().TypedArrayType() == napi_uint8_array;
+}
+
+static SendPart ToSendPart(const Napi::Value& value) {
+  Napi::Uint8Array array = value.As<Napi::Uint8Array>();
+  return SendPart{ (const char *)array.Data(), (int)array.ByteLength() };
+}
+
+bool GetSendPartsArg(const Napi::CallbackInfo& info, size_t index, vector<SendPart>& parts) {
+  if (IsUint8Array(info[index])) {
+    parts.push_back(ToSendPart(info[index]));
+    return true;
+  }
+  if (!info[index].IsArray()) {
+    Napi::TypeError::New(info.Env(), "Data must be a Buffer or an Array of Buffers").ThrowAsJavaScriptException();
+    return false;
+  }
+  Napi::Array array = info[index].As<Napi::Array>();
+  for (uint32_t i = 0; i < array.Length(); i++) {
+    Napi::Value value = array.Get(i);
+    if (!IsUint8Array(value)) {
+      Napi::TypeError::New(info.Env(), "Data must be a Buffer or an Array of Buffers").ThrowAsJavaScriptException();
+      return false;
+    }
+    SendPart part = ToSendPart(value);
+    if (part.length > 0) {
+      parts.push_back(part);
+    }
+  }
+  return true;
+}
+
+int SendMany(SRTSOCKET socket, const vector<SendPart>& parts, int payloadSize) {
+  if (payloadSize <= 0) {
+    payloadSize = SRT_LIVE_DEF_PLSIZE;
+  }
+  vector<char> message(payloadSize);
+  size_t part = 0;
+  int partOffset = 0;
+  int sent = 0;
+  while (part < parts.size()) {
+    const char* data;
+    int size;
+    if (parts[part].length - partOffset >= payloadSize) {
+      data = parts[part].data + partOffset;
+      size = payloadSize;
+    } else {
+      // gather a message from the tail of this part and the following ones
+      size = 0;
+      size_t p = part;
+      int offset = partOffset;
+      while (size < payloadSize && p < parts.size()) {
+        int n = min(payloadSize - size, parts[p].length - offset);
+        memcpy(message.data() + size, parts[p].data + offset, n);
+        size += n;
+        offset += n;
+        if (offset == parts[p].length) {
+          p++;
+          offset = 0;
+        }
+      }
+      data = message.data();
+    }
+    int nb = srt_sendmsg2(socket, data, size, nullptr);
+    if (nb == SRT_ERROR) {
+      if (sent > 0) {
+        break;
+      }
+      if (srt_getlasterror(nullptr) == SRT_EASYNCSND) {
+        srt_clearlasterror();
+        return 0;
+      }
+      return SRT_ERROR;
+    }
+    sent += size;
+    // advance over the bytes of the message
+    int left = size;
+    while (left > 0) {
+      int n = min(left, parts[part].length - partOffset);
+      left -= n;
+      partOffset += n;
+      if (partOffset == parts[part].length) {
+        part++;
+        partOffset = 0;
+      }
+    }
+  }
+  return sent;
+}
+
+int StartConnectSocket(SRTSOCKET socket, const sockaddr_storage& addr, int addrLen) {
+  bool sync = false;
+  if (srt_setsockflag(socket, SRTO_RCVSYN, &sync, sizeof(sync)) == SRT_ERROR) {
+    return SRT_ERROR;
+  }
+  return srt_connect(socket, (const sockaddr *)&addr, addrLen);
+}
+
+// options SRT still takes on a connected socket, the others only apply
+// when they are taken over from the listener at the handshake
+static bool IsPostConnectOption(int option) {
+  switch ((SRT_SOCKOPT)option) {
+    case SRTO_SNDSYN:
+    case SRTO_RCVSYN:
+    case SRTO_SNDTIMEO:
+    case SRTO_RCVTIMEO:
+    case SRTO_LINGER:
+    case SRTO_MAXBW:
+    case SRTO_INPUTBW:
+    case SRTO_MININPUTBW:
+    case SRTO_OHEADBW:
+    case SRTO_LOSSMAXTTL:
+    case SRTO_SNDDROPDELAY:
+    case SRTO_DRIFTTRACER:
+      return true;
+    default:
+      return false;
+  }
+}
+
+static int64_t SockOptNumber(const SockOptValue& value) {
+  switch (value.type) {
+    case SockOptValue::INT64:
+      return value.int64Value;
+    case SockOptValue::INT:
+      return value.intValue;
+    default:
+      return value.boolValue ? 1 : 0;
+  }
+}
+
+// sets `value` unless the socket has it already, so that options set
+// on a listener before it was bound can be passed again later
+static int UpdateSockOptValue(SRTSOCKET socket, int option, const SockOptValue& value) {
+  SockOptValue current;
+  if (GetSockOptValue(socket, option, current) != SRT_ERROR && current.type != SockOptValue::NONE) {
+    bool same = value.type == SockOptValue::STRING || current.type == SockOptValue::STRING
+      ? value.type == current.type && value.stringValue == current.stringValue
+      : SockOptNumber(value) == SockOptNumber(current);
+    if (same) {
+      return 0;
+    }
+  }
+  return SetSockOptValue(socket, option, value);
+}
+
+int AcceptMany(SRTSOCKET listener, int maxSockets, const SockOptValues& options, vector<AcceptedSocket>& accepted) {
+  SockOptValues socketOptions;
+  for (const auto& option : options) {
+    if (IsPostConnectOption(option.first)) {
+      socketOptions.push_back(option);
+    } else if (UpdateSockOptValue(listener, option.first, option.second) == SRT_ERROR) {
+      return SRT_ERROR;
+    }
+  }
+
+  while ((int)accepted.size() < maxSockets) {
+    if (!accepted.empty()) {
+      int events = 0;
+      int eventsSize = sizeof(events);
+      if (srt_getsockflag(listener, SRTO_EVENT, &events, &eventsSize) == SRT_ERROR
+        || (events & SRT_EPOLL_IN) == 0) {
+        break;
+      }
+    }
+    AcceptedSocket socket;
+    int addrSize = sizeof(socket.peerAddr);
+    socket.socket = srt_accept(listener, (sockaddr *)&socket.peerAddr, &addrSize);
+    if (socket.socket == SRT_INVALID_SOCK) {
+      if (!accepted.empty()) {
+        break;
+      }
+      if (srt_getlasterror(nullptr) == SRT_EASYNCRCV) {
+        srt_clearlasterror();
+        return 0;
+      }
+      return SRT_ERROR;
+    }
+    if (SetSockOptValues(socket.socket, socketOptions) == SRT_ERROR) {
+      // these options only fail on a connection that broke already, it is reported
+      // if nothing else was accepted and otherwise ends the batch, not to wait on the next accept
+      srt_close(socket.socket);
+      if (accepted.empty()) {
+        return SRT_ERROR;
+      }
+      break;
+    }
+    accepted.push_back(socket);
+  }
+  return (int)accepted.size();
+}
+
+Napi::Array AcceptedToArray(Napi::Env env, const vector<AcceptedSocket>& accepted) {
+  Napi::Array array = Napi::Array::New(env, accepted.size());
+  for (size_t i = 0; i < accepted.size(); i++) {
+    Napi::Object socket = Napi::Object::New(env);
+    socket.Set("socket", Napi::Number::New(env, accepted[i].socket));
+    socket.Set("host", Napi::String::New(env, SockAddrHost(accepted[i].peerAddr)));
+    socket.Set("port", Napi::Number::New(env, SockAddrPort(accepted[i].peerAddr)));
+    array.Set((uint32_t)i, socket);
+  }
+  return array;
+}
+
+int64_t SendFileRange(SRTSOCKET socket, const char* path, int64_t offset, int64_t size, int blockSize) {
+  if (blockSize <= 0) {
+    blockSize = FILE_TRANSFER_DEF_BLOCK;
+  }
+  // srt_sendfile seeks to the offset itself and moves it along
+  return srt_sendfile(socket, path, &offset, size, blockSize);
+}
+
+static int SeekFile(FILE* file, int64_t offset) {
+#if defined(_WIN32)
+  return _fseeki64(file, offset, SEEK_SET);
+#else
+  return fseeko(file, (off_t)offset, SEEK_SET);
+#endif
+}
+
+FILE* OpenRecvFile(const char* path) {
+  // "r+b" keeps what an earlier, interrupted, transfer already wrote
+  FILE* file = fopen(path, "r+b");
+  if (file == nullptr) {
+    file = fopen(path, "w+b");
+  }
+  return file;
+}
+
+int64_t RecvFileRange(SRTSOCKET socket, FILE* file, int64_t offset, int64_t size, int blockSize, int& fileError) {
+  fileError = 0;
+  if (blockSize <= 0) {
+    blockSize = FILE_TRANSFER_DEF_BLOCK;
+  }
+  if (SeekFile(file, offset) != 0) {
+    fileError = errno != 0 ? errno : EIO;
+    return SRT_ERROR;
+  }
+  vector<char> block((size_t)min<int64_t>(blockSize, max<int64_t>(size, 1)));
+  int64_t received = 0;
+  while (received < size) {
+    int length = (int)min<int64_t>((int64_t)block.size(), size - received);
+    int nb = srt_recv(socket, block.data(), length);
+    if (nb == SRT_ERROR) {
+      if (received > 0) {
+        break;
+      }
+      return SRT_ERROR;
+    }
+    if (nb == 0) {
+      break;
+    }
+    if (fwrite(block.data(), 1, nb, file) != (size_t)nb) {
+      if (received > 0) {
+        break;
+      }
+      fileError = errno != 0 ? errno : EIO;
+      return SRT_ERROR;
+    }
+    received += nb;
+  }
+  fflush(file);
+  return received;
+}
+
+Napi::Object RecvBatchToObject(Napi::Env env, char* data, const vector<uint32_t>& offsets) {
+  size_t used = offsets.back();
+
+  Napi::Object batch = Napi::Object::New(env);
+  if (used == 0) {
+    free(data);
+    batch.Set("buffer", Napi::Buffer<uint8_t>::New(env, 0));
+  } else {
+    // hand the memory over as is, only giving back what the batch didn't fill
+    char* shrunk = (char *)realloc(data, used);
+    if (shrunk != nullptr) {
+      data = shrunk;
+    }
+    batch.Set("buffer", Napi::Buffer<uint8_t>::New(env, (uint8_t *)data, used,
+      [](Napi::Env env, uint8_t* data) {
+        free(data);
+      }));
+  }
+
+  Napi::Uint32Array jsOffsets = Napi::Uint32Array::New(env, offsets.size());
+  memcpy(jsOffsets.Data(), offsets.data(), offsets.size() * sizeof(uint32_t));
+  batch.Set("offsets", jsOffsets);
+  return batch;
+}
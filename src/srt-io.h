@@ -0,0 +1,159 @@
+#pragma once
+
+#include <napi.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+#include "srt-values.h"
+
+#if defined(_WIN32)
+#include <srt.h>
+#else
+#include <srt/srt.h>
+#endif
+
+/**
+ * Layout of the Float64Array passed as `msgctrl` to read/write,
+ * one slot per SRT_MSGCTRL field.
+ */
+enum MsgCtrlField {
+  MSGCTRL_FLAGS = 0,
+  MSGCTRL_TTL,
+  MSGCTRL_INORDER,
+  MSGCTRL_BOUNDARY,
+  MSGCTRL_SRCTIME,
+  MSGCTRL_PKTSEQ,
+  MSGCTRL_NO,
+  MSGCTRL_LENGTH
+};
+
+/**
+ * Reads the optional `msgctrl` argument at `index`.
+ * Leaves `array` empty if it wasn't passed, returns false (with a JS exception pending)
+ * if it isn't a Float64Array of at least MSGCTRL_LENGTH values.
+ */
+bool GetMsgCtrlArg(const Napi::CallbackInfo& info, size_t index, Napi::Float64Array& array);
+
+void MsgCtrlFromArray(const double* values, SRT_MSGCTRL& mctrl);
+
+void MsgCtrlToArray(const SRT_MSGCTRL& mctrl, double* values);
+
+/**
+ * Reads the Int32Array argument of `epollUWaitInto` at `index`, which receives
+ * (socket, events) pairs laid out like SRT_EPOLL_EVENT.
+ * Returns false (with a JS exception pending) if it isn't an Int32Array of at least one pair.
+ */
+bool GetEpollEventsArg(const Napi::CallbackInfo& info, size_t index, Napi::Int32Array& array);
+
+/**
+ * Receives messages back to back into `data` until the socket would block,
+ * `maxMessages` were read or the space left can't hold another live payload.
+ *
+ * `offsets` gets the start of every message plus the end of the last one.
+ * Returns the number of messages (0 if none was pending on a non-blocking socket),
+ * or SRT_ERROR if the first receive failed. A failure after that ends the batch
+ * and is reported by the next call.
+ */
+int RecvBatch(SRTSOCKET socket, char* data, int maxBytes, int maxMessages, std::vector<uint32_t>& offsets);
+
+/**
+ * Sends `data` as consecutive messages of `payloadSize` bytes (the last one may be shorter).
+ *
+ * Returns the number of bytes sent. When the send buffer of a non-blocking socket
+ * fills up, or an error occurs after some messages went out, this is less than `length`.
+ * Returns SRT_ERROR only if the first message failed for another reason.
+ */
+int SendMany(SRTSOCKET socket, const char* data, int length, int payloadSize);
+
+/**
+ * A chunk of the data to send, pointing into a JS buffer.
+ */
+struct SendPart {
+  const char* data;
+  int length;
+};
+
+/**
+ * Reads the `buffer` argument of writeMany at `index`: a Buffer or an Array of Buffers.
+ * Returns false (with a JS exception pending) for anything else.
+ */
+bool GetSendPartsArg(const Napi::CallbackInfo& info, size_t index, std::vector<SendPart>& parts);
+
+/**
+ * Like SendMany, but repacks `parts` into messages of `payloadSize` bytes
+ * as if they were one buffer (only the last message may be shorter).
+ * Messages lying within one part are sent from it directly,
+ * only those straddling parts are copied together first.
+ */
+int SendMany(SRTSOCKET socket, const std::vector<SendPart>& parts, int payloadSize);
+
+/**
+ * Makes `socket` non-blocking for receiving (SRTO_RCVSYN false) and starts connecting it.
+ * Returns right away: the socket reports SRT_EPOLL_OUT once connected,
+ * or SRT_EPOLL_ERR if the connection failed (e.g after SRTO_CONNTIMEO).
+ */
+int StartConnectSocket(SRTSOCKET socket, const sockaddr_storage& addr, int addrLen);
+
+struct AcceptedSocket {
+  SRTSOCKET socket;
+  sockaddr_storage peerAddr;
+};
+
+/**
+ * Accepts up to `maxSockets` connections pending on `listener`, which stays open.
+ * Only the first accept may wait (on a blocking listener), the others
+ * are only made while the listener reports more pending connections.
+ * Options SRT only takes before connecting (latency, passphrase, payload size, ...)
+ * are set on the listener, for the sockets of the connections it takes from then on.
+ * Pass `maxSockets` 0 to only do that, before the listener is bound.
+ * The others (blocking mode, timeouts, bandwidth, ...) are set on each accepted socket.
+ *
+ * Returns the number of sockets accepted (0 if none was pending on a non-blocking listener),
+ * or SRT_ERROR if the listener did not take an option or the first accept
+ * (or setting the options of its socket, which is then closed) failed.
+ */
+int AcceptMany(SRTSOCKET listener, int maxSockets, const SockOptValues& options, std::vector<AcceptedSocket>& accepted);
+
+/**
+ * Returns `[{ socket, host, port }, ...]`.
+ */
+Napi::Array AcceptedToArray(Napi::Env env, const std::vector<AcceptedSocket>& accepted);
+
+/**
+ * Default bytes per srt_sendfile block / srt_recv call of a file transfer.
+ */
+#define FILE_TRANSFER_DEF_BLOCK (1024 * 1024)
+
+/**
+ * Sends `size` bytes of the file at `path`, starting at `offset`, with srt_sendfile.
+ * The socket should be a blocking one using SRTT_FILE.
+ *
+ * Returns the number of bytes sent, or SRT_ERROR.
+ */
+int64_t SendFileRange(SRTSOCKET socket, const char* path, int64_t offset, int64_t size, int blockSize);
+
+/**
+ * Receives `size` bytes with srt_recv into `file` at `offset`, `blockSize` bytes at a time.
+ * Unlike srt_recvfile, this leaves the rest of the file untouched,
+ * so an interrupted transfer can be resumed where it stopped.
+ *
+ * Returns the number of bytes written, which is less than `size` if the socket
+ * or the file failed after some data went through. Returns SRT_ERROR if the
+ * seek or the first receive or write failed. `fileError` is then the errno
+ * of the file call, or 0 if it was SRT that failed (srt_getlasterror tells why).
+ */
+int64_t RecvFileRange(SRTSOCKET socket, FILE* file, int64_t offset, int64_t size, int blockSize, int& fileError);
+
+/**
+ * Opens `path` for RecvFileRange, creating it if needed without truncating it.
+ * Returns nullptr (with errno set) on failure.
+ */
+FILE* OpenRecvFile(const char* path);
+
+/**
+ * Returns `{ buffer, offsets }` for a batch received into `data`,
+ * which must come from malloc and is owned by the returned Buffer.
+ */
+Napi::Object RecvBatchToObject(Napi::Env env, char* data, const std::vector<uint32_t>& offsets);
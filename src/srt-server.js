@@ -3,16 +3,20 @@ const { AsyncReaderWriter } = require('./async-reader-writer');
 const { SRT } = require('../build/Release/node_srt.node');
 
 const EventEmitter = require("events");
+const { performance } = require('perf_hooks');
 const debug = require('debug')('srt-server');
 
 const DEBUG = false;
 
 const EPOLL_PERIOD_MS_DEFAULT = 0;
 
-const EPOLLUWAIT_TIMEOUT_MS = 0;
-
 const SOCKET_LISTEN_BACKLOG = 128;
 
+const SHARDS_DEFAULT = 1;
+
+// connections accepted per listener event at most
+const ACCEPT_BATCH_MAX = 64;
+
 /**
  * @emits data
  * @emits closing
@@ -23,13 +27,16 @@ class SRTConnection extends EventEmitter {
    *
    * @param {AsyncSRT} asyncSrt
    * @param {number} fd
+   * @param {{host: string, port: number}} peer optional
    */
-  constructor(asyncSrt, fd) {
+  constructor(asyncSrt, fd, peer = null) {
     super();
 
     this._asyncSrt = asyncSrt;
     this._fd = fd;
+    this._peer = peer;
     this._gotFirstData = false;
+    this._fanOut = null;
   }
 
   /**
@@ -39,6 +46,15 @@ class SRTConnection extends EventEmitter {
     return this._fd;
   }
 
+  /**
+   * Address of the caller, null if unknown.
+   *
+   * @returns {{host: string, port: number} | null}
+   */
+  get peer() {
+    return this._peer;
+  }
+
   /**
    * Will be false until *after* emit of first `data` event.
    * After that will be true.
@@ -76,7 +92,7 @@ class SRTConnection extends EventEmitter {
    * where the error is thrown (on the binding call to the native SRT API),
    * and in the async API internals as it gets propagated back from the task-runner).
    *
-   * Note that any underlying data buffer passed in
+   * Note that with the `worker` transport any underlying data buffer passed in
    * will be *neutered* by our worker thread and
    * therefore become unusable (i.e go to detached state, `byteLengh === 0`)
    * for the calling thread of this method.
@@ -89,11 +105,31 @@ class SRTConnection extends EventEmitter {
     return await this._asyncSrt.write(this.fd, chunk);
   }
 
+  /**
+   * Sends every message `fanOut` receives to this connection, natively,
+   * until `unsubscribe` is called or the connection is closed.
+   *
+   * @param {SRTFanOut} fanOut
+   * @param {number} policy optional, one of `SRTFanOut.POLICY_*`, default: the one of `fanOut`
+   */
+  subscribe(fanOut, policy) {
+    this.unsubscribe();
+    fanOut.addSubscriber(this.fd, policy);
+    this._fanOut = fanOut;
+  }
+
+  unsubscribe() {
+    if (!this._fanOut) return;
+    this._fanOut.removeSubscriber(this.fd);
+    this._fanOut = null;
+  }
+
   /**
    * @returns {Promise<SRTResult | null>}
    */
   async close() {
     if (this.isClosed()) return null;
+    this.unsubscribe();
     const asyncSrt = this._asyncSrt;
     this._asyncSrt = null;
     this.emit('closing');
@@ -115,6 +151,44 @@ class SRTConnection extends EventEmitter {
   }
 }
 
+/**
+ * One slice of the server: its own `AsyncSRT` (native threads or worker),
+ * its own epoll set and the connections assigned to it.
+ *
+ * @private
+ */
+class SRTServerShard {
+  /**
+   *
+   * @param {number} index
+   * @param {AsyncSRT} asyncSrt
+   */
+  constructor(index, asyncSrt) {
+    this.index = index;
+    this.asyncSrt = asyncSrt;
+    this.epid = null;
+    this.connections = 0;
+    this.accepted = 0;
+    this.events = 0;
+    this.eventBatches = 0;
+    this.busyMs = 0;
+  }
+
+  /**
+   * @returns {SRTServerShardMetrics}
+   */
+  getMetrics() {
+    return {
+      index: this.index,
+      connections: this.connections,
+      accepted: this.accepted,
+      events: this.events,
+      eventBatches: this.eventBatches,
+      busyMs: this.busyMs
+    };
+  }
+}
+
 /**
  * @emits created
  * @emits opened
@@ -128,41 +202,80 @@ class SRTServer extends EventEmitter {
    *
    * @param {number} port socket port number
    * @param {string} address optional, default: '0.0.0.0'
-   * @param {number} epollPeriodMs optional, default: EPOLL_PERIOD_MS_DEFAULT
+   * @param {number} epollPeriodMs optional, minimum delay between two handled event batches, default: EPOLL_PERIOD_MS_DEFAULT
+   * @param {SRTServerOptions} options optional
    * @returns {Promise<SRTServer>}
    */
-  static create(port, address, epollPeriodMs) {
-    return new SRTServer(port, address, epollPeriodMs).create();
+  static create(port, address, epollPeriodMs, options) {
+    return new SRTServer(port, address, epollPeriodMs, options).create();
   }
 
   /**
+   * With `options.shards` > 1 accepted connections are spread over that many shards.
+   * Each shard has its own `AsyncSRT` instance and epoll set (waited on by its own
+   * native thread), so a slow call on one shard doesn't stall the connections of the others.
+   * A connection stays on the shard it was assigned to on accept, the one with the fewest connections.
    *
    * @param {number} port socket port number
    * @param {string} address optional, default: '0.0.0.0'
-   * @param {number} epollPeriodMs optional, default: EPOLL_PERIOD_MS_DEFAULT
+   * @param {number} epollPeriodMs optional, minimum delay between two handled event batches, default: EPOLL_PERIOD_MS_DEFAULT
+   * @param {SRTServerOptions} options optional, `shards` (default: 1), `transport` and `threadsPerShard` for each `AsyncSRT`,
+   *   `acceptOptions` socket options (`{ [option]: value }`) set natively on every accepted socket
    */
-  constructor(port, address = '0.0.0.0', epollPeriodMs = EPOLL_PERIOD_MS_DEFAULT) {
+  constructor(port, address = '0.0.0.0', epollPeriodMs = EPOLL_PERIOD_MS_DEFAULT, options = {}) {
     super();
 
     if (!Number.isInteger(port) || port <= 0 || port > 65535)
       throw new Error('Need a valid port number but got: ' + port);
 
+    const shards = options.shards === undefined ? SHARDS_DEFAULT : options.shards;
+    if (!Number.isInteger(shards) || shards < 1)
+      throw new Error('Need a positive number of shards but got: ' + shards);
+
     this.port = port;
     this.address = address;
     this.epollPeriodMs = epollPeriodMs;
     this.socket = null;
     this.epid = null;
-
-    this._pollEventsTimer = null;
-    this._asyncSrt = new AsyncSRT();
+    this.acceptOptions = options.acceptOptions || {};
+
+    this._shards = [];
+    for (let i = 0; i < shards; i++) {
+      const asyncSrt = new AsyncSRT({
+        transport: options.transport,
+        threads: options.threadsPerShard
+      });
+      this._shards.push(new SRTServerShard(i, asyncSrt));
+    }
+    // the first shard also owns the listener socket
+    this._asyncSrt = this._shards[0].asyncSrt;
+    // only used to run the native epoll event pumps
+    this._srt = new SRT();
     this._connectionMap = {};
   }
 
+  /**
+   * @returns {number}
+   */
+  get shards() {
+    return this._shards.length;
+  }
+
   async dispose() {
-    clearTimeout(this._pollEventsTimer);
+    for (const shard of this._shards) {
+      if (shard.epid !== null) {
+        this._srt.epollUnwatch(shard.epid);
+        await shard.asyncSrt.epollRelease(shard.epid);
+        shard.epid = null;
+      }
+    }
+    this.epid = null;
     await this._asyncSrt.close(this.socket);
     this.socket = null;
-    const res = await this._asyncSrt.dispose();
+    let res;
+    for (const shard of this._shards) {
+      res = await shard.asyncSrt.dispose();
+    }
     this._asyncSrt = null;
     this.emit('disposed');
     return res;
@@ -188,6 +301,12 @@ class SRTServer extends EventEmitter {
    */
   async open() {
     let result;
+    // hands the accept options SRT only takes before connecting to the listener,
+    // so that the first connections get them as well
+    result = await this._asyncSrt.acceptMany(this.socket, 0, this.acceptOptions);
+    if (result === SRT.ERROR) {
+      throw new Error('SRT.acceptMany() failed to set the accept options on the listener');
+    }
     result = await this._asyncSrt.bind(this.socket, this.address, this.port);
     if (result === SRT.ERROR) {
       throw new Error('SRT.bind() failed');
@@ -196,11 +315,14 @@ class SRTServer extends EventEmitter {
     if (result === SRT.ERROR) {
       throw new Error('SRT.listen() failed');
     }
-    result = await this._asyncSrt.epollCreate();
-    if (result === SRT.ERROR) {
-      throw new Error('SRT.epollCreate() failed');
+    for (const shard of this._shards) {
+      result = await shard.asyncSrt.epollCreate();
+      if (result === SRT.ERROR) {
+        throw new Error('SRT.epollCreate() failed');
+      }
+      shard.epid = result;
     }
-    this.epid = result;
+    this.epid = this._shards[0].epid;
 
     this.emit('opened');
 
@@ -210,7 +332,9 @@ class SRTServer extends EventEmitter {
     // since the `opened` event handlers above may do whatever
     await this._asyncSrt.epollAddUsock(this.epid, this.socket, SRT.EPOLL_IN | SRT.EPOLL_ERR);
 
-    this._pollEvents();
+    for (const shard of this._shards) {
+      this._srt.epollWatch(shard.epid, this._onEpollEvents.bind(this, shard));
+    }
 
     return this;
   }
@@ -232,6 +356,25 @@ class SRTServer extends EventEmitter {
     return Promise.all(promises);
   }
 
+  /**
+   * Rejects callers by stream id natively during the handshake,
+   * see `AsyncSRT#setStreamIdFilter`. Call this after `create`, before `open`.
+   *
+   * @param {string[]} allow
+   * @param {string[]} deny
+   * @returns {Promise<SRTResult>}
+   */
+  setStreamIdFilter(allow = [], deny = []) {
+    return this._asyncSrt.setStreamIdFilter(this.socket, allow, deny);
+  }
+
+  /**
+   * @returns {Promise<{accepted: number, rejected: number} | null>}
+   */
+  getStreamIdFilterStats() {
+    return this._asyncSrt.getStreamIdFilterStats(this.socket);
+  }
+
   /**
    *
    * @param {number} fd
@@ -248,35 +391,44 @@ class SRTServer extends EventEmitter {
     return Array.from(Object.values(this._connectionMap));
   }
 
+  /**
+   * Load of every shard: current and accepted connections,
+   * handled epoll events and batches, and time spent handling them.
+   *
+   * @returns {SRTServerShardMetrics[]}
+   */
+  getShardMetrics() {
+    return this._shards.map((shard) => shard.getMetrics());
+  }
+
+  /**
+   * @private
+   * @returns {SRTServerShard} the shard with the fewest connections
+   */
+  _pickShard() {
+    return this._shards.reduce((least, shard) =>
+      shard.connections < least.connections ? shard : least);
+  }
+
   /**
    * @private
+   * @param {SRTServerShard} shard
    * @param {SRTEpollEvent} event
    */
-  async _handleEvent(event) {
-    const status = await this._asyncSrt.getSockState(event.socket);
+  async _handleEvent(shard, event) {
+    const asyncSrt = shard.asyncSrt;
 
     // our local listener socket
     if (event.socket === this.socket) {
+      await this._acceptPending(asyncSrt);
+      return;
+    }
 
-      if (status === SRT.SRTS_LISTENING) {
-        const fd = await this._asyncSrt.accept(this.socket);
-        // no need to await the epoll subscribe result before continuing
-        this._asyncSrt.epollAddUsock(this.epid, fd, SRT.EPOLL_IN | SRT.EPOLL_ERR);
-        debug("Accepted client connection with file-descriptor:", fd);
-        // create new client connection handle
-        // and emit accept event
-        const connection = new SRTConnection(this._asyncSrt, fd);
-        connection.on('closing', () => {
-          // remove handle
-          delete this._connectionMap[fd];
-        });
-        this._connectionMap[fd] = connection;
-        this.emit('connection', connection);
-      }
+    const status = await asyncSrt.getSockState(event.socket);
 
     // a client socket / fd
     // check if broken or closed
-    } else if (status === SRT.SRTS_BROKEN
+    if (status === SRT.SRTS_BROKEN
       || status === SRT.SRTS_NONEXIST
       || status === SRT.SRTS_CLOSED) {
       const fd = event.socket;
@@ -284,6 +436,9 @@ class SRTServer extends EventEmitter {
       if (this._connectionMap[fd]) {
         await this._connectionMap[fd].close();
         this.emit('disconnection', fd);
+      } else {
+        // already closed on our side, just drop the subscription
+        await asyncSrt.epollRemoveUsock(shard.epid, fd);
       }
     // not broken, just new data
     } else {
@@ -292,6 +447,7 @@ class SRTServer extends EventEmitter {
       const connection = this.getConnectionByHandle(fd);
       if (!connection) {
         console.warn("Got event for fd not in connections map:", fd);
+        await asyncSrt.epollRemoveUsock(shard.epid, fd);
         return;
       }
       connection.onData();
@@ -299,20 +455,65 @@ class SRTServer extends EventEmitter {
   }
 
   /**
+   * Accepts all connections pending on the listener in one call
+   * and assigns each one to a shard.
+   *
    * @private
+   * @param {AsyncSRT} asyncSrt the one of the listener shard
    */
-  async _pollEvents() {
-    const events = await this._asyncSrt.epollUWait(this.epid, EPOLLUWAIT_TIMEOUT_MS);
-    events.forEach((event) => {
-      this._handleEvent(event);
-    });
-
-    // clearing in case we get called multiple times
-    // when already timer scheduled
-    // will be no-op if timer-id invalid or old
-    clearTimeout(this._pollEventsTimer);
-    this._pollEventsTimer
-      = setTimeout(this._pollEvents.bind(this), this.epollPeriodMs)
+  async _acceptPending(asyncSrt) {
+    const accepted = await asyncSrt.acceptMany(this.socket, ACCEPT_BATCH_MAX, this.acceptOptions);
+    if (accepted === SRT.ERROR) {
+      console.error('SRTServer: accept failed on listener:', this.socket);
+      return;
+    }
+    for (const { socket: fd, host, port } of accepted) {
+      const target = this._pickShard();
+      // no need to await the epoll subscribe result before continuing
+      target.asyncSrt.epollAddUsock(target.epid, fd, SRT.EPOLL_IN | SRT.EPOLL_ERR);
+      target.connections++;
+      target.accepted++;
+      debug("Accepted client connection with file-descriptor:", fd, "from:", host, port, "on shard:", target.index);
+      // create new client connection handle
+      // and emit accept event
+      const connection = new SRTConnection(target.asyncSrt, fd, { host, port });
+      connection.on('closing', () => {
+        // stop reporting the fd before SRT may reuse it for another socket
+        if (target.epid !== null) {
+          target.asyncSrt.epollRemoveUsock(target.epid, fd);
+        }
+        target.connections--;
+        // remove handle
+        delete this._connectionMap[fd];
+      });
+      this._connectionMap[fd] = connection;
+      this.emit('connection', connection);
+    }
+  }
+
+  /**
+   * Called by the native epoll pump of a shard for each batch of its ready sockets.
+   * The pump waits for the returned promise before reporting the next batch.
+   *
+   * @private
+   * @param {SRTServerShard} shard
+   * @param {SRTEpollEvent[] | null} events
+   * @param {string} err set when waiting on the epoll failed
+   * @returns {Promise<void>}
+   */
+  async _onEpollEvents(shard, events, err) {
+    if (err) {
+      console.error(`SRTServer: epoll wait failed on shard ${shard.index}:`, err);
+      return;
+    }
+    const start = performance.now();
+    shard.events += events.length;
+    shard.eventBatches++;
+    await Promise.all(events.map((event) => this._handleEvent(shard, event)));
+    shard.busyMs += performance.now() - start;
+    if (this.epollPeriodMs > 0) {
+      await new Promise((resolve) => setTimeout(resolve, this.epollPeriodMs));
+    }
   }
 }
 
@@ -0,0 +1,140 @@
+const { SRT } = require('../build/Release/node_srt.node');
+const debug = require('debug')('srt-socket-waiter');
+
+/**
+ * Waits for non-blocking sockets to become readable or writable on one shared epoll,
+ * reported by the native epoll event pump, instead of retrying a call on every event-loop turn.
+ *
+ * All calls are non-blocking, so they are made on the main thread.
+ * The epoll (and the thread of its pump) is released while nothing is waited for,
+ * so it doesn't keep the process alive.
+ */
+class SRTSocketWaiter {
+  constructor() {
+    this._srt = new SRT();
+    this._epid = null;
+    this._releasing = false;
+    /**
+     * @type {Map<number, {events: number, resolvers: Function[]}>}
+     */
+    this._waiting = new Map();
+  }
+
+  /**
+   * Resolves with the events reported for the socket once one of `events`
+   * (or `EPOLL_ERR`) is. A socket that can't be waited on (e.g closed)
+   * resolves right away with `EPOLL_ERR`, the next call on it will tell why.
+   *
+   * @param {number} socket
+   * @param {number} events SRT.EPOLL_IN and/or SRT.EPOLL_OUT
+   * @returns {Promise<number>}
+   */
+  wait(socket, events) {
+    return new Promise((resolve) => {
+      let waiter = this._waiting.get(socket);
+      const wanted = (waiter ? waiter.events : 0) | events | SRT.EPOLL_ERR;
+      try {
+        if (this._epid === null) {
+          this._epid = this._srt.epollCreate();
+          this._srt.epollWatch(this._epid, this._onEpollEvents.bind(this));
+        }
+        if (!waiter) {
+          this._srt.epollAddUsock(this._epid, socket, wanted);
+        } else if (wanted !== waiter.events) {
+          this._srt.epollUpdateUsock(this._epid, socket, wanted);
+        }
+      } catch (err) {
+        debug("Can't wait on socket:", socket, err.message);
+        resolve(SRT.EPOLL_ERR);
+        return;
+      }
+      if (!waiter) {
+        waiter = { events: wanted, resolvers: [] };
+        this._waiting.set(socket, waiter);
+      }
+      waiter.events = wanted;
+      waiter.resolvers.push(resolve);
+    });
+  }
+
+  /**
+   * @private
+   * @param {SRTEpollEvent[] | null} events
+   * @param {string} err
+   */
+  _onEpollEvents(events, err) {
+    if (err) {
+      debug("Epoll wait failed:", err);
+      // the pump stopped, every waiter tries its call again
+      const sockets = Array.from(this._waiting.keys());
+      this._srt.epollRelease(this._epid);
+      this._epid = null;
+      sockets.forEach((socket) => this._settle(socket, SRT.EPOLL_ERR));
+      return;
+    }
+    events.forEach(({ socket, events: reported }) => {
+      if (!this._waiting.has(socket)) {
+        return;
+      }
+      try {
+        this._srt.epollRemoveUsock(this._epid, socket);
+      } catch (err) {
+        // closed meanwhile, which took it off the epoll already
+      }
+      this._settle(socket, reported);
+    });
+    this._releaseWhenIdle();
+  }
+
+  /**
+   * @private
+   * @param {number} socket
+   * @param {number} events
+   */
+  _settle(socket, events) {
+    const waiter = this._waiting.get(socket);
+    this._waiting.delete(socket);
+    waiter.resolvers.forEach((resolve) => resolve(events));
+  }
+
+  /**
+   * Released on the next turn rather than from within the pump callback,
+   * and only if nobody started waiting again meanwhile.
+   *
+   * @private
+   */
+  _releaseWhenIdle() {
+    if (this._waiting.size > 0 || this._releasing) {
+      return;
+    }
+    this._releasing = true;
+    setImmediate(() => {
+      this._releasing = false;
+      if (this._waiting.size === 0 && this._epid !== null) {
+        this._srt.epollRelease(this._epid);
+        this._epid = null;
+      }
+    });
+  }
+}
+
+let sharedWaiter = null;
+
+/**
+ * Waits on the epoll shared by the async read and write modes (see `SRTSocketWaiter#wait`).
+ *
+ * @param {number} socket
+ * @param {number} events
+ * @returns {Promise<number>}
+ */
+function waitForSocket(socket, events) {
+  if (sharedWaiter === null) {
+    sharedWaiter = new SRTSocketWaiter();
+  }
+  return sharedWaiter.wait(socket, events);
+}
+
+module.exports = {
+  SRTSocketWaiter,
+  waitForSocket
+};
@@ -2,11 +2,16 @@ const { Readable } = require('stream');
 const { SRT } = require('../build/Release/node_srt.node');
 const debug = require('debug')('srt-read-stream');
 
-const CONNECTION_ACCEPT_POLLING_INTERVAL_MS = 50;
-const READ_WAIT_INTERVAL_MS = 50;
-
-const EPOLLUWAIT_TIMEOUT_MS = 1000;
 const SOCKET_LISTEN_BACKLOG = 10;
+const ACCEPT_BATCH_MAX = 64;
+const READ_BATCH_MAX_MESSAGES = 256;
+// SRT_LIVE_MAX_PLSIZE, so a batch always has room for at least one message
+const SRT_LIVE_MAX_PAYLOAD = 1456;
+
+const EPOLL_READ_EVENTS = SRT.EPOLL_IN | SRT.EPOLL_ERR | SRT.EPOLL_ET;
+
+// constructor option used internally to create the streams of further connections
+const kAcceptedConnection = Symbol('acceptedConnection');
 
 /**
  * Example:
@@ -18,22 +23,36 @@ const SOCKET_LISTEN_BACKLOG = 10;
  *   readStream.pipe(dest);
  * })
  *
+ * In listener mode the stream keeps accepting connections: the first one to
+ * send data is read by this stream, every later one is emitted as
+ * a `'connection'` event with its own `SRTReadStream`.
+ *
+ * Reading is driven by the native epoll pump. Every pull drains as many
+ * messages as the consumer asked for (at least up to `highWaterMark`) in one
+ * binding call, and a stream that is paused is not woken up by new data at all.
  */
 class SRTReadStream extends Readable {
-  // Q: opts not used ?
   // Q: not better if port (mandatory) is before, and address is optional (default to "0.0.0.0")?
-  constructor(address, port, opts) {
-    super();
+  /**
+   * @param {string} address
+   * @param {number} port
+   * @param {ReadableOptions} [opts] passed on to `Readable` (e.g `highWaterMark`)
+   */
+  constructor(address, port, opts = {}) {
+    const accepted = opts[kAcceptedConnection] || null;
+    const readableOpts = Object.assign({}, opts);
+    delete readableOpts[kAcceptedConnection];
+    super(readableOpts);
 
     /**
      * @member {SRT}
      */
-    this.srt = new SRT();
+    this.srt = accepted ? accepted.listener.srt : new SRT();
 
     /**
      * @member {number}
      */
-    this.socket = this.srt.createSocket();
+    this.socket = accepted ? accepted.fd : this.srt.createSocket();
 
     /**
      * @member {string}
@@ -48,10 +67,22 @@ class SRTReadStream extends Readable {
     /**
      * @member {number | null}
      */
-    this.fd = null;
+    this.fd = accepted ? accepted.fd : null;
 
-    this._eventPollInterval = null;
-    this._readTimer = null;
+    // the stream owning the epoll, this one for listeners and callers
+    this._listener = accepted ? accepted.listener : this;
+    this._epid = null;
+    // read streams by fd, of all connections watched by our epoll
+    this._connections = new Map();
+    // accepted connections which did not send anything yet
+    this._accepted = new Set();
+    // bytes requested by a `_read` that found the socket empty,
+    // resumed when the epoll pump reports the socket readable
+    this._pendingReadBytes = 0;
+    // whether our fd is subscribed to EPOLL_IN, false while paused
+    this._readInterest = true;
+    this._fdClosed = false;
+    this._readOpts = readableOpts;
   }
 
   /**
@@ -67,35 +98,43 @@ class SRTReadStream extends Readable {
     this.srt.bind(this.socket, this.address, this.port);
     this.srt.listen(this.socket, SOCKET_LISTEN_BACKLOG);
 
-    const epid = this.srt.epollCreate();
-    this.srt.epollAddUsock(epid, this.socket, SRT.EPOLL_IN | SRT.EPOLL_ERR);
-
-    const interval = this._eventPollInterval = setInterval(() => {
-      const events = this.srt.epollUWait(epid, EPOLLUWAIT_TIMEOUT_MS);
-      events.forEach(event => {
-        const status = this.srt.getSockState(event.socket);
-        if (status === SRT.SRTS_BROKEN || status === SRT.SRTS_NONEXIST || status === SRT.SRTS_CLOSED) {
-          debug("Client disconnected with socket:", event.socket);
-          this.srt.close(event.socket);
-          this.push(null);
-          this.emit('end');
-        } else if (event.socket === this.socket) {
-          const fhandle = this.srt.accept(this.socket);
-          debug("Accepted client connection with file-descriptor:", fhandle);
-          this.srt.epollAddUsock(epid, fhandle, SRT.EPOLL_IN | SRT.EPOLL_ERR);
-          this.emit('readable');
-        } else {
-          debug("Got data from connection on fd:", event.socket);
-          this.fd = event.socket;
-          clearInterval(interval);
-          onData(this);
-          this.emit('readable');
-        }
-      });
-    }, CONNECTION_ACCEPT_POLLING_INTERVAL_MS);
+    this._watch(this.socket, SRT.EPOLL_IN | SRT.EPOLL_ERR, (event) => {
+      if (event.socket === this.socket) {
+        this._acceptPending();
+        return;
+      }
+      if (this._handleBrokenSocket(event.socket)) {
+        return;
+      }
+      const stream = this._connections.get(event.socket);
+      if (stream) {
+        stream._onSocketReadable();
+        return;
+      }
+      if (!this._accepted.delete(event.socket)) {
+        return;
+      }
+      debug("Got data from connection on fd:", event.socket);
+      if (this.fd === null) {
+        this.fd = event.socket;
+        this._connections.set(this.fd, this);
+        onData(this);
+        this.emit('readable');
+        this._onSocketReadable();
+      } else {
+        const connection = new SRTReadStream(this.address, this.port,
+          Object.assign({}, this._readOpts, {
+            [kAcceptedConnection]: { listener: this, fd: event.socket }
+          }));
+        this._connections.set(event.socket, connection);
+        this.emit('connection', connection);
+      }
+    });
   }
 
   /**
+   * Connects without blocking: `onConnect` is called once the handshake is done.
+   * If the connection fails, the stream ends without calling it.
    *
    * @param {Function} onConnect
    */
@@ -105,11 +144,25 @@ class SRTReadStream extends Readable {
       throw new Error('connect() called but stream file-descriptor already initialized');
     }
 
-    this.srt.connect(this.socket, this.address, this.port);
-    this.fd = this.socket;
-    if (this.fd) {
-      onConnect(this);
-    }
+    // makes the socket non-blocking for reading too
+    this.srt.startConnect(this.socket, this.address, this.port);
+
+    this._watch(this.socket, SRT.EPOLL_OUT | SRT.EPOLL_ERR, (event) => {
+      if (this._handleBrokenSocket(event.socket)) {
+        return;
+      }
+      if (this.fd === null) {
+        if (this.srt.getSockState(event.socket) !== SRT.SRTS_CONNECTED) {
+          return;
+        }
+        this.fd = this.socket;
+        this._connections.set(this.fd, this);
+        // from now on only wait for data
+        this.srt.epollUpdateUsock(this._epid, this.fd, EPOLL_READ_EVENTS);
+        onConnect(this);
+      }
+      this._onSocketReadable();
+    });
   }
 
   close() {
@@ -124,34 +177,132 @@ class SRTReadStream extends Readable {
     return this.srt.stats(this.fd, clear);
   }
 
-  _scheduleNextRead(requestedBytes, timeoutMs) {
-    this._readTimer = setTimeout(this._readSocketAndPush.bind(this, requestedBytes), timeoutMs);
+  /**
+   * Creates our epoll and lets the native event pump call `onEvent`
+   * for every event on it, instead of polling from a timer.
+   *
+   * @private
+   * @param {number} socket
+   * @param {number} events
+   * @param {Function} onEvent
+   */
+  _watch(socket, events, onEvent) {
+    this._epid = this.srt.epollCreate();
+    this.srt.epollAddUsock(this._epid, socket, events);
+    this.srt.epollWatch(this._epid, (epollEvents, err) => {
+      if (err) {
+        debug("Epoll wait failed:", err);
+        return;
+      }
+      epollEvents.forEach(onEvent);
+    });
+  }
+
+  /**
+   * Accepts all pending connections (the listener stays open) and waits
+   * for them to send data, edge-triggered: we read until a socket is empty anyway,
+   * and connections nobody reads from won't keep waking us up.
+   *
+   * @private
+   */
+  _acceptPending() {
+    const accepted = this.srt.acceptMany(this.socket, ACCEPT_BATCH_MAX, {
+      [SRT.SRTO_RCVSYN]: false
+    });
+    if (accepted === SRT.ERROR) {
+      debug("Accept failed on listener:", this.socket);
+      return;
+    }
+    accepted.forEach(({ socket, host, port }) => {
+      debug("Accepted client connection with file-descriptor:", socket, host, port);
+      this._accepted.add(socket);
+      this.srt.epollAddUsock(this._epid, socket, EPOLL_READ_EVENTS);
+    });
+  }
+
+  /**
+   * @private
+   * @param {number} socket
+   * @returns {boolean} true if the socket was broken and got closed
+   */
+  _handleBrokenSocket(socket) {
+    const status = this.srt.getSockState(socket);
+    if (status !== SRT.SRTS_BROKEN && status !== SRT.SRTS_NONEXIST && status !== SRT.SRTS_CLOSED) {
+      return false;
+    }
+    debug("Client disconnected with socket:", socket);
+    const stream = this._connections.get(socket);
+    if (stream) {
+      stream._end();
+    } else if (this._accepted.delete(socket)) {
+      // closing also drops the socket from our epoll
+      this.srt.close(socket);
+    } else if (socket === this.socket) {
+      this._end();
+    }
+    return true;
   }
 
-  _clearScheduledRead() {
-    clearTimeout(this._readTimer);
-    this._readTimer = null;
+  /**
+   * Closes our connection (once) and ends the stream.
+   *
+   * @private
+   */
+  _end() {
+    if (this.fd !== null && !this._fdClosed) {
+      this._fdClosed = true;
+      this.srt.close(this.fd);
+    }
+    this.push(null);
+    this.emit('end');
+  }
+
+  /**
+   * @private
+   */
+  _onSocketReadable() {
+    if (this._pendingReadBytes > 0) {
+      this._readSocketAndPush(this._pendingReadBytes);
+    }
+  }
+
+  /**
+   * Subscribes our fd to data events or, while the consumer doesn't want
+   * any data, only to errors, so a paused stream is never woken up.
+   *
+   * @private
+   * @param {boolean} interested
+   */
+  _setReadInterest(interested) {
+    const epid = this._listener._epid;
+    if (this._readInterest === interested || this.fd === null || epid === null) {
+      return;
+    }
+    this._readInterest = interested;
+    this.srt.epollUpdateUsock(epid, this.fd,
+      interested ? EPOLL_READ_EVENTS : SRT.EPOLL_ERR);
   }
 
   _readSocketAndPush(bytes) {
-    this._clearScheduledRead();
+    this._pendingReadBytes = 0;
     if (this.fd === null) {
-      this._scheduleNextRead(bytes, READ_WAIT_INTERVAL_MS);
+      this._pendingReadBytes = bytes;
       return;
     }
     let remainingBytes = bytes;
     while(true) {
-      const buffer = this.srt.read(this.fd, bytes);
-      if (buffer === null) { // connection likely died
-        debug("Socket read call returned 'null'");
+      // drains all messages pending (up to `remainingBytes`) in one binding call
+      const batch = this.srt.readBatch(this.fd, READ_BATCH_MAX_MESSAGES,
+        Math.max(remainingBytes, SRT_LIVE_MAX_PAYLOAD));
+      if (batch === null || batch === SRT.ERROR) { // connection likely died
+        debug("Socket read call returned:", batch);
         this.close();
         break;
       }
-      // we expect a Buffer object here, but
-      // -1 is the SRT_ERROR value that would get returned
-      // if there is no data to read yet/anymore
-      if (buffer === -1) {
-        this._scheduleNextRead(remainingBytes, READ_WAIT_INTERVAL_MS);
+      const buffer = batch.buffer;
+      // an empty batch means there is no data to read yet/anymore
+      if (buffer.length === 0) {
+        this._pendingReadBytes = remainingBytes;
         break;
       }
       //debug(`Read ${buffer.length} bytes from fd`);
@@ -160,11 +311,12 @@ class SRTReadStream extends Readable {
       if (this.push(buffer)) {
         remainingBytes -= buffer.length;
         if (remainingBytes <= 0) {
-          // 0 as a timer value acts as setImmediate task (next tick ideally)
           break;
         }
       } else {
         debug("Readable.push returned 'false' at remaining bytes:", remainingBytes);
+        // paused or buffer full: stop watching for data until the next `_read`
+        this._setReadInterest(false);
         break;
       }
     }
@@ -175,8 +327,11 @@ class SRTReadStream extends Readable {
    * @param {number} bytes
    */
   _read(bytes) {
-    debug('Readable._read(): requested bytes:', bytes);
-    this._readSocketAndPush(bytes);
+    // pull everything the buffer has room for in one go, not just one chunk
+    const wanted = Math.max(bytes, this.readableHighWaterMark - this.readableLength);
+    debug('Readable._read(): requested bytes:', bytes, 'pulling:', wanted);
+    this._setReadInterest(true);
+    this._readSocketAndPush(wanted);
   }
 
   /**
@@ -185,11 +340,39 @@ class SRTReadStream extends Readable {
    * @param {Function} cb
    */
   _destroy(err, cb) {
+    if (this._listener !== this) {
+      // a further connection of a listener: the epoll is not ours
+      if (this.fd !== null) {
+        this._listener._connections.delete(this.fd);
+        if (!this._fdClosed) this.srt.close(this.fd);
+        this.fd = null;
+      }
+      this._pendingReadBytes = 0;
+      if (cb) cb(err);
+      return;
+    }
     // guard from closing multiple times
-    if (this.fd === null) return;
-    this.srt.close(this.socket);
+    if (this._epid !== null) {
+      // also stops the event pump
+      this.srt.epollRelease(this._epid);
+      this._epid = null;
+    }
+    this._connections.forEach((stream) => {
+      if (stream !== this) stream.destroy();
+    });
+    this._connections.clear();
+    this._accepted.forEach((socket) => this.srt.close(socket));
+    this._accepted.clear();
+    const socketClosed = this._fdClosed && this.fd === this.socket;
+    if (this.fd !== null && this.fd !== this.socket && !this._fdClosed) {
+      this.srt.close(this.fd);
+    }
+    if (this.socket !== null && !socketClosed) {
+      this.srt.close(this.socket);
+    }
+    this.socket = null;
     this.fd = null;
-    this._clearScheduledRead();
+    this._pendingReadBytes = 0;
     if (cb) cb(err);
   }
 }
@@ -2,49 +2,199 @@ const { Writable } = require('stream');
 const { SRT } = require('../build/Release/node_srt.node');
 const debug = require('debug')('srt-write-stream');
 
+// 7 MPEG-TS packets, as SRT_LIVE_DEF_PLSIZE
+const DEFAULT_PAYLOAD_SIZE = 1316;
+
+/**
+ * Example:
+ *
+ * const srt = new SRTWriteStream('127.0.0.1', 1234);
+ * srt.connect(writeStream => {
+ *   fs.createReadStream('./input.ts').pipe(writeStream);
+ * });
+ *
+ * Written chunks (and whole batches of them, see `_writev`) are repacked natively
+ * into messages of `payloadSize` bytes. The socket doesn't block on sending:
+ * when the SRT send buffer is full, the write callback is held until the socket
+ * reports SRT_EPOLL_OUT again, so `pipe()` slows down the producer.
+ */
 class SRTWriteStream extends Writable {
-  constructor(address, port, opts) {
-    super();
+  /**
+   * @param {string} address
+   * @param {number} port
+   * @param {WritableOptions & { payloadSize?: number }} [opts] `payloadSize` default: 1316
+   */
+  constructor(address, port, opts = {}) {
+    const { payloadSize = DEFAULT_PAYLOAD_SIZE, ...writableOpts } = opts;
+    super(writableOpts);
     this.srt = new SRT();
     this.socket = this.srt.createSocket();
     this.address = address;
     this.port = port;
+    this.fd = null;
+    this.payloadSize = payloadSize;
+    this._epid = null;
+    // chunks the send buffer had no room for yet, and the callback of their write
+    this._pendingWrite = null;
+    this._waitingForSendBuffer = false;
   }
 
+  /**
+   * Connects without blocking: `cb` is called once the handshake is done.
+   * If the connection fails, the stream is destroyed with an error.
+   *
+   * @param {Function} cb
+   */
   connect(cb) {
-    this.srt.connect(this.socket, this.address, this.port);
-    this.fd = this.socket;
-    if (this.fd) {
-      cb(this);
-    }
+    this.srt.startConnect(this.socket, this.address, this.port);
+    this._epid = this.srt.epollCreate();
+    this.srt.epollAddUsock(this._epid, this.socket, SRT.EPOLL_OUT | SRT.EPOLL_ERR);
+    this.srt.epollWatch(this._epid, (events, err) => {
+      if (err) {
+        debug("Epoll wait failed:", err);
+        return;
+      }
+      const status = this.srt.getSockState(this.socket);
+      if (this.fd === null) {
+        if (status === SRT.SRTS_CONNECTING) {
+          return;
+        }
+        if (status !== SRT.SRTS_CONNECTED) {
+          this._releaseEpoll();
+          this.destroy(new Error(`Connecting to ${this.address}:${this.port} failed`));
+          return;
+        }
+        this.fd = this.socket;
+        this.srt.setSockOpt(this.fd, SRT.SRTO_SNDSYN, false);
+        // only wait for the send buffer when it filled up
+        this.srt.epollUpdateUsock(this._epid, this.fd, SRT.EPOLL_ERR);
+        cb(this);
+        return;
+      }
+      if (status !== SRT.SRTS_CONNECTED) {
+        this._releaseEpoll();
+        this.destroy(new Error(`Connection to ${this.address}:${this.port} broke`));
+        return;
+      }
+      this._flushPendingWrite();
+    });
   }
 
   close() {
+    this._releaseEpoll();
     this.srt.close(this.socket);
     this.fd = null;
   }
 
+  _releaseEpoll() {
+    if (this._epid !== null) {
+      this.srt.epollRelease(this._epid);
+      this._epid = null;
+    }
+  }
+
   stats(clear) {
     if (this.fd === null) {
       throw new Error('stats() called but stream was not initialized');
     }
 
-    return this.srt.Stats(this.fd, clear);
+    return this.srt.stats(this.fd, clear);
+  }
+
+  /**
+   * Subscribes to SRT_EPOLL_OUT only while a write waits for room in the
+   * send buffer, as it is level-triggered and would fire continuously otherwise.
+   *
+   * @private
+   * @param {boolean} waiting
+   */
+  _waitForSendBuffer(waiting) {
+    if (this._waitingForSendBuffer === waiting || this._epid === null) {
+      return;
+    }
+    this._waitingForSendBuffer = waiting;
+    this.srt.epollUpdateUsock(this._epid, this.fd,
+      waiting ? SRT.EPOLL_OUT | SRT.EPOLL_ERR : SRT.EPOLL_ERR);
+  }
+
+  /**
+   * Sends as much of the pending chunks as the send buffer takes,
+   * and completes the write once all of them are sent.
+   *
+   * @private
+   */
+  _flushPendingWrite() {
+    const pending = this._pendingWrite;
+    if (pending === null) {
+      return;
+    }
+    let sent;
+    try {
+      sent = this.srt.writeMany(this.fd, pending.chunks, this.payloadSize);
+    } catch (err) {
+      this._pendingWrite = null;
+      this._waitForSendBuffer(false);
+      pending.callback(err);
+      return;
+    }
+    debug(`Sent ${sent} of ${pending.byteLength} bytes`);
+    pending.byteLength -= sent;
+    if (pending.byteLength === 0) {
+      this._pendingWrite = null;
+      this._waitForSendBuffer(false);
+      pending.callback();
+      return;
+    }
+    pending.chunks = skipBytes(pending.chunks, sent);
+    this._waitForSendBuffer(true);
   }
 
   _write(chunk, encoding, callback) {
-    debug(`Writing chunk ${chunk.length}`);
-    if (this.fd) {
-      this.srt.write(this.fd, chunk);
-      callback();
-    } else {
+    this._writev([{ chunk, encoding }], callback);
+  }
+
+  /**
+   * Sends all chunks buffered by the stream in one binding call.
+   *
+   * @see https://nodejs.org/api/stream.html#stream_writable_writev_chunks_callback
+   * @param {Array<{ chunk: Buffer, encoding: string }>} chunks
+   * @param {Function} callback
+   */
+  _writev(chunks, callback) {
+    if (this.fd === null) {
       callback(new Error("Socket was closed"));
+      return;
     }
+    const buffers = chunks.map(({ chunk }) => chunk);
+    const byteLength = buffers.reduce((length, chunk) => length + chunk.length, 0);
+    debug(`Writing ${buffers.length} chunks, ${byteLength} bytes`);
+    this._pendingWrite = { chunks: buffers, byteLength, callback };
+    this._flushPendingWrite();
   }
 
   _destroy(err, callback) {
+    this._pendingWrite = null;
     this.close();
+    callback(err);
+  }
+}
+
+/**
+ * @param {Buffer[]} chunks
+ * @param {number} bytes
+ * @returns {Buffer[]} what is left of `chunks` after the first `bytes`
+ */
+function skipBytes(chunks, bytes) {
+  let i = 0;
+  while (bytes > 0 && bytes >= chunks[i].length) {
+    bytes -= chunks[i].length;
+    i++;
+  }
+  const rest = chunks.slice(i);
+  if (bytes > 0) {
+    rest[0] = rest[0].subarray(bytes);
   }
+  return rest;
 }
 
 module.exports = {
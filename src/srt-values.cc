@@ -0,0 +1,246 @@
+#include "srt-values.h"
+
+#include <algorithm>
+#include <limits>
+
+int GetSockOptValue(SRTSOCKET socket, int option, SockOptValue& value) {
+  int result = SRT_ERROR;
+
+  switch((SRT_SOCKOPT)option) {
+    case SRTO_INPUTBW:
+    case SRTO_MAXBW:
+    case SRTO_MININPUTBW:
+    {
+      int optSize = sizeof(value.int64Value);
+      value.type = SockOptValue::INT64;
+      result = srt_getsockflag(socket, (SRT_SOCKOPT)option, (void *)&value.int64Value, &optSize);
+      break;
+    }
+    case SRTO_MSS:
+    case SRTO_CONNTIMEO:
+    case SRTO_EVENT:
+    case SRTO_FC:
+    case SRTO_GROUPCONNECT:
+    case SRTO_GROUPMINSTABLETIMEO:
+    case SRTO_GROUPTYPE:
+    case SRTO_IPTOS:
+    case SRTO_ISN:
+    case SRTO_IPTTL:
+    case SRTO_IPV6ONLY:
+    case SRTO_KMREFRESHRATE:
+    case SRTO_KMPREANNOUNCE:
+    case SRTO_KMSTATE:
+    case SRTO_LATENCY:
+    case SRTO_LOSSMAXTTL:
+    case SRTO_MINVERSION:
+    case SRTO_OHEADBW:
+    case SRTO_PAYLOADSIZE:
+    case SRTO_PBKEYLEN:
+    case SRTO_PEERIDLETIMEO:
+    case SRTO_PEERLATENCY:
+    case SRTO_PEERVERSION:
+    case SRTO_RCVBUF:
+    case SRTO_RCVDATA:
+    case SRTO_RCVLATENCY:
+    case SRTO_RCVTIMEO:
+    case SRTO_SNDBUF:
+    case SRTO_SNDDATA:
+    case SRTO_SNDDROPDELAY:
+    case SRTO_SNDTIMEO:
+    case SRTO_STATE:
+    case SRTO_ENFORCEDENCRYPTION:
+    case SRTO_TLPKTDROP:
+    case SRTO_TSBPDMODE:
+    case SRTO_UDP_RCVBUF:
+    case SRTO_UDP_SNDBUF:
+    case SRTO_VERSION:
+    {
+      int optSize = sizeof(value.intValue);
+      value.type = SockOptValue::INT;
+      result = srt_getsockflag(socket, (SRT_SOCKOPT)option, (void *)&value.intValue, &optSize);
+      break;
+    }
+    case SRTO_RCVSYN:
+    case SRTO_MESSAGEAPI:
+    case SRTO_NAKREPORT:
+    case SRTO_RENDEZVOUS:
+    case SRTO_SENDER:
+    case SRTO_SNDSYN:
+    {
+      int optSize = sizeof(value.boolValue);
+      value.type = SockOptValue::BOOL;
+      result = srt_getsockflag(socket, (SRT_SOCKOPT)option, (void *)&value.boolValue, &optSize);
+      break;
+    }
+    case SRTO_PACKETFILTER:
+    case SRTO_PASSPHRASE:
+    case SRTO_STREAMID:
+    {
+      char optValue[512];
+      int optSize = sizeof(optValue);
+      value.type = SockOptValue::STRING;
+      result = srt_getsockflag(socket, (SRT_SOCKOPT)option, (void *)&optValue, &optSize);
+      if (result != SRT_ERROR) {
+        value.stringValue = std::string(optValue, optSize);
+      }
+      break;
+    }
+    default:
+      value.type = SockOptValue::NONE;
+      break;
+  }
+  return result;
+}
+
+int SetSockOptValue(SRTSOCKET socket, int option, const SockOptValue& value) {
+  switch (value.type) {
+    case SockOptValue::INT64:
+      return srt_setsockflag(socket, (SRT_SOCKOPT) option, &value.int64Value, sizeof(int64_t));
+    case SockOptValue::INT:
+      return srt_setsockflag(socket, (SRT_SOCKOPT) option, &value.intValue, sizeof(int));
+    case SockOptValue::BOOL:
+      return srt_setsockflag(socket, (SRT_SOCKOPT) option, &value.boolValue, sizeof(bool));
+    case SockOptValue::STRING:
+      return srt_setsockflag(socket, (SRT_SOCKOPT) option, value.stringValue.c_str(), value.stringValue.length());
+    default:
+      return SRT_ERROR;
+  }
+}
+
+Napi::Value SockOptValueToJS(Napi::Env env, const SockOptValue& value) {
+  switch (value.type) {
+    case SockOptValue::INT64:
+      return Napi::BigInt::New(env, value.int64Value);
+    case SockOptValue::INT:
+      return Napi::Value::From(env, value.intValue);
+    case SockOptValue::BOOL:
+      return Napi::Value::From(env, value.boolValue);
+    case SockOptValue::STRING:
+      return Napi::Value::From(env, value.stringValue);
+    default:
+      return env.Undefined();
+  }
+}
+
+bool SockOptValueFromJS(Napi::Env env, Napi::Value arg, SockOptValue& value) {
+  if (arg.IsBigInt()) {
+    bool lossless = true;
+    value.int64Value = arg.As<Napi::BigInt>().Int64Value(&lossless);
+    if (!lossless) {
+      Napi::Error::New(env, "BigInt value overflows int64_t").ThrowAsJavaScriptException();
+      return false;
+    }
+    value.type = SockOptValue::INT64;
+  } else if (arg.IsNumber()) {
+    value.intValue = arg.As<Napi::Number>();
+    value.type = SockOptValue::INT;
+  } else if (arg.IsBoolean()) {
+    value.boolValue = arg.As<Napi::Boolean>();
+    value.type = SockOptValue::BOOL;
+  } else if (arg.IsString()) {
+    value.stringValue = arg.As<Napi::String>();
+    value.type = SockOptValue::STRING;
+  } else {
+    Napi::Error::New(env, "Unexpected argument type for srt_setsockflag").ThrowAsJavaScriptException();
+    return false;
+  }
+  return true;
+}
+
+bool GetSockOptValuesArg(const Napi::CallbackInfo& info, size_t index, SockOptValues& options) {
+  Napi::Env env = info.Env();
+  if (info.Length() <= index || info[index].IsUndefined() || info[index].IsNull()) {
+    return true;
+  }
+  if (!info[index].IsObject()) {
+    Napi::TypeError::New(env, "Socket options must be an object of option: value").ThrowAsJavaScriptException();
+    return false;
+  }
+  Napi::Object object = info[index].As<Napi::Object>();
+  Napi::Array keys = object.GetPropertyNames();
+  for (uint32_t i = 0; i < keys.Length(); i++) {
+    Napi::Value key = keys.Get(i);
+    SockOptValue value;
+    if (!SockOptValueFromJS(env, object.Get(key), value)) {
+      return false;
+    }
+    options.emplace_back(key.ToNumber().Int32Value(), value);
+  }
+  return true;
+}
+
+int SetSockOptValues(SRTSOCKET socket, const SockOptValues& options) {
+  for (const auto& option : options) {
+    if (SetSockOptValue(socket, option.first, option.second) == SRT_ERROR) {
+      return SRT_ERROR;
+    }
+  }
+  return 0;
+}
+
+#define STATS_FIELD_NAME(name) #name,
+static const char* statsFieldNames[] = {
+  SRT_STATS_FIELDS(STATS_FIELD_NAME)
+};
+#undef STATS_FIELD_NAME
+
+const size_t STATS_FIELD_COUNT = sizeof(statsFieldNames) / sizeof(statsFieldNames[0]);
+
+Napi::Object StatsToObject(Napi::Env env, const SRT_TRACEBSTATS& stats) {
+  Napi::Object obj = Napi::Object::New(env);
+
+#define STATS_FIELD_SET(name) obj.Set(#name, (double)stats.name);
+  SRT_STATS_FIELDS(STATS_FIELD_SET)
+#undef STATS_FIELD_SET
+
+  return obj;
+}
+
+Napi::Array StatsFieldNames(Napi::Env env) {
+  Napi::Array names = Napi::Array::New(env, STATS_FIELD_COUNT);
+  for (size_t i = 0; i < STATS_FIELD_COUNT; i++) {
+    names[i] = Napi::String::New(env, statsFieldNames[i]);
+  }
+  return names;
+}
+
+int SampleStats(const std::vector<SRTSOCKET>& sockets, double* rows, bool clear) {
+  int sampled = 0;
+  SRT_TRACEBSTATS stats;
+  for (size_t i = 0; i < sockets.size(); i++) {
+    double* row = rows + i * STATS_FIELD_COUNT;
+    if (srt_bstats(sockets[i], &stats, clear) == SRT_ERROR) {
+      std::fill(row, row + STATS_FIELD_COUNT, std::numeric_limits<double>::quiet_NaN());
+      continue;
+    }
+    size_t index = 0;
+#define STATS_FIELD_STORE(name) row[index++] = (double)stats.name;
+    SRT_STATS_FIELDS(STATS_FIELD_STORE)
+#undef STATS_FIELD_STORE
+    sampled++;
+  }
+  return sampled;
+}
+
+bool GetStatsIntoArgs(const Napi::CallbackInfo& info, size_t index, std::vector<SRTSOCKET>& sockets, Napi::Float64Array& rows) {
+  Napi::Env env = info.Env();
+
+  if (!info[index].IsArray()) {
+    Napi::TypeError::New(env, "Sockets must be an array").ThrowAsJavaScriptException();
+    return false;
+  }
+  Napi::Array socketsArray = info[index].As<Napi::Array>();
+  sockets.resize(socketsArray.Length());
+  for (uint32_t i = 0; i < socketsArray.Length(); i++) {
+    sockets[i] = socketsArray.Get(i).As<Napi::Number>().Int32Value();
+  }
+
+  if (!info[index + 1].IsTypedArray()
+    || info[index + 1].As<Napi::TypedArray>().TypedArrayType() != napi_float64_array
+    || info[index + 1].As<Napi::TypedArray>().ElementLength() < sockets.size() * STATS_FIELD_COUNT) {
+    Napi::TypeError::New(env, "Stats rows must be a Float64Array of SRT.STATS_FIELD_COUNT values per socket").ThrowAsJavaScriptException();
+    return false;
+  }
+  rows = info[index + 1].As<Napi::Float64Array>();
+  return true;
+}
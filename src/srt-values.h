@@ -0,0 +1,173 @@
+#pragma once
+
+#include <napi.h>
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#if defined(_WIN32)
+#include <srt.h>
+#else
+#include <srt/srt.h>
+#endif
+
+/**
+ * Socket option value in native form, so that reading/writing the option
+ * and converting from/to JS can happen on different threads.
+ */
+struct SockOptValue {
+  enum Type {
+    NONE,
+    INT64,
+    INT,
+    BOOL,
+    STRING
+  };
+
+  Type type = NONE;
+  int64_t int64Value = 0;
+  int intValue = 0;
+  bool boolValue = false;
+  std::string stringValue;
+};
+
+/**
+ * Reads an option with the native type SRT expects for it.
+ * Leaves `value.type` as NONE for options we don't support yet.
+ */
+int GetSockOptValue(SRTSOCKET socket, int option, SockOptValue& value);
+
+int SetSockOptValue(SRTSOCKET socket, int option, const SockOptValue& value);
+
+Napi::Value SockOptValueToJS(Napi::Env env, const SockOptValue& value);
+
+/**
+ * Returns false (with a JS exception pending) if the argument has no matching native type.
+ */
+bool SockOptValueFromJS(Napi::Env env, Napi::Value arg, SockOptValue& value);
+
+/**
+ * Options to set on a socket, in the order they were given.
+ */
+typedef std::vector<std::pair<int, SockOptValue>> SockOptValues;
+
+/**
+ * Reads an optional `{ [option]: value }` object at `index` into `options`.
+ * Returns false (with a JS exception pending) if a value has no matching native type.
+ */
+bool GetSockOptValuesArg(const Napi::CallbackInfo& info, size_t index, SockOptValues& options);
+
+/**
+ * Sets every option, stopping at the first that fails (returning SRT_ERROR).
+ */
+int SetSockOptValues(SRTSOCKET socket, const SockOptValues& options);
+
+/**
+ * The SRT_TRACEBSTATS fields we expose, in the order of the `statsInto` row layout.
+ */
+#define SRT_STATS_FIELDS(FIELD) \
+  FIELD(msTimeStamp) \
+  FIELD(pktSentTotal) \
+  FIELD(pktRecvTotal) \
+  FIELD(pktSndLossTotal) \
+  FIELD(pktRcvLossTotal) \
+  FIELD(pktRetransTotal) \
+  FIELD(pktSentACKTotal) \
+  FIELD(pktRecvACKTotal) \
+  FIELD(pktSentNAKTotal) \
+  FIELD(pktRecvNAKTotal) \
+  FIELD(usSndDurationTotal) \
+  FIELD(pktSndDropTotal) \
+  FIELD(pktRcvDropTotal) \
+  FIELD(pktRcvUndecryptTotal) \
+  FIELD(byteSentTotal) \
+  FIELD(byteRecvTotal) \
+  FIELD(byteRcvLossTotal) \
+  FIELD(byteRetransTotal) \
+  FIELD(byteSndDropTotal) \
+  FIELD(byteRcvDropTotal) \
+  FIELD(byteRcvUndecryptTotal) \
+  FIELD(pktSent) \
+  FIELD(pktRecv) \
+  FIELD(pktSndLoss) \
+  FIELD(pktRcvLoss) \
+  FIELD(pktRetrans) \
+  FIELD(pktRcvRetrans) \
+  FIELD(pktSentACK) \
+  FIELD(pktRecvACK) \
+  FIELD(pktSentNAK) \
+  FIELD(pktRecvNAK) \
+  FIELD(mbpsSendRate) \
+  FIELD(mbpsRecvRate) \
+  FIELD(usSndDuration) \
+  FIELD(pktReorderDistance) \
+  FIELD(pktRcvAvgBelatedTime) \
+  FIELD(pktRcvBelated) \
+  FIELD(pktSndDrop) \
+  FIELD(pktRcvDrop) \
+  FIELD(pktRcvUndecrypt) \
+  FIELD(byteSent) \
+  FIELD(byteRecv) \
+  FIELD(byteRcvLoss) \
+  FIELD(byteRetrans) \
+  FIELD(byteSndDrop) \
+  FIELD(byteRcvDrop) \
+  FIELD(byteRcvUndecrypt) \
+  FIELD(usPktSndPeriod) \
+  FIELD(pktFlowWindow) \
+  FIELD(pktCongestionWindow) \
+  FIELD(pktFlightSize) \
+  FIELD(msRTT) \
+  FIELD(mbpsBandwidth) \
+  FIELD(byteAvailSndBuf) \
+  FIELD(byteAvailRcvBuf) \
+  FIELD(mbpsMaxBW) \
+  FIELD(byteMSS) \
+  FIELD(pktSndBuf) \
+  FIELD(byteSndBuf) \
+  FIELD(msSndBuf) \
+  FIELD(msSndTsbPdDelay) \
+  FIELD(pktRcvBuf) \
+  FIELD(byteRcvBuf) \
+  FIELD(msRcvBuf) \
+  FIELD(msRcvTsbPdDelay) \
+  FIELD(pktSndFilterExtraTotal) \
+  FIELD(pktRcvFilterExtraTotal) \
+  FIELD(pktRcvFilterSupplyTotal) \
+  FIELD(pktRcvFilterLossTotal) \
+  FIELD(pktSndFilterExtra) \
+  FIELD(pktRcvFilterExtra) \
+  FIELD(pktRcvFilterSupply) \
+  FIELD(pktRcvFilterLoss) \
+  FIELD(pktReorderTolerance) \
+  FIELD(pktSentUniqueTotal) \
+  FIELD(pktRecvUniqueTotal) \
+  FIELD(byteSentUniqueTotal) \
+  FIELD(byteRecvUniqueTotal) \
+  FIELD(pktSentUnique) \
+  FIELD(pktRecvUnique) \
+  FIELD(byteSentUnique) \
+  FIELD(byteRecvUnique)
+
+extern const size_t STATS_FIELD_COUNT;
+
+Napi::Object StatsToObject(Napi::Env env, const SRT_TRACEBSTATS& stats);
+
+/**
+ * Field names by row index, exported as `SRT.STATS_FIELDS`.
+ */
+Napi::Array StatsFieldNames(Napi::Env env);
+
+/**
+ * Writes one row of STATS_FIELD_COUNT values per socket into `rows`.
+ * Rows of sockets SRT has no stats for are filled with NaN.
+ * Returns the number of sockets sampled.
+ */
+int SampleStats(const std::vector<SRTSOCKET>& sockets, double* rows, bool clear);
+
+/**
+ * Reads the `sockets` and `rows` arguments of `statsInto` at `index` and `index + 1`.
+ * Returns false (with a JS exception pending) if they don't fit.
+ */
+bool GetStatsIntoArgs(const Napi::CallbackInfo& info, size_t index, std::vector<SRTSOCKET>& sockets, Napi::Float64Array& rows);
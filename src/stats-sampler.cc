@@ -0,0 +1,146 @@
+#include "stats-sampler.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+using namespace std;
+
+StatsSampler::StatsSampler(int intervalMs, size_t windowSize)
+  : intervalMs_(intervalMs > 0 ? intervalMs : 1),
+    windowSize_(windowSize > 0 ? windowSize : 1),
+    running_(true) {
+  thread_ = thread(&StatsSampler::Run, this);
+}
+
+StatsSampler::~StatsSampler() {
+  Stop();
+}
+
+void StatsSampler::Stop() {
+  {
+    lock_guard<mutex> lock(mutex_);
+    running_ = false;
+  }
+  cv_.notify_all();
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+}
+
+void StatsSampler::Add(SRTSOCKET socket) {
+  lock_guard<mutex> lock(mutex_);
+  if (series_.count(socket) != 0) {
+    return;
+  }
+  Series& series = series_[socket];
+  for (int i = 0; i < METRIC_COUNT; i++) {
+    series.rings[i].assign(windowSize_, 0);
+  }
+}
+
+void StatsSampler::Remove(SRTSOCKET socket) {
+  lock_guard<mutex> lock(mutex_);
+  series_.erase(socket);
+}
+
+void StatsSampler::Run() {
+  unique_lock<mutex> lock(mutex_);
+  while (running_) {
+    cv_.wait_for(lock, chrono::milliseconds(intervalMs_));
+    if (!running_) {
+      break;
+    }
+    samples_.resize(series_.size());
+    size_t i = 0;
+    for (auto& entry : series_) {
+      samples_[i++].socket = entry.first;
+    }
+
+    // srt_bstats takes locks of the socket, so Add/Remove/Query don't wait on it
+    lock.unlock();
+    for (Sample& sample : samples_) {
+      // closed sockets keep their window until they are removed
+      sample.ok = srt_bstats(sample.socket, &sample.stats, 0) != SRT_ERROR;
+    }
+    lock.lock();
+
+    for (const Sample& sample : samples_) {
+      // the socket may have been removed meanwhile
+      auto it = series_.find(sample.socket);
+      if (sample.ok && it != series_.end()) {
+        Store(it->second, sample.stats);
+      }
+    }
+  }
+}
+
+void StatsSampler::Store(Series& series, const SRT_TRACEBSTATS& stats) {
+  if (!series.hasTotals) {
+    // the first sample only sets the base for the deltas
+    series.hasTotals = true;
+  } else {
+    double seconds = (stats.msTimeStamp - series.msTimeStamp) / 1000.0;
+    if (seconds <= 0) {
+      return;
+    }
+    double values[METRIC_COUNT];
+    values[METRIC_RTT] = stats.msRTT;
+    values[METRIC_SEND_RATE] = (stats.byteSentTotal - series.byteSentTotal) * 8 / seconds / 1000000;
+    values[METRIC_RECV_RATE] = (stats.byteRecvTotal - series.byteRecvTotal) * 8 / seconds / 1000000;
+    values[METRIC_RCV_LOSS] = stats.pktRcvLossTotal - series.pktRcvLossTotal;
+    values[METRIC_RETRANS] = stats.pktRetransTotal - series.pktRetransTotal;
+    values[METRIC_RCV_BUF] = stats.msRcvBuf;
+
+    for (int i = 0; i < METRIC_COUNT; i++) {
+      series.rings[i][series.next] = values[i];
+    }
+    series.next = (series.next + 1) % windowSize_;
+    series.count = min(series.count + 1, windowSize_);
+  }
+
+  series.msTimeStamp = stats.msTimeStamp;
+  series.byteSentTotal = stats.byteSentTotal;
+  series.byteRecvTotal = stats.byteRecvTotal;
+  series.pktRcvLossTotal = stats.pktRcvLossTotal;
+  series.pktRetransTotal = stats.pktRetransTotal;
+}
+
+static double Percentile(vector<double>& sorted, double p) {
+  size_t rank = (size_t)ceil(p * sorted.size());
+  return sorted[rank > 0 ? rank - 1 : 0];
+}
+
+bool StatsSampler::Query(SRTSOCKET socket, Metric metric, size_t samples, Summary& summary) {
+  lock_guard<mutex> lock(mutex_);
+  auto it = series_.find(socket);
+  if (it == series_.end() || it->second.count == 0 || metric < 0 || metric >= METRIC_COUNT) {
+    return false;
+  }
+  const Series& series = it->second;
+  const vector<double>& ring = series.rings[metric];
+
+  size_t count = samples == 0 ? series.count : min(samples, series.count);
+  scratch_.resize(count);
+  // the last `count` samples, newest last
+  for (size_t i = 0; i < count; i++) {
+    scratch_[i] = ring[(series.next + windowSize_ - count + i) % windowSize_];
+  }
+
+  summary.count = count;
+  summary.last = scratch_.back();
+  double sum = 0;
+  for (double value : scratch_) {
+    sum += value;
+  }
+  summary.mean = sum / count;
+
+  // the window is small enough for exact percentiles
+  sort(scratch_.begin(), scratch_.end());
+  summary.min = scratch_.front();
+  summary.max = scratch_.back();
+  summary.p50 = Percentile(scratch_, 0.50);
+  summary.p95 = Percentile(scratch_, 0.95);
+  summary.p99 = Percentile(scratch_, 0.99);
+  return true;
+}
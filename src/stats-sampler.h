@@ -0,0 +1,91 @@
+#pragma once
+
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#if defined(_WIN32)
+#include <srt.h>
+#else
+#include <srt/srt.h>
+#endif
+
+/**
+ * Samples `srt_bstats` of registered sockets on its own thread
+ * and keeps the last `windowSize` samples of a few QoS metrics per socket.
+ *
+ * Counters and rates are derived from the totals, so sampling never clears
+ * the stats other callers read.
+ */
+class StatsSampler {
+  public:
+    enum Metric {
+      METRIC_RTT = 0,        // msRTT
+      METRIC_SEND_RATE,      // Mbps, from byteSentTotal
+      METRIC_RECV_RATE,      // Mbps, from byteRecvTotal
+      METRIC_RCV_LOSS,       // packets lost per interval, from pktRcvLossTotal
+      METRIC_RETRANS,        // packets retransmitted per interval, from pktRetransTotal
+      METRIC_RCV_BUF,        // msRcvBuf
+      METRIC_COUNT
+    };
+
+    struct Summary {
+      size_t count;
+      double min;
+      double max;
+      double mean;
+      double p50;
+      double p95;
+      double p99;
+      double last;
+    };
+
+    StatsSampler(int intervalMs, size_t windowSize);
+    ~StatsSampler();
+
+    void Add(SRTSOCKET socket);
+    void Remove(SRTSOCKET socket);
+
+    /**
+     * Summarizes the last `samples` values of a metric (all of the window if 0).
+     * Returns false if the socket isn't registered or has no sample yet.
+     */
+    bool Query(SRTSOCKET socket, Metric metric, size_t samples, Summary& summary);
+
+    void Stop();
+
+  private:
+    struct Series {
+      std::vector<double> rings[METRIC_COUNT];
+      size_t next = 0;
+      size_t count = 0;
+      bool hasTotals = false;
+      int64_t msTimeStamp = 0;
+      uint64_t byteSentTotal = 0;
+      uint64_t byteRecvTotal = 0;
+      int pktRcvLossTotal = 0;
+      int pktRetransTotal = 0;
+    };
+
+    struct Sample {
+      SRTSOCKET socket;
+      bool ok;
+      SRT_TRACEBSTATS stats;
+    };
+
+    void Run();
+    void Store(Series& series, const SRT_TRACEBSTATS& stats);
+
+    const int intervalMs_;
+    const size_t windowSize_;
+    std::mutex mutex_;
+    std::condition_variable cv_;
+    bool running_;
+    std::map<SRTSOCKET, Series> series_;
+    std::vector<double> scratch_;
+    // only used by the sampler thread, reused across intervals
+    std::vector<Sample> samples_;
+    std::thread thread_;
+};
@@ -0,0 +1,46 @@
+const { SRT } = require('../build/Release/node_srt.node');
+
+/**
+ * Row index of every stats field, e.g `STATS_FIELD_INDEX.msRTT`.
+ *
+ * @type {Object<string, number>}
+ */
+const STATS_FIELD_INDEX = Object.freeze(SRT.STATS_FIELDS.reduce((index, name, i) => {
+  index[name] = i;
+  return index;
+}, {}));
+
+/**
+ * Allocates the array `statsInto` writes to, one row of `SRT.STATS_FIELD_COUNT` values per socket.
+ *
+ * @param {number} socketCount
+ * @returns {Float64Array}
+ */
+function createStatsRows(socketCount) {
+  return new Float64Array(socketCount * SRT.STATS_FIELD_COUNT);
+}
+
+/**
+ * Decodes one row written by `statsInto` into the object `stats()` returns.
+ *
+ * @param {Float64Array} rows
+ * @param {number} row index of the socket in the list passed to `statsInto`
+ * @returns {SRTStats | null} null if no stats could be sampled for that socket
+ */
+function decodeStatsRow(rows, row) {
+  const offset = row * SRT.STATS_FIELD_COUNT;
+  if (Number.isNaN(rows[offset])) {
+    return null;
+  }
+  const stats = {};
+  for (let i = 0; i < SRT.STATS_FIELD_COUNT; i++) {
+    stats[SRT.STATS_FIELDS[i]] = rows[offset + i];
+  }
+  return stats;
+}
+
+module.exports = {
+  STATS_FIELD_INDEX,
+  createStatsRows,
+  decodeStatsRow
+};
@@ -0,0 +1,112 @@
+#include "stream-id-filter.h"
+
+#include <cstring>
+
+using namespace std;
+
+static bool Matches(const vector<string>& entries, const char* streamId) {
+  for (const string& entry : entries) {
+    if (!entry.empty() && entry.back() == '*') {
+      if (strncmp(streamId, entry.c_str(), entry.size() - 1) == 0) {
+        return true;
+      }
+    } else if (entry == streamId) {
+      return true;
+    }
+  }
+  return false;
+}
+
+bool StreamIdFilters::Filter::Allows(const char* streamId) const {
+  if (Matches(deny, streamId)) {
+    return false;
+  }
+  return allow.empty() || Matches(allow, streamId);
+}
+
+StreamIdFilters& StreamIdFilters::Shared() {
+  static StreamIdFilters filters;
+  return filters;
+}
+
+int StreamIdFilters::Set(SRTSOCKET listener, const vector<string>& allow, const vector<string>& deny) {
+  {
+    lock_guard<mutex> lock(mutex_);
+    Filter& filter = filters_[listener];
+    filter.allow = allow;
+    filter.deny = deny;
+  }
+  // the listener id is passed instead of a pointer, so that a callback
+  // running while the rules are removed finds nothing rather than freed memory
+  int result = srt_listen_callback(listener, &StreamIdFilters::OnConnect, (void *)(intptr_t)listener);
+  if (result == SRT_ERROR) {
+    Remove(listener);
+  }
+  return result;
+}
+
+void StreamIdFilters::Remove(SRTSOCKET listener) {
+  lock_guard<mutex> lock(mutex_);
+  filters_.erase(listener);
+}
+
+bool StreamIdFilters::GetCounters(SRTSOCKET listener, Counters& counters) {
+  lock_guard<mutex> lock(mutex_);
+  auto it = filters_.find(listener);
+  if (it == filters_.end()) {
+    return false;
+  }
+  counters = it->second.counters;
+  return true;
+}
+
+int StreamIdFilters::OnConnect(void* opaque, SRTSOCKET ns, int hsVersion, const sockaddr* peerAddr, const char* streamId) {
+  SRTSOCKET listener = (SRTSOCKET)(intptr_t)opaque;
+  StreamIdFilters& filters = Shared();
+
+  lock_guard<mutex> lock(filters.mutex_);
+  auto it = filters.filters_.find(listener);
+  if (it == filters.filters_.end()) {
+    return 0;
+  }
+  Filter& filter = it->second;
+  if (!filter.Allows(streamId != nullptr ? streamId : "")) {
+    filter.counters.rejected++;
+    srt_setrejectreason(ns, SRT_REJX_FORBIDDEN);
+    return -1;
+  }
+  filter.counters.accepted++;
+  return 0;
+}
+
+static bool GetStringsArg(const Napi::CallbackInfo& info, size_t index, vector<string>& strings) {
+  Napi::Env env = info.Env();
+  if (info.Length() <= index || info[index].IsUndefined() || info[index].IsNull()) {
+    return true;
+  }
+  if (!info[index].IsArray()) {
+    Napi::TypeError::New(env, "Stream ids must be an array of strings").ThrowAsJavaScriptException();
+    return false;
+  }
+  Napi::Array array = info[index].As<Napi::Array>();
+  for (uint32_t i = 0; i < array.Length(); i++) {
+    Napi::Value value = array.Get(i);
+    if (!value.IsString()) {
+      Napi::TypeError::New(env, "Stream ids must be an array of strings").ThrowAsJavaScriptException();
+      return false;
+    }
+    strings.push_back(value.As<Napi::String>());
+  }
+  return true;
+}
+
+bool GetStreamIdFilterArgs(const Napi::CallbackInfo& info, size_t index, vector<string>& allow, vector<string>& deny) {
+  return GetStringsArg(info, index, allow) && GetStringsArg(info, index + 1, deny);
+}
+
+Napi::Object StreamIdCountersToObject(Napi::Env env, const StreamIdFilters::Counters& counters) {
+  Napi::Object object = Napi::Object::New(env);
+  object.Set("accepted", Napi::Number::New(env, (double)counters.accepted));
+  object.Set("rejected", Napi::Number::New(env, (double)counters.rejected));
+  return object;
+}
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <napi.h>
+
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#if defined(_WIN32)
+#include <srt.h>
+#else
+#include <srt/srt.h>
+#endif
+
+/**
+ * Process-wide table of stream id rules per listener, checked by a
+ * `srt_listen_callback` on the SRT receive thread during the handshake.
+ * A rejected caller never becomes an accepted socket, so JS isn't woken up for it.
+ *
+ * A stream id is rejected if it matches a `deny` entry, or if `allow` isn't empty
+ * and it matches none of its entries. Entries match exactly, or by prefix
+ * when they end with '*'.
+ */
+class StreamIdFilters {
+  public:
+    struct Counters {
+      uint64_t accepted;
+      uint64_t rejected;
+    };
+
+    static StreamIdFilters& Shared();
+
+    /**
+     * Sets the rules of `listener`, replacing previous ones and keeping the counters.
+     * Returns SRT_ERROR if the callback can't be installed.
+     */
+    int Set(SRTSOCKET listener, const std::vector<std::string>& allow, const std::vector<std::string>& deny);
+
+    /**
+     * Drops the rules of `listener`, its callback then accepts every caller.
+     */
+    void Remove(SRTSOCKET listener);
+
+    /**
+     * Returns false if `listener` has no rules.
+     */
+    bool GetCounters(SRTSOCKET listener, Counters& counters);
+
+  private:
+    struct Filter {
+      std::vector<std::string> allow;
+      std::vector<std::string> deny;
+      Counters counters = {0, 0};
+
+      bool Allows(const char* streamId) const;
+    };
+
+    StreamIdFilters() = default;
+
+    static int OnConnect(void* opaque, SRTSOCKET ns, int hsVersion, const sockaddr* peerAddr, const char* streamId);
+
+    std::mutex mutex_;
+    std::map<SRTSOCKET, Filter> filters_;
+};
+
+/**
+ * Reads the `allow` and `deny` string arrays at `index` and `index + 1`, either may be omitted.
+ * Returns false (with a JS exception pending) if one holds anything but strings.
+ */
+bool GetStreamIdFilterArgs(const Napi::CallbackInfo& info, size_t index,
+  std::vector<std::string>& allow, std::vector<std::string>& deny);
+
+/**
+ * Returns `{ accepted, rejected }`.
+ */
+Napi::Object StreamIdCountersToObject(Napi::Env env, const StreamIdFilters::Counters& counters);
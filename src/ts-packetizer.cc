@@ -0,0 +1,175 @@
+#include "ts-packetizer.h"
+
+#include <thread>
+
+using namespace std;
+
+#define TS_PCR_HZ 27000000LL
+// a PCR going back or jumping further than this is a discontinuity, not elapsed time
+#define TS_PCR_MAX_GAP (TS_PCR_HZ / 2)
+// a pacer this late has stalled, it starts over rather than catching up in a burst
+#define TS_PACER_MAX_LATE_US 1000000
+
+TsPacketizer::TsPacketizer() : skipped_(0) {
+  Reset();
+}
+
+void TsPacketizer::Reset() {
+  partial_.clear();
+  group_.clear();
+  openStart_ = 0;
+  groupTimeUs_ = -1;
+  inSync_ = false;
+  pcrPid_ = -1;
+  lastPcr_ = -1;
+  lastPcrTimeUs_ = 0;
+  bytesSincePcr_ = 0;
+  bytesPerUs_ = 0;
+}
+
+void TsPacketizer::Push(const uint8_t* data, size_t length, bool end) {
+  // the open message goes on with this chunk
+  data_.swap(group_);
+  group_.clear();
+  messages_.clear();
+  openStart_ = 0;
+
+  // the bytes carried from the last chunk come first
+  size_t carried = partial_.size();
+  size_t total = carried + length;
+  auto at = [&](size_t i) { return i < carried ? partial_[i] : data[i - carried]; };
+
+  size_t pos = 0;
+  while (pos < total) {
+    if (at(pos) != TS_SYNC_BYTE) {
+      inSync_ = false;
+      skipped_++;
+      pos++;
+      continue;
+    }
+    if (pos + TS_PACKET_SIZE > total) {
+      break;
+    }
+    // out of sync, a sync byte only counts if the next packet starts with one too (or the chunk ends)
+    if (!inSync_ && pos + TS_PACKET_SIZE < total && at(pos + TS_PACKET_SIZE) != TS_SYNC_BYTE) {
+      skipped_++;
+      pos++;
+      continue;
+    }
+    inSync_ = true;
+    if (pos >= carried) {
+      AddPacket(data + pos - carried);
+    } else {
+      uint8_t packet[TS_PACKET_SIZE];
+      for (size_t i = 0; i < TS_PACKET_SIZE; i++) {
+        packet[i] = at(pos + i);
+      }
+      AddPacket(packet);
+    }
+    pos += TS_PACKET_SIZE;
+  }
+
+  vector<uint8_t> rest;
+  for (size_t i = pos; i < total; i++) {
+    rest.push_back(at(i));
+  }
+  partial_.swap(rest);
+
+  if (data_.size() > openStart_) {
+    if (end) {
+      CloseMessage();
+    } else {
+      group_.assign(data_.begin() + openStart_, data_.end());
+      data_.resize(openStart_);
+    }
+  }
+  if (end) {
+    skipped_ += partial_.size();
+    Reset();
+  }
+}
+
+void TsPacketizer::AddPacket(const uint8_t* packet) {
+  int64_t timeUs = PacketTime(packet);
+  if (data_.size() == openStart_) {
+    groupTimeUs_ = timeUs;
+  }
+  data_.insert(data_.end(), packet, packet + TS_PACKET_SIZE);
+  if (data_.size() - openStart_ == TS_PACKET_SIZE * TS_PACKETS_PER_MESSAGE) {
+    CloseMessage();
+  }
+}
+
+void TsPacketizer::CloseMessage() {
+  messages_.push_back(Message{openStart_, data_.size() - openStart_, groupTimeUs_});
+  openStart_ = data_.size();
+  groupTimeUs_ = -1;
+}
+
+int64_t TsPacketizer::PacketTime(const uint8_t* packet) {
+  int pid = ((packet[1] & 0x1f) << 8) | packet[2];
+  bool hasAdaptationField = (packet[3] & 0x20) != 0;
+  bool hasPcr = hasAdaptationField && packet[4] >= 7 && (packet[5] & 0x10) != 0;
+  // only the PCR of the first PID carrying one paces the stream
+  if (hasPcr && (pcrPid_ < 0 || pcrPid_ == pid)) {
+    pcrPid_ = pid;
+    int64_t base = ((int64_t)packet[6] << 25) | ((int64_t)packet[7] << 17)
+      | ((int64_t)packet[8] << 9) | ((int64_t)packet[9] << 1) | (packet[10] >> 7);
+    int64_t extension = ((packet[10] & 0x01) << 8) | packet[11];
+    int64_t pcr = base * 300 + extension;
+
+    if (lastPcr_ >= 0) {
+      int64_t delta = pcr - lastPcr_;
+      if (delta > 0 && delta <= TS_PCR_MAX_GAP) {
+        int64_t deltaUs = delta * 1000000 / TS_PCR_HZ;
+        lastPcrTimeUs_ += deltaUs;
+        if (deltaUs > 0) {
+          bytesPerUs_ = (double)bytesSincePcr_ / deltaUs;
+        }
+      }
+      // on a discontinuity the media time goes on from where it was
+    }
+    lastPcr_ = pcr;
+    bytesSincePcr_ = TS_PACKET_SIZE;
+    return lastPcrTimeUs_;
+  }
+
+  int64_t timeUs = -1;
+  if (lastPcr_ >= 0) {
+    timeUs = lastPcrTimeUs_;
+    if (bytesPerUs_ > 0) {
+      timeUs += (int64_t)(bytesSincePcr_ / bytesPerUs_);
+    }
+  }
+  bytesSincePcr_ += TS_PACKET_SIZE;
+  return timeUs;
+}
+
+TsPacer::TsPacer() {
+  Reset();
+}
+
+void TsPacer::Reset() {
+  started_ = false;
+  firstTimeUs_ = 0;
+}
+
+void TsPacer::WaitFor(int64_t timeUs) {
+  if (timeUs < 0) {
+    return;
+  }
+  chrono::steady_clock::time_point now = chrono::steady_clock::now();
+  if (!started_ || timeUs < firstTimeUs_) {
+    started_ = true;
+    firstTimeUs_ = timeUs;
+    start_ = now;
+    return;
+  }
+  chrono::steady_clock::time_point due = start_ + chrono::microseconds(timeUs - firstTimeUs_);
+  if (now - due > chrono::microseconds(TS_PACER_MAX_LATE_US)) {
+    firstTimeUs_ = timeUs;
+    start_ = now;
+    return;
+  }
+  this_thread::sleep_until(due);
+}
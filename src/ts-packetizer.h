@@ -0,0 +1,85 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#define TS_PACKET_SIZE 188
+#define TS_SYNC_BYTE 0x47
+// 7 * 188 = 1316 bytes, the default SRT live payload
+#define TS_PACKETS_PER_MESSAGE 7
+
+/**
+ * Cuts an MPEG-TS byte stream, pushed in chunks of any size, into SRT messages
+ * of exactly TS_PACKETS_PER_MESSAGE whole packets.
+ *
+ * Packets may span chunks. Bytes that don't start a packet followed by
+ * another sync byte are skipped until the stream is in sync again.
+ * Every message is stamped with the media time of its first packet,
+ * derived from the PCR (interpolated at the byte rate between two PCRs).
+ */
+class TsPacketizer {
+  public:
+    struct Message {
+      size_t offset;
+      size_t length;
+      int64_t timeUs;   // -1 until the first PCR
+    };
+
+    TsPacketizer();
+
+    /**
+     * Replaces `Data()` and `Messages()` with the messages completed by `data`.
+     * With `end` the last, shorter, message is completed too and the stream is reset.
+     */
+    void Push(const uint8_t* data, size_t length, bool end);
+
+    const std::vector<uint8_t>& Data() const { return data_; }
+    const std::vector<Message>& Messages() const { return messages_; }
+
+    /**
+     * Bytes skipped to get back in sync since the stream started.
+     */
+    uint64_t Skipped() const { return skipped_; }
+
+    void Reset();
+
+  private:
+    void AddPacket(const uint8_t* packet);
+    int64_t PacketTime(const uint8_t* packet);
+    void CloseMessage();
+
+    std::vector<uint8_t> data_;
+    std::vector<Message> messages_;
+    std::vector<uint8_t> partial_;       // start of a packet cut by the end of a chunk
+    std::vector<uint8_t> group_;         // packets of the message not completed yet
+    size_t openStart_;                   // where the message not completed yet starts in data_
+    int64_t groupTimeUs_;
+    uint64_t skipped_;
+    bool inSync_;
+
+    int pcrPid_;
+    int64_t lastPcr_;                    // 27 MHz
+    int64_t lastPcrTimeUs_;
+    uint64_t bytesSincePcr_;
+    double bytesPerUs_;
+};
+
+/**
+ * Sleeps until the wall-clock time a media time is due,
+ * the first media time being due right away.
+ */
+class TsPacer {
+  public:
+    TsPacer();
+
+    void WaitFor(int64_t timeUs);
+
+    void Reset();
+
+  private:
+    bool started_;
+    int64_t firstTimeUs_;
+    std::chrono::steady_clock::time_point start_;
+};
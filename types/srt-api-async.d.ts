@@ -1,14 +1,106 @@
 import { EventEmitter } from "events";
-import { SRTLoggingLevel, SRTResult, SRTSockOpt, SRTSockStatus } from "../src/srt-api-enums";
+import { SRTGroupType, SRTLoggingLevel, SRTResult, SRTSockOpt, SRTSockStatus } from "../src/srt-api-enums";
+import { AsyncSRTTransport } from "../src/async-api-enums";
 
-import { SRTReadReturn, SRTFileDescriptor, SRTEpollEvent, SRTSockOptValue, SRTStats } from "./srt-api"
+import { SRTAcceptedSocket, SRTReadReturn, SRTReadBatch, SRTFileDescriptor, SRTEpollEvent, SRTGroupEndpoint, SRTGroupMember, SRTSockOptValue, SRTSockOptValues, SRTStats, SRTStreamIdFilterStats } from "./srt-api"
 
 export type AsyncSRTCallback<T> = (result: T) => void;
 
+export interface AsyncSRTOptions {
+  /**
+   * default: "native"
+   */
+  transport?: AsyncSRTTransport;
+  /**
+   * Number of native threads running the calls (only "native" transport). default: 4
+   */
+  threads?: number;
+  /**
+   * Size in bytes of each of the two rings shared with the worker (only "shared-ring" transport),
+   * a call or result (with its payload) can take up to half of it. default: 4 MiB
+   */
+  ringBytes?: number;
+  /**
+   * Collect call metrics from the start, see `AsyncSRT#getMetrics`. default: false
+   */
+  metrics?: boolean;
+}
+
+/**
+ * Durations in microseconds, percentiles are upper bounds of log-linear buckets (within 12.5%)
+ */
+export interface AsyncSRTLatencySummary {
+  count: number;
+  meanUs: number | null;
+  minUs: number | null;
+  maxUs: number | null;
+  p50Us: number | null;
+  p90Us: number | null;
+  p99Us: number | null;
+}
+
+export interface AsyncSRTMethodMetrics {
+  calls: number;
+  /**
+   * Calls that resolved to SRT_ERROR
+   */
+  errors: number;
+  /**
+   * From the call to the settled result
+   */
+  roundTrip: AsyncSRTLatencySummary;
+  /**
+   * Waiting for a native thread (or the worker)
+   */
+  queued: AsyncSRTLatencySummary;
+  /**
+   * In the binding call itself
+   */
+  native: AsyncSRTLatencySummary;
+}
+
+export interface AsyncSRTMetricsSnapshot {
+  /**
+   * Time since the metrics were enabled or reset
+   */
+  periodMs: number;
+  /**
+   * Calls awaiting their result
+   */
+  inFlight: number;
+  peakInFlight: number;
+  methods: { [method: string]: AsyncSRTMethodMetrics };
+}
+
 export class AsyncSRT extends EventEmitter {
 
   static TimeoutMs: number;
 
+  constructor(options?: AsyncSRTOptions);
+
+  readonly transport: AsyncSRTTransport;
+
+  /**
+   * Resolves to the exit code of the Worker (0 with the native transport).
+   * With the native transport, calls still queued settle with SRT_ERROR.
+   */
+  dispose(): Promise<number>;
+
+  /**
+   * Starts (or stops) collecting per-method call counts, latency histograms
+   * and the number of calls in flight.
+   *
+   * @param enabled default: true
+   */
+  enableMetrics(enabled?: boolean): void;
+
+  /**
+   * Null unless metrics are enabled
+   */
+  getMetrics(): AsyncSRTMetricsSnapshot | null;
+
+  resetMetrics(): void;
+
   /**
    *
    * @param sender
@@ -40,12 +132,32 @@ export class AsyncSRT extends EventEmitter {
   connect(socket: number, host: string, port: number, callback?: AsyncSRTCallback<SRTResult>): Promise<SRTResult>
 
   /**
+   * Starts connecting without waiting for the handshake (the socket becomes non-blocking for receiving).
+   * The socket reports EPOLL_OUT once connected, EPOLL_ERR if it failed.
+   */
+  startConnect(socket: number, host: string, port: number, callback?: AsyncSRTCallback<SRTResult>): Promise<SRTResult>
+
+  /**
+   * The listener stays open.
    *
    * @param socket
    * @returns File descriptor of incoming connection pipe
    */
   accept(socket: number, callback?: AsyncSRTCallback<SRTFileDescriptor>): Promise<SRTFileDescriptor>
 
+  /**
+   * Accepts up to `maxSockets` pending connections, setting `options` on each,
+   * or on the listener for the ones SRT only takes before connecting (see `SRT#acceptMany`)
+   */
+  acceptMany(socket: number, maxSockets: number, options?: SRTSockOptValues, callback?: AsyncSRTCallback<SRTAcceptedSocket[] | SRTResult.SRT_ERROR>): Promise<SRTAcceptedSocket[] | SRTResult.SRT_ERROR>
+
+  /**
+   * Rejects callers natively during the handshake by stream id, set before `listen`
+   */
+  setStreamIdFilter(socket: number, allow?: string[], deny?: string[], callback?: AsyncSRTCallback<SRTResult>): Promise<SRTResult>
+
+  getStreamIdFilterStats(socket: number, callback?: AsyncSRTCallback<SRTStreamIdFilterStats | null>): Promise<SRTStreamIdFilterStats | null>
+
   /**
    *
    * @param socket
@@ -58,6 +170,24 @@ export class AsyncSRT extends EventEmitter {
    * @param chunkSize
    */
   read(socket: number, chunkSize: number, callback?: AsyncSRTCallback<SRTReadReturn>): Promise<SRTReadReturn>
+  read(socket: number, chunkSize: number, msgctrl: Float64Array, callback?: AsyncSRTCallback<SRTReadReturn>): Promise<SRTReadReturn>
+
+  /**
+   *
+   * @param socket
+   * @param maxMessages
+   * @param maxBytes
+   */
+  readBatch(socket: number, maxMessages: number, maxBytes: number, callback?: AsyncSRTCallback<SRTReadBatch | SRTResult.SRT_ERROR>): Promise<SRTReadBatch | SRTResult.SRT_ERROR>
+
+  /**
+   *
+   * @param socket
+   * @param buffer
+   * @param offset default: 0
+   * @returns bytes received
+   */
+  readInto(socket: number, buffer: Buffer | Uint8Array, offset?: number, msgctrl?: Float64Array, callback?: AsyncSRTCallback<number | SRTResult.SRT_ERROR>): Promise<number | SRTResult.SRT_ERROR>
 
   /**
    *
@@ -65,6 +195,43 @@ export class AsyncSRT extends EventEmitter {
    * @param chunk
    */
   write(socket: number, chunk: Buffer, callback?: AsyncSRTCallback<SRTResult>): Promise<number | SRTResult.SRT_ERROR>
+  write(socket: number, chunk: Buffer, msgctrl: Float64Array, callback?: AsyncSRTCallback<SRTResult>): Promise<number | SRTResult.SRT_ERROR>
+
+  /**
+   *
+   * @param socket
+   * @param buffer
+   * @param payloadSize default: 1316
+   * @returns bytes sent, less than the buffer size if the send buffer filled up
+   */
+  writeMany(socket: number, buffer: Buffer | Uint8Array | Array<Buffer | Uint8Array>, payloadSize?: number, callback?: AsyncSRTCallback<number | SRTResult.SRT_ERROR>): Promise<number | SRTResult.SRT_ERROR>
+
+  /**
+   * Sends an MPEG-TS stream, passed in chunks of any size, as messages of 7 whole TS packets.
+   * With `pace` each message is sent when due according to the PCR,
+   * from a thread of the socket's own so other sockets are not held up
+   * (other calls on the socket, and `close`, then run in order on it too).
+   * Pass `end` with the last chunk. Native transport only.
+   *
+   * @returns Bytes sent
+   */
+  writeTs(socket: number, buffer: Buffer | Uint8Array, pace?: boolean, end?: boolean, callback?: AsyncSRTCallback<number | SRTResult.SRT_ERROR>): Promise<number | SRTResult.SRT_ERROR>
+
+  /**
+   * Sends `size` bytes of the file at `path` from `offset` with srt_sendfile
+   * (socket using SRTT_FILE).
+   *
+   * @returns Bytes sent
+   */
+  sendFile(socket: number, path: string, offset: number, size: number, blockSize?: number, callback?: AsyncSRTCallback<number | SRTResult.SRT_ERROR>): Promise<number | SRTResult.SRT_ERROR>
+
+  /**
+   * Receives `size` bytes into the file at `path` from `offset`, without truncating it.
+   * Fails if the file can't be opened, seeked or written before any data went through.
+   *
+   * @returns Bytes received, less than `size` if the connection broke
+   */
+  recvFile(socket: number, path: string, offset: number, size: number, blockSize?: number, callback?: AsyncSRTCallback<number | SRTResult.SRT_ERROR>): Promise<number | SRTResult.SRT_ERROR>
 
   /**
    *
@@ -87,6 +254,25 @@ export class AsyncSRT extends EventEmitter {
    */
   getSockState(socket: number, callback?: AsyncSRTCallback<SRTSockStatus>): Promise<SRTSockStatus>
 
+  /**
+   * @returns group id
+   */
+  createGroup(type: SRTGroupType, callback?: AsyncSRTCallback<number | SRTResult.SRT_ERROR>): Promise<number | SRTResult.SRT_ERROR>
+
+  /**
+   * Resolves once the first member connected
+   *
+   * @returns socket of the first connected member
+   */
+  connectGroup(group: number, endpoints: SRTGroupEndpoint[], callback?: AsyncSRTCallback<number | SRTResult.SRT_ERROR>): Promise<number | SRTResult.SRT_ERROR>
+
+  groupData(group: number, callback?: AsyncSRTCallback<SRTGroupMember[] | SRTResult.SRT_ERROR>): Promise<SRTGroupMember[] | SRTResult.SRT_ERROR>
+
+  /**
+   * Stats of the group and of each member
+   */
+  groupStats(group: number, clear?: boolean): Promise<{ group: SRTStats, members: Array<SRTGroupMember & { stats: SRTStats }> } | SRTResult.SRT_ERROR>
+
   /**
    * @returns epid
    */
@@ -107,6 +293,28 @@ export class AsyncSRT extends EventEmitter {
    */
   epollUWait(epid: number, msTimeOut: number, callback?: AsyncSRTCallback<SRTEpollEvent[]>): Promise<SRTEpollEvent[]>
 
+  /**
+   * The array must not be read until the returned Promise has settled.
+   *
+   * @param epid
+   * @param msTimeOut
+   * @param events Room for `events.length / 2` sockets
+   */
+  epollUWaitInto(epid: number, msTimeOut: number, events: Int32Array, callback?: AsyncSRTCallback<number>): Promise<number>
+
+  epollUpdateUsock(epid: number, socket: number, events: number, callback?: AsyncSRTCallback<SRTResult>): Promise<SRTResult>
+
+  epollRemoveUsock(epid: number, socket: number, callback?: AsyncSRTCallback<SRTResult>): Promise<SRTResult>
+
+  epollClearUsocks(epid: number, callback?: AsyncSRTCallback<SRTResult>): Promise<SRTResult>
+
+  /**
+   * @param flags `EPOLL_ENABLE_*` bits, -1 to only read them
+   */
+  epollSet(epid: number, flags: number, callback?: AsyncSRTCallback<number>): Promise<number>
+
+  epollRelease(epid: number, callback?: AsyncSRTCallback<SRTResult>): Promise<SRTResult>
+
   /**
    *
    * @param logLevel
@@ -120,4 +328,49 @@ export class AsyncSRT extends EventEmitter {
    */
    stats(socket: number, clear: boolean, callback?: AsyncSRTCallback<SRTStats>): Promise<SRTStats>
 
+  /**
+   *
+   * @param sockets
+   * @param rows see `createStatsRows`
+   * @param clear
+   * @returns number of sockets sampled
+   */
+  statsInto(sockets: number[], rows: Float64Array, clear?: boolean, callback?: AsyncSRTCallback<number>): Promise<number>
+
+}
+
+export interface SRTFileTransferProgress {
+  /**
+   * Offset in the file after the last range
+   */
+  offset: number;
+  /**
+   * Bytes moved by this call of send/receive
+   */
+  bytes: number;
+  size: number;
+}
+
+/**
+ * Rejections carry the `offset` to resume from.
+ */
+export class SRTFileTransfer extends EventEmitter {
+  constructor(asyncSrt: AsyncSRT, socket: number, rangeSize?: number, blockSize?: number);
+
+  readonly asyncSrt: AsyncSRT;
+  readonly socket: number;
+  rangeSize: number;
+  blockSize: number;
+
+  /**
+   * @returns Offset after the last byte sent
+   */
+  send(path: string, offset?: number, size?: number): Promise<number>;
+
+  /**
+   * @returns Offset after the last byte received
+   */
+  receive(path: string, offset: number, size: number): Promise<number>;
+
+  on(event: 'progress', listener: (progress: SRTFileTransferProgress) => void): this;
 }
@@ -1,4 +1,4 @@
-import { SRTLoggingLevel, SRTResult, SRTSockOpt, SRTSockStatus } from "../src/srt-api-enums";
+import { SRTGroupMemberStatus, SRTGroupType, SRTLoggingLevel, SRTResult, SRTSockOpt, SRTSockStatus } from "../src/srt-api-enums";
 
 export interface SRTEpollEvent {
   socket: SRTFileDescriptor
@@ -7,10 +7,73 @@ export interface SRTEpollEvent {
 
 export type SRTReadReturn = Uint8Array | null | SRTResult.SRT_ERROR;
 
+export interface SRTReadBatch {
+  /**
+   * All messages received, back to back
+   */
+  buffer: Buffer
+  /**
+   * Start of every message plus the end of the last one (`count + 1` entries)
+   */
+  offsets: Uint32Array
+}
+
 export type SRTFileDescriptor = number;
 
+export interface SRTBufferPoolStats {
+  blockSize: number
+  maxBlocks: number
+  allocatedBlocks: number
+  freeBlocks: number
+  /**
+   * reads served from the pool
+   */
+  hits: number
+  /**
+   * reads that had to allocate, as they were larger than a block or the pool was exhausted
+   */
+  misses: number
+}
+
 export type SRTSockOptValue = boolean | number | string
 
+export type SRTSockOptValues = { [option: number]: SRTSockOptValue }
+
+export interface SRTAcceptedSocket {
+  socket: SRTFileDescriptor
+  host: string
+  port: number
+}
+
+export interface SRTStreamIdFilterStats {
+  accepted: number
+  rejected: number
+}
+
+export interface SRTGroupEndpoint {
+  host: string
+  port: number
+  /**
+   * Priority of the link in a backup group (higher goes first)
+   */
+  weight?: number
+  token?: number
+}
+
+export interface SRTGroupMember {
+  socket: SRTFileDescriptor
+  host: string
+  port: number
+  state: SRTSockStatus
+  status: SRTGroupMemberStatus
+  weight: number
+  /**
+   * Result of the last operation on the member, SRT_ERROR if it failed
+   */
+  result: number
+  token: number
+}
+
 export interface SRTStats {
   // global measurements
   msTimeStamp: number
@@ -23,6 +86,7 @@ export interface SRTStats {
   pktRecvACKTotal: number
   pktSentNAKTotal: number
   pktRecvNAKTotal: number
+  usSndDurationTotal: number
   pktSndDropTotal: number
   pktRcvDropTotal: number
   pktRcvUndecryptTotal: number
@@ -110,8 +174,42 @@ export class SRT {
   static ERROR: SRTResult.SRT_ERROR;
   static INVALID_SOCK: SRTResult.SRT_ERROR;
 
+  // msgctrl array layout
+  static MSGCTRL_FLAGS: number;
+  static MSGCTRL_TTL: number;
+  static MSGCTRL_INORDER: number;
+  static MSGCTRL_BOUNDARY: number;
+  static MSGCTRL_SRCTIME: number;
+  static MSGCTRL_PKTSEQ: number;
+  static MSGCTRL_NO: number;
+  static MSGCTRL_LENGTH: number;
+
+  // statsInto row layout
+  static STATS_FIELDS: ReadonlyArray<keyof SRTStats>;
+  static STATS_FIELD_COUNT: number;
+
+  // epoll events and flags
+  static EPOLL_IN: number;
+  static EPOLL_OUT: number;
+  static EPOLL_ERR: number;
+  static EPOLL_ET: number;
+  static EPOLL_UPDATE: number;
+  static EPOLL_ENABLE_EMPTY: number;
+  static EPOLL_ENABLE_OUTPUTCHECK: number;
+
+  // SRTO_TRANSTYPE values
+  static SRTT_LIVE: number;
+  static SRTT_FILE: number;
+
+  // socket groups
+  static SRT_GTYPE_BROADCAST: SRTGroupType.SRT_GTYPE_BROADCAST;
+  static SRT_GTYPE_BACKUP: SRTGroupType.SRT_GTYPE_BACKUP;
+  static SRT_GST_PENDING: SRTGroupMemberStatus.SRT_GST_PENDING;
+  static SRT_GST_IDLE: SRTGroupMemberStatus.SRT_GST_IDLE;
+  static SRT_GST_RUNNING: SRTGroupMemberStatus.SRT_GST_RUNNING;
+  static SRT_GST_BROKEN: SRTGroupMemberStatus.SRT_GST_BROKEN;
+
   // TODO: add SOCKET_OPTIONS, SOCKET_STATUS enums
-  //        and EPOLL_OPTS
 
   /**
    *
@@ -138,18 +236,62 @@ export class SRT {
   /**
    *
    * @param socket
-   * @param host
+   * @param host IPv4 or IPv6 address
    * @param port
    */
   connect(socket: number, host: string, port: number): SRTResult
 
   /**
+   * Starts connecting and returns right away, making the socket non-blocking for receiving.
+   * The socket reports EPOLL_OUT once connected, EPOLL_ERR if it failed.
+   *
+   * @param socket
+   * @param host IPv4 or IPv6 address
+   * @param port
+   */
+  startConnect(socket: number, host: string, port: number): SRTResult
+
+  /**
+   * The listener stays open.
    *
    * @param socket
    * @returns File descriptor of incoming connection pipe
    */
   accept(socket: number): SRTFileDescriptor
 
+  /**
+   * Accepts up to `maxSockets` pending connections.
+   * Only the first accept may wait on a blocking listener.
+   *
+   * Options SRT only takes before connecting (latency, passphrase, payload size, ...) are set
+   * on the listener, which hands them to the connections it takes from then on.
+   * Pass `maxSockets` 0 to only do that, before binding the listener.
+   * The others (blocking mode, timeouts, bandwidth, ...) are set on each accepted socket.
+   * Throws if an option can't be set, rather than dropping the connection.
+   *
+   * @param socket listener
+   * @param maxSockets
+   * @param options `{ [option]: value }`
+   */
+  acceptMany(socket: number, maxSockets: number, options?: SRTSockOptValues): SRTAcceptedSocket[] | SRTResult.SRT_ERROR
+
+  /**
+   * Rejects callers natively during the handshake by stream id:
+   * those matching `deny`, or none of `allow` when it isn't empty.
+   * Entries ending with '*' match by prefix.
+   *
+   * @param socket listener
+   * @param allow
+   * @param deny
+   */
+  setStreamIdFilter(socket: number, allow?: string[], deny?: string[]): SRTResult
+
+  /**
+   * @param socket listener
+   * @returns null if the listener has no stream id filter
+   */
+  getStreamIdFilterStats(socket: number): SRTStreamIdFilterStats | null
+
   /**
    *
    * @param socket
@@ -161,14 +303,71 @@ export class SRT {
    * @param socket
    * @param chunkSize
    */
-  read(socket: number, chunkSize: number): SRTReadReturn
+  read(socket: number, chunkSize: number, msgctrl?: Float64Array): SRTReadReturn
+
+  /**
+   * Receives pending messages until the socket would block
+   * or `maxMessages`/`maxBytes` are reached
+   *
+   * @param socket
+   * @param maxMessages
+   * @param maxBytes
+   */
+  readBatch(socket: number, maxMessages: number, maxBytes: number): SRTReadBatch
+
+  /**
+   * Receives one message into `buffer` at `offset` (default 0).
+   * Returns the bytes received, or SRT_ERROR if no data is pending on a non-blocking socket.
+   *
+   * @param socket
+   * @param buffer
+   * @param offset
+   */
+  readInto(socket: number, buffer: Buffer | Uint8Array, offset?: number, msgctrl?: Float64Array): number | SRTResult.SRT_ERROR
 
   /**
    *
    * @param socket
    * @param chunk
    */
-  write(socket: number, chunk: Buffer): SRTResult
+  write(socket: number, chunk: Buffer, msgctrl?: Float64Array): SRTResult
+
+  /**
+   * Sends the buffer as messages of `payloadSize` bytes (default 1316).
+   * Returns the bytes sent, less than the buffer size if the send buffer
+   * of a non-blocking socket filled up.
+   * An array of buffers is repacked into messages as if it was one buffer.
+   *
+   * @param socket
+   * @param buffer
+   * @param payloadSize
+   */
+  writeMany(socket: number, buffer: Buffer | Uint8Array | Array<Buffer | Uint8Array>, payloadSize?: number): number
+
+  /**
+   * Sends `size` bytes of the file at `path` from `offset` with srt_sendfile.
+   * Returns the bytes sent.
+   *
+   * @param socket
+   * @param path
+   * @param offset
+   * @param size
+   * @param blockSize default: 1 MiB
+   */
+  sendFile(socket: number, path: string, offset: number, size: number, blockSize?: number): number | SRTResult.SRT_ERROR
+
+  /**
+   * Receives `size` bytes into the file at `path` from `offset`, keeping the rest of the file.
+   * Returns the bytes received, less than `size` if the connection broke.
+   * Throws if the file can't be opened, seeked or written before any data went through.
+   *
+   * @param socket
+   * @param path
+   * @param offset
+   * @param size
+   * @param blockSize default: 1 MiB
+   */
+  recvFile(socket: number, path: string, offset: number, size: number, blockSize?: number): number | SRTResult.SRT_ERROR
 
   /**
    *
@@ -191,6 +390,29 @@ export class SRT {
    */
   getSockState(socket: number): SRTSockStatus
 
+  /**
+   * Creates a socket group, used like a socket once connected
+   *
+   * @param type
+   * @returns group id
+   */
+  createGroup(type: SRTGroupType): number | SRTResult.SRT_ERROR
+
+  /**
+   * Connects one member socket of the group to every endpoint
+   *
+   * @param group
+   * @param endpoints
+   * @returns socket of the first connected member
+   */
+  connectGroup(group: number, endpoints: SRTGroupEndpoint[]): number | SRTResult.SRT_ERROR
+
+  /**
+   *
+   * @param group
+   */
+  groupData(group: number): SRTGroupMember[] | SRTResult.SRT_ERROR
+
   /**
    * @returns epid
    */
@@ -211,6 +433,69 @@ export class SRT {
    */
   epollUWait(epid: number, msTimeOut: number): SRTEpollEvent[]
 
+  /**
+   * Waits like `epollUWait` but writes (socket, events) pairs into `events`.
+   *
+   * @param epid
+   * @param msTimeOut
+   * @param events Room for `events.length / 2` sockets
+   * @returns Number of ready sockets written
+   */
+  epollUWaitInto(epid: number, msTimeOut: number, events: Int32Array): number
+
+  /**
+   *
+   * @param epid
+   * @param socket
+   * @param events
+   */
+  epollUpdateUsock(epid: number, socket: number, events: number): SRTResult
+
+  /**
+   *
+   * @param epid
+   * @param socket
+   */
+  epollRemoveUsock(epid: number, socket: number): SRTResult
+
+  /**
+   *
+   * @param epid
+   */
+  epollClearUsocks(epid: number): SRTResult
+
+  /**
+   *
+   * @param epid
+   * @param flags `EPOLL_ENABLE_*` bits, -1 to only read them
+   * @returns Flags now set
+   */
+  epollSet(epid: number, flags: number): number
+
+  /**
+   * Also stops a pump started with `epollWatch`.
+   *
+   * @param epid
+   */
+  epollRelease(epid: number): SRTResult
+
+  /**
+   * Waits on the epoll from a native thread and passes each batch of
+   * ready sockets to `onEvents`. The next batch is only waited for
+   * once `onEvents` returned, or the promise it returned has settled.
+   *
+   * @param epid
+   * @param onEvents Gets `null` and an error message if waiting failed
+   */
+  epollWatch(epid: number,
+    onEvents: (events: SRTEpollEvent[] | null, error?: string) => void | Promise<unknown>): SRTResult
+
+  /**
+   *
+   * @param epid
+   */
+  epollUnwatch(epid: number): SRTResult
+
   /**
    *
    * @param logLevel Or 0 - 7 integer (not all values present in enum)
@@ -224,5 +509,293 @@ export class SRT {
    * @returns Current SRT statistics
    */
    stats(socket: number, clear: boolean): SRTStats;
+
+  /**
+   * Writes the stats of every socket into one row of `SRT.STATS_FIELD_COUNT` values,
+   * in the order of `SRT.STATS_FIELDS`. Rows of sockets without stats are filled with NaN.
+   *
+   * @param sockets
+   * @param rows see `createStatsRows`
+   * @param clear
+   * @returns number of sockets sampled
+   */
+  statsInto(sockets: number[], rows: Float64Array, clear?: boolean): number;
+
+  /**
+   * Limits the number of blocks of the process-wide receive buffer pool
+   * `read` takes its Buffers from (default 4096).
+   *
+   * @param maxBlocks
+   */
+  setBufferPoolSize(maxBlocks: number): SRTResult
+
+  getBufferPoolStats(): SRTBufferPoolStats
+}
+
+export interface SRTStatsSummary {
+  /**
+   * number of samples summarized
+   */
+  count: number
+  min: number
+  max: number
+  mean: number
+  p50: number
+  p95: number
+  p99: number
+  /**
+   * most recent sample
+   */
+  last: number
+}
+
+/**
+ * Samples the stats of registered sockets on a native thread
+ * and keeps a sliding window of samples per socket and metric.
+ */
+/**
+ * Connects many sockets concurrently, waiting for their handshakes on one epoll
+ */
+export class SRTConnector {
+  constructor();
+
+  /**
+   * Connects in progress
+   */
+  readonly pending: number;
+
+  /**
+   * Connected sockets are made blocking for receiving again, unless `options` sets SRTO_RCVSYN
+   *
+   * @returns the connected socket
+   */
+  connect(host: string, port: number, options?: SRTSockOptValues, sender?: boolean): Promise<number>;
+
+  dispose(): void;
 }
 
+export class SRTStatsSampler {
+  /** msRTT */
+  static METRIC_RTT: number;
+  /** Mbps sent during the interval */
+  static METRIC_SEND_RATE: number;
+  /** Mbps received during the interval */
+  static METRIC_RECV_RATE: number;
+  /** packets lost during the interval */
+  static METRIC_RCV_LOSS: number;
+  /** packets retransmitted during the interval */
+  static METRIC_RETRANS: number;
+  /** msRcvBuf */
+  static METRIC_RCV_BUF: number;
+
+  /**
+   * @param intervalMs default: 100
+   * @param windowSize samples kept per socket and metric. default: 600
+   */
+  constructor(intervalMs?: number, windowSize?: number);
+
+  add(socket: number): SRTResult
+
+  remove(socket: number): SRTResult
+
+  /**
+   * @param socket
+   * @param metric one of `SRTStatsSampler.METRIC_*`
+   * @param samples summarize only the most recent samples (default: whole window)
+   * @returns null if the socket has no samples (yet)
+   */
+  query(socket: number, metric: number, samples?: number): SRTStatsSummary | null
+
+  /**
+   * Stops the sampling thread
+   */
+  stop(): SRTResult
+}
+
+export interface SRTRelayCounters {
+  packets: number
+  bytes: number
+  /**
+   * messages a destination didn't take, summed over destinations for a route
+   */
+  drops: number
+}
+
+export interface SRTRelayRouteStats extends SRTRelayCounters {
+  /**
+   * the source failed, nothing is forwarded anymore
+   */
+  broken: boolean
+  destinations: Array<SRTRelayCounters & { socket: number }>
+}
+
+/**
+ * Forwards every message received on a source socket to its destination sockets
+ * on a native thread, without passing the payloads through JS.
+ */
+export class SRTRelay {
+  constructor();
+
+  /**
+   * Starts forwarding from `source`, or adds destinations to its route.
+   * Destinations are made non-blocking (`SRTO_SNDSYN` false).
+   * Throws if the route can't be made, with no socket flag changed.
+   */
+  addRoute(source: number, destinations: number[]): SRTResult
+
+  removeRoute(source: number): SRTResult
+
+  removeDestination(source: number, destination: number): SRTResult
+
+  /**
+   * @returns null if there is no route from `source`
+   */
+  getRouteStats(source: number): SRTRelayRouteStats | null
+
+  /**
+   * Stops the relay thread
+   */
+  stop(): SRTResult
+}
+
+export interface SRTFanOutSubscriberStats {
+  socket: number
+  packets: number
+  bytes: number
+  /**
+   * messages skipped by the policy of the subscriber
+   */
+  drops: number
+  /**
+   * messages received but not sent to the subscriber yet
+   */
+  lag: number
+  /**
+   * waiting for room in its send buffer
+   */
+  blocked: boolean
+  /**
+   * closed by POLICY_DISCONNECT, or found broken
+   */
+  disconnected: boolean
+}
+
+export interface SRTFanOutStats {
+  packets: number
+  bytes: number
+  /**
+   * source messages longer than SRT_LIVE_MAX_PLSIZE, which don't fit the ring
+   */
+  drops: number
+  /**
+   * the source failed, nothing is received anymore
+   */
+  broken: boolean
+  subscribers: SRTFanOutSubscriberStats[]
+}
+
+/**
+ * Receives each message of a source socket once into a shared ring
+ * and sends it from there to every subscriber socket, on a native thread.
+ */
+export class SRTFanOut {
+  /** go on with the oldest message still in the ring */
+  static POLICY_DROP_OLDEST: number;
+  /** close the subscriber socket */
+  static POLICY_DISCONNECT: number;
+  /** go on with the newest MPEG-TS random access point in the ring */
+  static POLICY_SKIP_TO_KEYFRAME: number;
+
+  /**
+   * @param source
+   * @param capacity messages the ring holds, i.e how far a subscriber may fall behind. default: 2048
+   * @param policy for subscribers falling behind further. default: POLICY_DROP_OLDEST
+   */
+  constructor(source: number, capacity?: number, policy?: number);
+
+  /**
+   * Makes `socket` non-blocking and starts sending to it.
+   *
+   * @param policy default: the one of the fan-out
+   */
+  addSubscriber(socket: number, policy?: number): SRTResult
+
+  removeSubscriber(socket: number): SRTResult
+
+  getStats(): SRTFanOutStats
+
+  /**
+   * Stops the fan-out thread
+   */
+  stop(): SRTResult
+}
+
+export interface SRTSendSchedulerMetrics {
+  queuedBytes: number
+  queuedMessages: number
+  sentBytes: number
+  sentMessages: number
+  /**
+   * messages sent later than the late threshold after their bucket allowed them
+   */
+  lateSends: number
+  maxLateUs: number
+  meanLateUs: number
+  /**
+   * a send failed and the queue was dropped
+   */
+  broken: boolean
+}
+
+/**
+ * Paces queued messages out to their sockets from a native thread,
+ * with a token bucket per socket.
+ */
+export class SRTSendScheduler {
+  /**
+   * @param lateThresholdUs sends later than this count as late. default: 1000
+   */
+  constructor(lateThresholdUs?: number);
+
+  /**
+   * Sets (or changes) the bucket of a socket and makes it non-blocking.
+   *
+   * @param bitrate bits per second
+   * @param burstBytes bucket size. default: 13160
+   * @param maxQueueBytes default: 8 MiB
+   */
+  configure(socket: number, bitrate: number, burstBytes?: number, maxQueueBytes?: number): SRTResult
+
+  /**
+   * Queues a copy of `buffer`, sent as messages of `payloadSize` bytes.
+   *
+   * @param payloadSize default: 1316
+   * @returns bytes queued, 0 if the queue is full
+   */
+  enqueue(socket: number, buffer: Buffer | Uint8Array, payloadSize?: number): number
+
+  /**
+   * Drops the queue and bucket of a socket
+   */
+  remove(socket: number): SRTResult
+
+  /**
+   * @returns null if the socket isn't configured
+   */
+  getMetrics(socket: number): SRTSendSchedulerMetrics | null
+
+  /**
+   * Resolves once the queue of the socket holds at most `queuedBytes`
+   * (it may have grown again by the time the promise settles),
+   * right away if it already does. Also resolves if the queue broke,
+   * the socket is removed or the scheduler stopped.
+   *
+   * @param queuedBytes default: 0, i.e all sent
+   */
+  whenQueueBelow(socket: number, queuedBytes?: number): Promise<void>
+
+  /**
+   * Stops the scheduler thread
+   */
+  stop(): SRTResult
+}
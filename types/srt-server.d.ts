@@ -2,8 +2,9 @@
 
 import {EventEmitter} from 'events';
 import { SRTResult, SRTSockOpt } from '../src/srt-api-enums';
-import { SRTSockOptValue } from './srt-api';
+import { SRTFanOut, SRTSockOptValue, SRTSockOptValues, SRTStreamIdFilterStats } from './srt-api';
 import { AsyncSRT } from './srt-api-async';
+import { AsyncSRTTransport } from '../src/async-api-enums';
 
 export class AsyncReaderWriter {
   constructor(asyncSrt: AsyncSRT, socketFd: number);
@@ -11,6 +12,10 @@ export class AsyncReaderWriter {
   writeChunks(buffer: Uint8Array | Buffer, mtuSize: number,
     writesPerTick: number): Promise<void>;
 
+  writeTsChunks(buffer: Uint8Array | Buffer, pace?: boolean,
+    bytesPerCall?: number,
+    onWrite?: (bytesSent: number) => void): Promise<void>;
+
   readChunks(minBytesRead: number,
     readBufSize: number,
     onRead: (buf: Uint8Array) => void,
@@ -20,11 +25,24 @@ export class AsyncReaderWriter {
 export class SRTConnection extends EventEmitter {
   readonly fd: number;
   readonly gotFirstData: boolean;
+  /**
+   * Address of the caller, null if unknown
+   */
+  readonly peer: { host: string, port: number } | null;
 
   read(): Promise<Uint8Array | SRTResult.SRT_ERROR | null>;
   write(chunk: Buffer | Uint8Array): Promise<SRTResult>;
   close(): Promise<SRTResult | null>;
 
+  /**
+   * Sends every message `fanOut` receives to this connection until
+   * `unsubscribe` is called or the connection is closed.
+   *
+   * @param policy one of `SRTFanOut.POLICY_*`, default: the one of `fanOut`
+   */
+  subscribe(fanOut: SRTFanOut, policy?: number): void;
+  unsubscribe(): void;
+
   isClosed(): boolean;
 
   onData(): void;
@@ -32,18 +50,48 @@ export class SRTConnection extends EventEmitter {
   getReaderWriter(): AsyncReaderWriter;
 }
 
+export interface SRTServerOptions {
+  /**
+   * Number of shards to spread accepted connections over, default: 1.
+   * Each shard has its own AsyncSRT and epoll set.
+   */
+  shards?: number;
+  transport?: AsyncSRTTransport;
+  threadsPerShard?: number;
+  /**
+   * Socket options set natively on every accepted socket
+   */
+  acceptOptions?: SRTSockOptValues;
+}
+
+export interface SRTServerShardMetrics {
+  index: number;
+  /**
+   * Connections currently open on the shard
+   */
+  connections: number;
+  accepted: number;
+  events: number;
+  eventBatches: number;
+  /**
+   * Time spent handling event batches
+   */
+  busyMs: number;
+}
+
 export class SRTServer extends EventEmitter /*<SRTServerEvent>*/ {
 
   static create(port: number, address?: string,
-    epollPeriodMs?: number): Promise<SRTServer>;
+    epollPeriodMs?: number, options?: SRTServerOptions): Promise<SRTServer>;
 
   port: number;
   address: string;
   epollPeriodMs: number;
   socket: number;
   epid: number;
+  readonly shards: number;
 
-  constructor(port: number, address?: string, epollPeriodMs?: number);
+  constructor(port: number, address?: string, epollPeriodMs?: number, options?: SRTServerOptions);
 
   create(): Promise<SRTServer>;
   open(): Promise<SRTServer>;
@@ -51,8 +99,15 @@ export class SRTServer extends EventEmitter /*<SRTServerEvent>*/ {
 
   setSocketFlags(opts: SRTSockOpt[], values: SRTSockOptValue[]): Promise<SRTResult[]>;
 
+  /**
+   * Call after `create`, before `open`
+   */
+  setStreamIdFilter(allow?: string[], deny?: string[]): Promise<SRTResult>;
+  getStreamIdFilterStats(): Promise<SRTStreamIdFilterStats | null>;
+
   getConnectionByHandle(fd: number);
   getAllConnections(): SRTConnection[];
+  getShardMetrics(): SRTServerShardMetrics[];
 }
 
 
@@ -1,6 +1,6 @@
 /// <reference types="node" />
 
-import { Writable, Readable } from "stream";
+import { Writable, Readable, ReadableOptions, WritableOptions } from "stream";
 import { SRT, SRTFileDescriptor } from "./srt-api";
 
 interface SRTConnectionState {
@@ -27,14 +27,20 @@ export class SRTReadStream extends Readable implements SRTCallerState, SRTListen
   readonly socket: number;
   readonly address: string;
   readonly port: number;
-  readonly readTimer: number | null;
 
-  constructor(address: string, port: number, opts?: unknown);
+  constructor(address: string, port: number, opts?: ReadableOptions);
 
   connect(callback: (state: SRTCallerState) => void);
   close();
 
+  /**
+   * The first connection sending data is read by this stream,
+   * later ones are emitted as `'connection'` events.
+   */
   listen(callback: (state: SRTListenerState) => void);
+
+  on(event: 'connection', listener: (stream: SRTReadStream) => void): this;
+  on(event: string | symbol, listener: (...args: any[]) => void): this;
 }
 
 export class SRTWriteStream extends Writable implements SRTCallerState {
@@ -44,8 +50,12 @@ export class SRTWriteStream extends Writable implements SRTCallerState {
   readonly address: string;
   readonly port: number;
   readonly fd: SRTFileDescriptor | null;
+  readonly payloadSize: number;
 
-  constructor(address: string, port: number, opts?: unknown);
+  /**
+   * @param opts `payloadSize`: size of the messages written chunks are repacked into, default: 1316
+   */
+  constructor(address: string, port: number, opts?: WritableOptions & { payloadSize?: number });
 
   connect(callback: (state: SRTCallerState) => void);
   close();